@@ -10,14 +10,17 @@
 #define COLLISION_H
 
 #include "Entities/Entity.hpp"
+#include "../Geometry/Vector2.hpp"
 #include <vector>
+#include <cstddef>
 
 namespace GolfEngine
 {
     class Collision
     {
     public:
-        Collision(GolfEngine::Entity *attached, GolfEngine::Entity *collider) : attached(attached), collider(collider){};
+        Collision(GolfEngine::Entity *attached, GolfEngine::Entity *collider) : attached(attached), collider(collider), normal(GolfEngine::Vector2::zero), depth(0){};
+        Collision(GolfEngine::Entity *attached, GolfEngine::Entity *collider, const GolfEngine::Vector2 &normal, double depth) : attached(attached), collider(collider), normal(normal), depth(depth){};
 
         /**
          * @brief Get the attached entity.
@@ -39,11 +42,72 @@ namespace GolfEngine
             return this->collider;
         }
 
+        /**
+         * @brief Get the contact normal.
+         *
+         * @returns Unit normal pointing from the attached entity towards the colliding entity.
+         */
+        inline GolfEngine::Vector2 getNormal() const
+        {
+            return this->normal;
+        }
+
+        /**
+         * @brief Get how far the entities overlap.
+         *
+         * @returns How far the colliding entity would have to move along the normal to stop overlapping.
+         */
+        inline double getDepth() const
+        {
+            return this->depth;
+        }
+
         typedef std::vector<Collision> CollisionList;
 
     private:
         GolfEngine::Entity *attached;
         GolfEngine::Entity *collider;
+        GolfEngine::Vector2 normal;
+        double depth;
+    };
+
+    /**
+     * @brief A view over a contiguous run of collisions. It does not own them.
+     */
+    class CollisionSpan
+    {
+    public:
+        CollisionSpan() : collisions(nullptr), count(0){};
+        CollisionSpan(GolfEngine::Collision *collisions, std::size_t count) : collisions(collisions), count(count){};
+
+        inline GolfEngine::Collision *begin() const
+        {
+            return this->collisions;
+        }
+
+        inline GolfEngine::Collision *end() const
+        {
+            return this->collisions + this->count;
+        }
+
+        inline std::size_t size() const
+        {
+            return this->count;
+        }
+
+        inline bool empty() const
+        {
+            return this->count == 0;
+        }
+
+        inline GolfEngine::Collision &operator[](std::size_t i) const
+        {
+            return this->collisions[i];
+        }
+
+    private:
+        GolfEngine::Collision *collisions;
+        std::size_t count;
     };
 }
 
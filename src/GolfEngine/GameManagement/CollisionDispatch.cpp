@@ -0,0 +1,37 @@
+/**
+ * @file CollisionDispatch.cpp
+ * @brief This file contains definitions for the CollisionDispatch class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#include "CollisionDispatch.hpp"
+
+using GolfEngine::CollisionDispatch;
+
+/**
+ * @brief Wrap a ContactTest specialization in a plain function, so it can go in the table.
+ */
+template <GolfEngine::ShapeKind A, GolfEngine::ShapeKind B>
+static bool dispatch(const GolfEngine::ContactBody &a, const GolfEngine::ContactBody &b, GolfEngine::SeparatingAxisCache &cache, GolfEngine::Contact &contact)
+{
+    return GolfEngine::ContactTest<A, B>::test(a, b, cache, contact);
+}
+
+/**
+ * @brief Build one row of the table, for bodies of kind A against every kind.
+ */
+#define DISPATCH_ROW(A)                                            \
+    {                                                              \
+        &dispatch<A, GolfEngine::ShapeKind::CIRCLE_SHAPE>,          \
+            &dispatch<A, GolfEngine::ShapeKind::POLYGON_SHAPE>      \
+    }
+
+static_assert(GolfEngine::ShapeKind::SHAPE_KIND_COUNT == 2, "Every shape kind needs a row and a column in the dispatch table.");
+
+const CollisionDispatch::ContactFunction CollisionDispatch::table[GolfEngine::ShapeKind::SHAPE_KIND_COUNT][GolfEngine::ShapeKind::SHAPE_KIND_COUNT] = {
+    DISPATCH_ROW(GolfEngine::ShapeKind::CIRCLE_SHAPE),
+    DISPATCH_ROW(GolfEngine::ShapeKind::POLYGON_SHAPE)};
+
+#undef DISPATCH_ROW
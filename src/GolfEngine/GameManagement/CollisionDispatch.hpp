@@ -0,0 +1,146 @@
+/**
+ * @file CollisionDispatch.hpp
+ * @brief This file contains declerations for the CollisionDispatch class and the ContactTest templates.
+ *
+ * Each pair of shape kinds has its own ContactTest specialization. CollisionDispatch builds a
+ * table of them at compile time, indexed by the kinds of the two bodies, so picking the right
+ * test for a pair is a single lookup, with no virtual calls or casts. Supporting a new shape
+ * kind means adding it to ShapeKind and writing the specializations for it.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#ifndef COLLISIONDISPATCH_H
+#define COLLISIONDISPATCH_H
+
+#include "../Geometry/Vector2.hpp"
+#include "../Physics/Narrowphase.hpp"
+#include <cstddef>
+
+namespace GolfEngine
+{
+    /**
+     * @brief The kinds of shape a body can collide as.
+     */
+    enum ShapeKind
+    {
+        CIRCLE_SHAPE,
+        POLYGON_SHAPE,
+        SHAPE_KIND_COUNT
+    };
+
+    /**
+     * @brief Everything the narrowphase needs to know about a body, gathered once per collision check.
+     */
+    struct ContactBody
+    {
+        GolfEngine::ShapeKind kind;
+        /**
+         * @brief Address identifying the body, e.g. for warm starting.
+         */
+        const void *owner;
+        GolfEngine::Vector2 position;
+        double radius;
+        /**
+         * @brief World vertices of polygon bodies. Unused by circles.
+         */
+        const GolfEngine::Vector2 *vertices;
+        std::size_t vertex_count;
+
+        ContactBody() : kind(GolfEngine::ShapeKind::CIRCLE_SHAPE), owner(nullptr), radius(0), vertices(nullptr), vertex_count(0){};
+    };
+
+    /**
+     * @brief Contact test between a body of kind A and a body of kind B. Specialized for every pair of kinds.
+     *
+     * Every specialization has a static test(a, b, cache, contact) returning true if the bodies touch,
+     * and filling in contact with the normal pointing from a towards b.
+     */
+    template <GolfEngine::ShapeKind A, GolfEngine::ShapeKind B>
+    struct ContactTest;
+
+    template <>
+    struct ContactTest<GolfEngine::ShapeKind::CIRCLE_SHAPE, GolfEngine::ShapeKind::CIRCLE_SHAPE>
+    {
+        static inline bool test(const GolfEngine::ContactBody &a, const GolfEngine::ContactBody &b, GolfEngine::SeparatingAxisCache &, GolfEngine::Contact &contact)
+        {
+            return GolfEngine::Narrowphase::circleCircle(a.position, a.radius, b.position, b.radius, contact);
+        }
+    };
+
+    template <>
+    struct ContactTest<GolfEngine::ShapeKind::POLYGON_SHAPE, GolfEngine::ShapeKind::CIRCLE_SHAPE>
+    {
+        static inline bool test(const GolfEngine::ContactBody &a, const GolfEngine::ContactBody &b, GolfEngine::SeparatingAxisCache &, GolfEngine::Contact &contact)
+        {
+            return GolfEngine::Narrowphase::polygonCircle(a.vertices, a.vertex_count, b.position, b.radius, contact);
+        }
+    };
+
+    template <>
+    struct ContactTest<GolfEngine::ShapeKind::CIRCLE_SHAPE, GolfEngine::ShapeKind::POLYGON_SHAPE>
+    {
+        static inline bool test(const GolfEngine::ContactBody &a, const GolfEngine::ContactBody &b, GolfEngine::SeparatingAxisCache &cache, GolfEngine::Contact &contact)
+        {
+            if (!ContactTest<GolfEngine::ShapeKind::POLYGON_SHAPE, GolfEngine::ShapeKind::CIRCLE_SHAPE>::test(b, a, cache, contact))
+            {
+                return false;
+            }
+            contact.normal = contact.normal * -1;
+            return true;
+        }
+    };
+
+    template <>
+    struct ContactTest<GolfEngine::ShapeKind::POLYGON_SHAPE, GolfEngine::ShapeKind::POLYGON_SHAPE>
+    {
+        static inline bool test(const GolfEngine::ContactBody &a, const GolfEngine::ContactBody &b, GolfEngine::SeparatingAxisCache &cache, GolfEngine::Contact &contact)
+        {
+            // Warm start data is kept by owner address, lowest first, so it is found again whichever order the pair comes in.
+            if (b.owner < a.owner)
+            {
+                if (!GolfEngine::Narrowphase::polygonPolygon(b.vertices, b.vertex_count, a.vertices, a.vertex_count, contact, cache.get(b.owner, a.owner)))
+                {
+                    return false;
+                }
+                contact.normal = contact.normal * -1;
+                return true;
+            }
+            return GolfEngine::Narrowphase::polygonPolygon(a.vertices, a.vertex_count, b.vertices, b.vertex_count, contact, cache.get(a.owner, b.owner));
+        }
+    };
+
+    class CollisionDispatch
+    {
+    public:
+        typedef bool (*ContactFunction)(const GolfEngine::ContactBody &a, const GolfEngine::ContactBody &b, GolfEngine::SeparatingAxisCache &cache, GolfEngine::Contact &contact);
+
+        /**
+         * @brief Find the contact between two bodies, with the test for their kinds.
+         *
+         * @param a First body.
+         * @param b Second body.
+         * @param cache Warm start data for polygon pairs.
+         * @param contact Filled in if they touch, with the normal pointing from a towards b.
+         * @returns True if the bodies touch, false otherwise.
+         */
+        static inline bool findContact(const GolfEngine::ContactBody &a, const GolfEngine::ContactBody &b, GolfEngine::SeparatingAxisCache &cache, GolfEngine::Contact &contact)
+        {
+            return CollisionDispatch::table[a.kind][b.kind](a, b, cache, contact);
+        }
+
+        /**
+         * @brief Get the test for a pair of kinds.
+         */
+        static inline ContactFunction getTest(GolfEngine::ShapeKind a, GolfEngine::ShapeKind b)
+        {
+            return CollisionDispatch::table[a][b];
+        }
+
+    private:
+        static const ContactFunction table[GolfEngine::ShapeKind::SHAPE_KIND_COUNT][GolfEngine::ShapeKind::SHAPE_KIND_COUNT];
+    };
+}
+
+#endif
@@ -25,14 +25,20 @@ namespace GolfEngine
         CircleEntity(float radius) : GolfEngine::Entity()
         {
             this->shape = new GolfEngine::Circle(radius);
+            this->setRadius(radius);
+            this->setFlag(GolfEngine::EntityStore::FLAG_CIRCLE, true);
         }
         CircleEntity(float radius, GolfEngine::Vector2 pos) : GolfEngine::Entity(pos)
         {
             this->shape = new GolfEngine::Circle(radius);
+            this->setRadius(radius);
+            this->setFlag(GolfEngine::EntityStore::FLAG_CIRCLE, true);
         }
         CircleEntity(float radius, GolfEngine::Vector2 pos, float rotation) : GolfEngine::Entity(pos, rotation)
         {
             this->shape = new GolfEngine::Circle(radius);
+            this->setRadius(radius);
+            this->setFlag(GolfEngine::EntityStore::FLAG_CIRCLE, true);
         }
 
         ~CircleEntity()
@@ -12,9 +12,11 @@
 #include "../../Rendering/Renderable.hpp"
 #include "../../Geometry/Vector2.hpp"
 #include "../Tag.hpp"
+#include "../EntityStore.hpp"
 #include <cmath>
 #include <stdexcept>
 #include <iostream>
+#include <vector>
 
 namespace GolfEngine
 {
@@ -32,19 +34,32 @@ namespace GolfEngine
 
         typedef void (*EntityFunction)(GolfEngine::Entity *);
 
-        Entity() : GolfEngine::Renderable()
+        Entity() : GolfEngine::Renderable(), store(nullptr), slot(0), tag_slot(0), dirty_slot(0)
         {
+            this->state.flags = GolfEngine::EntityStore::FLAG_ACTIVE;
             this->setRespawnPosition(this->getPosition());
         };
-        Entity(GolfEngine::Vector2 pos) : GolfEngine::Renderable(pos)
+        Entity(GolfEngine::Vector2 pos) : GolfEngine::Renderable(pos), store(nullptr), slot(0), tag_slot(0), dirty_slot(0)
         {
+            this->state.position = pos;
+            this->state.flags = GolfEngine::EntityStore::FLAG_ACTIVE;
             this->setRespawnPosition(this->getPosition());
         };
-        Entity(GolfEngine::Vector2 pos, float rotation) : GolfEngine::Renderable(pos, rotation)
+        Entity(GolfEngine::Vector2 pos, float rotation) : GolfEngine::Renderable(pos, rotation), store(nullptr), slot(0), tag_slot(0), dirty_slot(0)
         {
+            this->state.position = pos;
+            this->state.flags = GolfEngine::EntityStore::FLAG_ACTIVE;
             this->setRespawnPosition(this->getPosition());
         };
 
+        virtual ~Entity()
+        {
+            if (this->store != nullptr)
+            {
+                this->store->remove(this);
+            }
+        }
+
         /**
          * @brief Apply acceleration to the entity.
          *
@@ -88,7 +103,11 @@ namespace GolfEngine
          */
         inline GolfEngine::Vector2 getVelocity() const
         {
-            return this->velocity;
+            if (this->store != nullptr)
+            {
+                return GolfEngine::Vector2(this->store->vel_x[this->slot], this->store->vel_y[this->slot]);
+            }
+            return this->state.velocity;
         }
 
         /**
@@ -98,7 +117,11 @@ namespace GolfEngine
          */
         inline GolfEngine::Vector2 getAcceleration() const
         {
-            return this->acceleration;
+            if (this->store != nullptr)
+            {
+                return GolfEngine::Vector2(this->store->acc_x[this->slot], this->store->acc_y[this->slot]);
+            }
+            return this->state.acceleration;
         }
 
         /**
@@ -108,11 +131,14 @@ namespace GolfEngine
          */
         inline void setVelocity(const GolfEngine::Vector2& vel)
         {
-            if(vel.magnitudeSqr() < 1){
-                this->velocity = GolfEngine::Vector2::zero;
+            GolfEngine::Vector2 new_velocity = (vel.magnitudeSqr() < 1) ? GolfEngine::Vector2::zero : vel;
+            if (this->store != nullptr)
+            {
+                this->store->vel_x[this->slot] = new_velocity.x;
+                this->store->vel_y[this->slot] = new_velocity.y;
                 return;
             }
-            this->velocity = vel;
+            this->state.velocity = new_velocity;
         }
 
         /**
@@ -122,11 +148,14 @@ namespace GolfEngine
          */
         inline void setAcceleration(const GolfEngine::Vector2& accel)
         {
-            if(accel.magnitudeSqr() < 1){
-                this->acceleration = GolfEngine::Vector2::zero;
+            GolfEngine::Vector2 new_acceleration = (accel.magnitudeSqr() < 1) ? GolfEngine::Vector2::zero : accel;
+            if (this->store != nullptr)
+            {
+                this->store->acc_x[this->slot] = new_acceleration.x;
+                this->store->acc_y[this->slot] = new_acceleration.y;
                 return;
             }
-            this->acceleration = accel;
+            this->state.acceleration = new_acceleration;
         }
 
 
@@ -182,7 +211,17 @@ namespace GolfEngine
          */
         inline void setTag(std::string tag)
         {
-            this->tag = GolfEngine::Tag(tag);
+            this->setTag(GolfEngine::Tag(tag));
+        }
+
+        /**
+         * @brief Set the entity's tag.
+         *
+         * @param tag String representing the entity's new tag.
+         */
+        inline void setTag(const char *tag)
+        {
+            this->setTag(GolfEngine::Tag(tag));
         }
 
         /**
@@ -192,6 +231,12 @@ namespace GolfEngine
         */
         inline void setTag(GolfEngine::Tag tag)
         {
+            if (this->store != nullptr)
+            {
+                // The store keeps the Tilemap's tag index up to date.
+                this->store->retag(this, tag);
+                return;
+            }
             this->tag = tag;
         }
 
@@ -225,6 +270,16 @@ namespace GolfEngine
             return this->getTag() == tag;
         }
 
+        /**
+         * @brief Check if the entity has a tag matching the given string.
+         *
+         * @param tag Tag to check.
+         * @returns True if the entity's tag is the same, false otherwise.
+        */
+        inline bool hasTag(const char *tag) const{
+            return this->getTag() == tag;
+        }
+
         /**
          * @brief Respawn the entity.
         */
@@ -262,7 +317,14 @@ namespace GolfEngine
          */
         inline void setPosition(GolfEngine::Vector2 pos)
         {
-            this->setOrigin(pos);
+            if (this->store != nullptr)
+            {
+                this->store->pos_x[this->slot] = pos.x;
+                this->store->pos_y[this->slot] = pos.y;
+                this->store->markDirty(this->slot);
+                return;
+            }
+            this->state.position = pos;
         }
 
         /**
@@ -272,7 +334,77 @@ namespace GolfEngine
          */
         inline GolfEngine::Vector2 getPosition() const
         {
-            return this->getOrigin();
+            if (this->store != nullptr)
+            {
+                return GolfEngine::Vector2(this->store->pos_x[this->slot], this->store->pos_y[this->slot]);
+            }
+            return this->state.position;
+        }
+
+        /**
+         * @brief Set the entity's origin. For entities, this is the same as their position.
+         *
+         * @param origin New origin.
+         * @note Overrides \ref GolfEngine::Renderable::setOrigin, as an entity's position lives in its EntityStore.
+         */
+        inline void setOrigin(const GolfEngine::Vector2 origin) override
+        {
+            this->setPosition(origin);
+        }
+
+        /**
+         * @brief Get the entity's origin. For entities, this is the same as their position.
+         *
+         * @returns The entity's origin.
+         */
+        inline GolfEngine::Vector2 getOrigin() const override
+        {
+            return this->getPosition();
+        }
+
+        /**
+         * @brief Get the entity's collision radius.
+         *
+         * @returns The radius the entity collides with, 0 if it does not collide as a circle.
+         */
+        inline float getRadius() const
+        {
+            if (this->store != nullptr)
+            {
+                return this->store->radius[this->slot];
+            }
+            return this->state.radius;
+        }
+
+        /**
+         * @brief Check whether one of the entity's EntityStore flags is set.
+         *
+         * @param flag Flag to check.
+         * @returns True if the flag is set, false otherwise.
+         */
+        inline bool hasFlag(unsigned int flag) const
+        {
+            return (this->getFlags() & flag) != 0;
+        }
+
+        /**
+         * @brief Get the store the entity's physics state lives in.
+         *
+         * @returns The entity's store, or nullptr if it is not attached to one.
+         */
+        inline GolfEngine::EntityStore *getEntityStore() const
+        {
+            return this->store;
+        }
+
+        /**
+         * @brief Get the slot the entity's physics state lives in, within its store.
+         *
+         * @returns The entity's slot. Only meaningful while the entity is attached to a store.
+         */
+        inline std::size_t getSlot() const
+        {
+            return this->slot;
         }
 
         virtual EntityType getEntityType() const = 0;
@@ -284,7 +416,7 @@ namespace GolfEngine
          */
         inline bool isActive() const
         {
-            return this->active;
+            return this->hasFlag(GolfEngine::EntityStore::FLAG_ACTIVE);
         }
 
         /**
@@ -294,17 +426,70 @@ namespace GolfEngine
          */
         inline void setActiveStatus(bool status)
         {
-            this->active = status;
+            this->setFlag(GolfEngine::EntityStore::FLAG_ACTIVE, status);
+        }
+
+    protected:
+        /**
+         * @brief Set the entity's collision radius.
+         *
+         * @param radius New radius.
+         */
+        inline void setRadius(float radius)
+        {
+            if (this->store != nullptr)
+            {
+                this->store->radius[this->slot] = radius;
+                return;
+            }
+            this->state.radius = radius;
+        }
+
+        /**
+         * @brief Set or clear one of the entity's EntityStore flags.
+         *
+         * @param flag Flag to change.
+         * @param status True to set the flag, false to clear it.
+         */
+        inline void setFlag(unsigned int flag, bool status)
+        {
+            unsigned int *flags = (this->store != nullptr) ? &this->store->flags[this->slot] : &this->state.flags;
+            if (status)
+            {
+                *flags |= flag;
+            }
+            else
+            {
+                *flags &= ~flag;
+            }
         }
 
     private:
+        friend class GolfEngine::EntityStore;
+        friend class GolfEngine::EntityIndex;
+
         // Entity properties.
-        GolfEngine::Vector2 velocity;
-        GolfEngine::Vector2 acceleration;
         GolfEngine::Tag tag;
         GolfEngine::Vector2 respawn_pos;
 
-        bool active;
+        // Physics state lives in the store while attached to one, and in state otherwise.
+        GolfEngine::EntityStore *store;
+        std::size_t slot;
+        GolfEngine::EntityState state;
+
+        // Position in the Tilemap's tag index, while attached to a store that has one.
+        std::size_t tag_slot;
+        // Position in the store's dirty list, while the entity is flagged as dirty.
+        std::size_t dirty_slot;
+
+        inline unsigned int getFlags() const
+        {
+            if (this->store != nullptr)
+            {
+                return this->store->flags[this->slot];
+            }
+            return this->state.flags;
+        }
     };
 };
 
@@ -19,12 +19,12 @@ namespace GolfEngine {
             static const int COLOR = 0x010101;
             Goal() : GolfEngine::CircleEntity(Goal::RADIUS) {
                 this->getShape()->setColor(Goal::COLOR);
-                this->setTag("Goal");
+                this->setTag(GolfEngine::Tags::GOAL);
             }
             
             Goal(const GolfEngine::Vector2& pos) : GolfEngine::CircleEntity(Goal::RADIUS, pos){
                 this->getShape()->setColor(Goal::COLOR);
-                this->setTag("Goal");
+                this->setTag(GolfEngine::Tags::GOAL);
             }
     };
 }
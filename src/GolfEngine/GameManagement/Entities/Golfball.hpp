@@ -11,7 +11,6 @@
 
 #include "../../Geometry/Vector2.hpp"
 #include "CircleEntity.hpp"
-#include <iostream>
 
 namespace GolfEngine
 {
@@ -30,35 +29,35 @@ namespace GolfEngine
         Golfball() : GolfEngine::CircleEntity(Golfball::RADIUS), score(0)
         {
             this->getShape()->setColor(Golfball::COLOR);
-            this->setTag("Golfball");
+            this->setTag(GolfEngine::Tags::GOLFBALL);
+            this->setFlag(GolfEngine::EntityStore::FLAG_GOLFBALL, true);
             this->setActiveStatus(true);
             this->setState(GolfballStates::STILL);
         }
         Golfball(const GolfEngine::Vector2& pos) : GolfEngine::CircleEntity(Golfball::RADIUS, pos), score(0) {
             this->getShape()->setColor(Golfball::COLOR);
-            this->setTag("Golfball");
+            this->setTag(GolfEngine::Tags::GOLFBALL);
+            this->setFlag(GolfEngine::EntityStore::FLAG_GOLFBALL, true);
             this->setActiveStatus(true);
             this->setState(GolfballStates::STILL);
         }
 
         GolfballStates getState() const {
-            return this->currentState;
+            return this->hasFlag(GolfEngine::EntityStore::FLAG_MOVING) ? GolfballStates::MOVING : GolfballStates::STILL;
         }
 
         void setState(const GolfballStates& state) {
-            this->currentState = state;
+            this->setFlag(GolfEngine::EntityStore::FLAG_MOVING, state == GolfballStates::MOVING);
         }
 
         void addScore(){
             this->score++;
-            std::cout << "New Score: " << this->score << std::endl;
         }
 
         int getScore(){
             return this->score;
         }
     private:
-        GolfballStates currentState;
         int score;
     };
 }
@@ -12,15 +12,25 @@
 #include "Entity.hpp"
 #include "CircleEntity.hpp"
 #include "../../Geometry/Shapes/Polygon.hpp"
+#include <algorithm>
 
 namespace GolfEngine
 {
     class PolygonEntity : public GolfEngine::Entity
     {
     public:
-        PolygonEntity(Polygon *polygon) : shape(polygon), GolfEngine::Entity(){};
-        PolygonEntity(Polygon *polygon, GolfEngine::Vector2 pos) : shape(polygon), GolfEngine::Entity(pos){};
-        PolygonEntity(Polygon *polygon, GolfEngine::Vector2 pos, float rotation) : shape(polygon), GolfEngine::Entity(pos, rotation){};
+        PolygonEntity(Polygon *polygon) : GolfEngine::Entity(), shape(polygon)
+        {
+            this->initializeBounds();
+        }
+        PolygonEntity(Polygon *polygon, GolfEngine::Vector2 pos) : GolfEngine::Entity(pos), shape(polygon)
+        {
+            this->initializeBounds();
+        }
+        PolygonEntity(Polygon *polygon, GolfEngine::Vector2 pos, float rotation) : GolfEngine::Entity(pos, rotation), shape(polygon)
+        {
+            this->initializeBounds();
+        }
 
         inline virtual void render(sf::RenderWindow *window)
         {
@@ -44,6 +54,20 @@ namespace GolfEngine
 
     private:
         GolfEngine::Polygon *shape;
+
+        /**
+         * @brief Store the radius of the smallest origin-centered circle holding the polygon, so the broadphase can bound it.
+         */
+        inline void initializeBounds()
+        {
+            double bound = 0;
+            for (uint i = 0; i < this->shape->getVertexCount(); i++)
+            {
+                bound = std::max(bound, (double)this->shape->getPoint(i).magnitude());
+            }
+            this->setRadius(bound);
+            this->setFlag(GolfEngine::EntityStore::FLAG_POLYGON, true);
+        }
     };
 }
 
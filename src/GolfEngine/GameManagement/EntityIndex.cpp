@@ -0,0 +1,40 @@
+/**
+ * @file EntityIndex.cpp
+ * @brief This file contains definitions for the EntityIndex class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-27
+ */
+
+#include "EntityIndex.hpp"
+
+using GolfEngine::EntityIndex;
+
+void EntityIndex::insert(GolfEngine::Entity *ent)
+{
+    GolfEngine::Entity::EntityList &list = this->lists[ent->tag.getId()];
+    ent->tag_slot = list.size();
+    list.push_back(ent);
+}
+
+void EntityIndex::erase(GolfEngine::Entity *ent)
+{
+    GolfEngine::Entity::EntityList &list = this->lists[ent->tag.getId()];
+    std::size_t slot = ent->tag_slot;
+    GolfEngine::Entity *moved = list.back();
+    list[slot] = moved;
+    moved->tag_slot = slot;
+    list.pop_back();
+    ent->tag_slot = 0;
+}
+
+const GolfEngine::Entity::EntityList &EntityIndex::find(const GolfEngine::Tag &tag) const
+{
+    static const GolfEngine::Entity::EntityList none;
+    auto it = this->lists.find(tag.getId());
+    if (it == this->lists.end())
+    {
+        return none;
+    }
+    return it->second;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file EntityIndex.hpp
+ * @brief This file contains declerations for the EntityIndex class.
+ *
+ * An EntityIndex keeps a list of entities for every tag, so that finding every entity
+ * with a tag is a lookup instead of a scan over the whole Tilemap. EntityStores keep it
+ * up to date as entities are added, removed and retagged.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-27
+ */
+
+#ifndef ENTITYINDEX_H
+#define ENTITYINDEX_H
+
+#include "Tag.hpp"
+#include "Entities/Entity.hpp"
+#include <unordered_map>
+
+namespace GolfEngine
+{
+    class EntityIndex
+    {
+    public:
+        EntityIndex() {}
+
+        /**
+         * @brief Add an entity to the list for its tag.
+         *
+         * @param ent Entity to add.
+         */
+        void insert(GolfEngine::Entity *ent);
+
+        /**
+         * @brief Remove an entity from the list for its tag. The last entity in the list is moved into its place.
+         *
+         * @param ent Entity to remove. Must have been inserted.
+         */
+        void erase(GolfEngine::Entity *ent);
+
+        /**
+         * @brief Find every entity with a tag.
+         *
+         * @param tag Tag to find.
+         * @returns The entities with the tag. The list is only valid until the index changes.
+         */
+        const GolfEngine::Entity::EntityList &find(const GolfEngine::Tag &tag) const;
+
+    private:
+        std::unordered_map<GolfEngine::Tag::Id, GolfEngine::Entity::EntityList> lists;
+
+        // Entities hold their position in their tag's list, so the index cannot be copied.
+        EntityIndex(const EntityIndex &);
+        EntityIndex &operator=(const EntityIndex &);
+    };
+}
+
+#endif
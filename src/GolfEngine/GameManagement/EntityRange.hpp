@@ -0,0 +1,108 @@
+/**
+ * @file EntityRange.hpp
+ * @brief This file contains definitions for the EntityRange class.
+ *
+ * An EntityRange is a lazy view over every entity in a list of tiles. It walks each tile's
+ * entities in place, so iterating it never allocates. It can be used in range-based for loops.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-27
+ */
+
+#ifndef ENTITYRANGE_H
+#define ENTITYRANGE_H
+
+#include "Tile.hpp"
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace GolfEngine
+{
+    class EntityRange
+    {
+    public:
+        typedef std::vector<GolfEngine::Tile *> TileList;
+
+        class iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef GolfEngine::Entity *value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef GolfEngine::Entity *const *pointer;
+            typedef GolfEngine::Entity *const &reference;
+
+            iterator(TileList::const_iterator tile, TileList::const_iterator end) : tile(tile), end(end), slot(0)
+            {
+                this->skipEmpty();
+            }
+
+            inline reference operator*() const
+            {
+                return (*(*this->tile)->getEntities())[this->slot];
+            }
+
+            inline iterator &operator++()
+            {
+                this->slot++;
+                this->skipEmpty();
+                return *this;
+            }
+
+            inline iterator operator++(int)
+            {
+                iterator old = *this;
+                ++(*this);
+                return old;
+            }
+
+            inline bool operator==(const iterator &rhs) const
+            {
+                return this->tile == rhs.tile && this->slot == rhs.slot;
+            }
+
+            inline bool operator!=(const iterator &rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+        private:
+            TileList::const_iterator tile;
+            TileList::const_iterator end;
+            std::size_t slot;
+
+            // Move on to the next tile with entities left in it, if the current one has run out.
+            inline void skipEmpty()
+            {
+                while (this->tile != this->end && this->slot >= (*this->tile)->getEntities()->size())
+                {
+                    ++this->tile;
+                    this->slot = 0;
+                }
+            }
+        };
+
+        EntityRange(const TileList &tiles) : tiles(&tiles) {}
+
+        inline iterator begin() const
+        {
+            return iterator(this->tiles->begin(), this->tiles->end());
+        }
+
+        inline iterator end() const
+        {
+            return iterator(this->tiles->end(), this->tiles->end());
+        }
+
+        inline bool empty() const
+        {
+            return this->begin() == this->end();
+        }
+
+    private:
+        const TileList *tiles;
+    };
+}
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ * @file EntityStore.cpp
+ * @brief This file contains definitions for the EntityStore class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-24
+ */
+
+#include "EntityStore.hpp"
+#include "Entities/Entity.hpp"
+#include "EntityIndex.hpp"
+#include "../Physics/IntegrationKernel.hpp"
+#include <stdexcept>
+#include <cmath>
+
+using GolfEngine::EntityStore;
+
+EntityStore::~EntityStore()
+{
+    // Hand every entity its state back, so none of them are left pointing at freed memory.
+    while (!this->owners.empty())
+    {
+        this->remove(this->owners.back());
+    }
+}
+
+void EntityStore::add(GolfEngine::Entity *ent)
+{
+    if (ent->store != nullptr)
+    {
+        throw std::logic_error("Cannot add an entity that already belongs to a store.");
+    }
+    std::size_t slot = this->owners.size();
+    this->owners.push_back(ent);
+    this->pos_x.push_back(0);
+    this->pos_y.push_back(0);
+    this->vel_x.push_back(0);
+    this->vel_y.push_back(0);
+    this->acc_x.push_back(0);
+    this->acc_y.push_back(0);
+    this->radius.push_back(0);
+    this->flags.push_back(0);
+    this->write(slot, ent->state);
+
+    ent->store = this;
+    ent->slot = slot;
+    if (this->tag_index != nullptr)
+    {
+        this->tag_index->insert(ent);
+    }
+}
+
+bool EntityStore::remove(GolfEngine::Entity *ent)
+{
+    if (ent->store != this)
+    {
+        return false;
+    }
+    std::size_t slot = ent->slot;
+    if ((this->flags[slot] & EntityStore::FLAG_DIRTY) && this->dirty_list != nullptr)
+    {
+        // Don't leave a pointer to an entity that may be about to be deleted.
+        std::vector<GolfEngine::Entity *> &list = *this->dirty_list;
+        std::size_t index = ent->dirty_slot;
+        if (index < list.size() && list[index] == ent)
+        {
+            GolfEngine::Entity *moved = list.back();
+            list[index] = moved;
+            moved->dirty_slot = index;
+            list.pop_back();
+        }
+        this->flags[slot] &= ~EntityStore::FLAG_DIRTY;
+    }
+    ent->dirty_slot = 0;
+    if (this->tag_index != nullptr)
+    {
+        this->tag_index->erase(ent);
+    }
+    this->read(slot, ent->state);
+    ent->store = nullptr;
+    ent->slot = 0;
+
+    // Move the last slot into the hole.
+    std::size_t last = this->owners.size() - 1;
+    if (slot != last)
+    {
+        GolfEngine::Entity *moved = this->owners[last];
+        this->owners[slot] = moved;
+        this->pos_x[slot] = this->pos_x[last];
+        this->pos_y[slot] = this->pos_y[last];
+        this->vel_x[slot] = this->vel_x[last];
+        this->vel_y[slot] = this->vel_y[last];
+        this->acc_x[slot] = this->acc_x[last];
+        this->acc_y[slot] = this->acc_y[last];
+        this->radius[slot] = this->radius[last];
+        this->flags[slot] = this->flags[last];
+        moved->slot = slot;
+    }
+    this->owners.pop_back();
+    this->pos_x.pop_back();
+    this->pos_y.pop_back();
+    this->vel_x.pop_back();
+    this->vel_y.pop_back();
+    this->acc_x.pop_back();
+    this->acc_y.pop_back();
+    this->radius.pop_back();
+    this->flags.pop_back();
+    return true;
+}
+
+void EntityStore::read(std::size_t slot, GolfEngine::EntityState &state) const
+{
+    state.position = GolfEngine::Vector2(this->pos_x[slot], this->pos_y[slot]);
+    state.velocity = GolfEngine::Vector2(this->vel_x[slot], this->vel_y[slot]);
+    state.acceleration = GolfEngine::Vector2(this->acc_x[slot], this->acc_y[slot]);
+    state.radius = this->radius[slot];
+    state.flags = this->flags[slot];
+}
+
+void EntityStore::write(std::size_t slot, const GolfEngine::EntityState &state)
+{
+    this->pos_x[slot] = state.position.x;
+    this->pos_y[slot] = state.position.y;
+    this->vel_x[slot] = state.velocity.x;
+    this->vel_y[slot] = state.velocity.y;
+    this->acc_x[slot] = state.acceleration.x;
+    this->acc_y[slot] = state.acceleration.y;
+    this->radius[slot] = state.radius;
+    this->flags[slot] = state.flags;
+}
+
+void EntityStore::integrate(double dt_s, double friction)
+{
+    GolfEngine::IntegrationBatch batch;
+    batch.pos_x = this->pos_x.data();
+    batch.pos_y = this->pos_y.data();
+    batch.vel_x = this->vel_x.data();
+    batch.vel_y = this->vel_y.data();
+    batch.acc_x = this->acc_x.data();
+    batch.acc_y = this->acc_y.data();
+    batch.count = this->owners.size();
+    GolfEngine::IntegrationKernel::integrate(batch, dt_s, friction);
+}
+
+void EntityStore::quantize(double scale)
+{
+    std::vector<GolfEngine::Scalar> *fields[] = {&this->pos_x, &this->pos_y, &this->vel_x, &this->vel_y, &this->acc_x, &this->acc_y};
+    for (std::vector<GolfEngine::Scalar> *field : fields)
+    {
+        for (GolfEngine::Scalar &value : *field)
+        {
+            value = EntityStore::quantize(value, scale);
+        }
+    }
+}
+
+/**
+ * @brief Fold a 64 bit word into an FNV-1a hash, a byte at a time, least significant first.
+ */
+static inline std::uint64_t hashWord(std::uint64_t hash, std::uint64_t word)
+{
+    for (unsigned int i = 0; i < 8; i++)
+    {
+        hash ^= (word >> (i * 8)) & 0xFF;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+std::uint64_t EntityStore::hashState(std::uint64_t hash, double scale) const
+{
+    // The dirty flag only says whether the Tilemap has gotten around to checking the entity yet.
+    const unsigned int transient = EntityStore::FLAG_DIRTY;
+    for (std::size_t i = 0; i < this->owners.size(); i++)
+    {
+        const double values[] = {this->pos_x[i], this->pos_y[i], this->vel_x[i], this->vel_y[i], this->acc_x[i], this->acc_y[i]};
+        for (double value : values)
+        {
+            hash = hashWord(hash, (std::uint64_t)std::llround(value * scale));
+        }
+        hash = hashWord(hash, this->flags[i] & ~transient);
+    }
+    return hash;
+}
+
+void EntityStore::markDirty(std::size_t slot)
+{
+    if (this->dirty_list == nullptr || (this->flags[slot] & EntityStore::FLAG_DIRTY))
+    {
+        return;
+    }
+    this->flags[slot] |= EntityStore::FLAG_DIRTY;
+    GolfEngine::Entity *ent = this->owners[slot];
+    ent->dirty_slot = this->dirty_list->size();
+    this->dirty_list->push_back(ent);
+}
+
+void EntityStore::appendDirty(std::vector<GolfEngine::Entity *> &list, std::vector<GolfEngine::Entity *> &entities)
+{
+    for (GolfEngine::Entity *ent : entities)
+    {
+        ent->dirty_slot = list.size();
+        list.push_back(ent);
+    }
+    entities.clear();
+}
+
+void EntityStore::markEscaped(GolfEngine::Scalar min_x, GolfEngine::Scalar min_y, GolfEngine::Scalar max_x, GolfEngine::Scalar max_y)
+{
+    for (std::size_t i = 0; i < this->owners.size(); i++)
+    {
+        GolfEngine::Scalar x = this->pos_x[i];
+        GolfEngine::Scalar y = this->pos_y[i];
+        if (x < min_x || x >= max_x || y < min_y || y >= max_y)
+        {
+            this->markDirty(i);
+        }
+    }
+}
+
+void EntityStore::clearDirty(GolfEngine::Entity *ent)
+{
+    this->flags[ent->slot] &= ~EntityStore::FLAG_DIRTY;
+}
+
+void EntityStore::retag(GolfEngine::Entity *ent, const GolfEngine::Tag &tag)
+{
+    if (this->tag_index != nullptr)
+    {
+        this->tag_index->erase(ent);
+    }
+    ent->tag = tag;
+    if (this->tag_index != nullptr)
+    {
+        this->tag_index->insert(ent);
+    }
+}
@@ -0,0 +1,258 @@
+/**
+ * @file EntityStore.hpp
+ * @brief This file contains declerations for the EntityStore class.
+ *
+ * An EntityStore keeps the physics state of a group of entities in a structure-of-arrays
+ * layout, so that the physics update can walk positions, velocities and accelerations
+ * linearly instead of chasing an Entity pointer (and a virtual call) per entity.
+ * Entities attached to a store act as handles onto their slot.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-24
+ */
+
+#ifndef ENTITYSTORE_H
+#define ENTITYSTORE_H
+
+#include "../Geometry/Vector2.hpp"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+
+namespace GolfEngine
+{
+    class Entity;
+    class EntityIndex;
+    class Tag;
+
+    /**
+     * @brief Physics state of a single entity.
+     *
+     * This is where an entity keeps its state while it is not attached to an EntityStore.
+     */
+    struct EntityState
+    {
+        GolfEngine::Vector2 position;
+        GolfEngine::Vector2 velocity;
+        GolfEngine::Vector2 acceleration;
+        float radius;
+        unsigned int flags;
+
+        EntityState() : radius(0), flags(0){};
+    };
+
+    class EntityStore
+    {
+    public:
+        /**
+         * @brief The entity is active.
+         */
+        static const unsigned int FLAG_ACTIVE = 1 << 0;
+        /**
+         * @brief The entity collides as a circle of the stored radius.
+         */
+        static const unsigned int FLAG_CIRCLE = 1 << 1;
+        /**
+         * @brief The entity is a golfball.
+         */
+        static const unsigned int FLAG_GOLFBALL = 1 << 2;
+        /**
+         * @brief The entity (a golfball) is in motion.
+         */
+        static const unsigned int FLAG_MOVING = 1 << 3;
+        /**
+         * @brief The entity collides as a polygon. Its stored radius bounds the polygon.
+         */
+        static const unsigned int FLAG_POLYGON = 1 << 4;
+        /**
+         * @brief The entity is waiting in the dirty list to be checked for a change of tile.
+         */
+        static const unsigned int FLAG_DIRTY = 1 << 5;
+
+        EntityStore() : dirty_list(nullptr), tag_index(nullptr) {}
+        ~EntityStore();
+
+        /**
+         * @brief Attach an entity to the store, moving its state into a new slot.
+         *
+         * @param ent Entity to attach.
+         * @throws std::logic_error If the entity is already attached to a store.
+         */
+        void add(GolfEngine::Entity *ent);
+
+        /**
+         * @brief Detach an entity from the store, moving its state back into the entity.
+         *
+         * The last slot is moved into the freed one, so this is O(1) but does not preserve order.
+         *
+         * @param ent Entity to detach.
+         * @returns True if the entity was in the store, false otherwise.
+         */
+        bool remove(GolfEngine::Entity *ent);
+
+        /**
+         * @brief Get the amount of entities in the store.
+         *
+         * @returns Amount of occupied slots.
+         */
+        inline std::size_t size() const
+        {
+            return this->owners.size();
+        }
+
+        /**
+         * @brief Get the entities in the store, indexed by slot.
+         *
+         * @returns Pointer to the list of entities.
+         */
+        inline std::vector<GolfEngine::Entity *> *getEntities()
+        {
+            return &this->owners;
+        }
+
+        /**
+         * @brief Copy a slot's state out of the store.
+         *
+         * @param slot Slot to read.
+         * @param state State to write into.
+         */
+        void read(std::size_t slot, GolfEngine::EntityState &state) const;
+
+        /**
+         * @brief Copy a state into a slot.
+         *
+         * @param slot Slot to write.
+         * @param state State to copy.
+         */
+        void write(std::size_t slot, const GolfEngine::EntityState &state);
+
+        /**
+         * @brief Apply acceleration, velocity and friction to every entity in the store.
+         *
+         * This is equivalent to calling \ref GolfEngine::Entity::applyAcceleration "applyAcceleration",
+         * \ref GolfEngine::Entity::applyVelocity "applyVelocity" and then scaling velocity by the friction factor on each entity.
+         *
+         * The work is done by \ref GolfEngine::IntegrationKernel, which vectorizes it where the CPU allows.
+         *
+         * @param dt_s Time, in seconds, to factor in.
+         * @param friction Factor to scale velocity by after integration.
+         */
+        void integrate(double dt_s, double friction);
+
+        /**
+         * @brief Set the list entities are added to when they may have moved out of the store's bounds.
+         *
+         * @param list List to use, or nullptr to stop tracking.
+         */
+        inline void setDirtyList(std::vector<GolfEngine::Entity *> *list)
+        {
+            this->dirty_list = list;
+        }
+
+        /**
+         * @brief Add a slot's entity to the dirty list, unless it is already in it.
+         *
+         * @param slot Slot to mark.
+         */
+        void markDirty(std::size_t slot);
+
+        /**
+         * @brief Move entities onto the end of a dirty list, keeping track of where each of them ends up.
+         *
+         * @param list Dirty list to append to.
+         * @param entities Entities to move. Cleared afterwards.
+         */
+        static void appendDirty(std::vector<GolfEngine::Entity *> &list, std::vector<GolfEngine::Entity *> &entities);
+
+        /**
+         * @brief Mark every entity outside of a rectangle as dirty.
+         *
+         * @param min_x Left edge, inclusive.
+         * @param min_y Top edge, inclusive.
+         * @param max_x Right edge, exclusive.
+         * @param max_y Bottom edge, exclusive.
+         */
+        void markEscaped(GolfEngine::Scalar min_x, GolfEngine::Scalar min_y, GolfEngine::Scalar max_x, GolfEngine::Scalar max_y);
+
+        /**
+         * @brief Round every position, velocity and acceleration to the nearest multiple of 1 / scale.
+         *
+         * The rounding is done in double precision, then stored back as a GolfEngine::Scalar. With float scalars,
+         * values too large to hold every fractional bit keep float's own resolution instead, which rounds the
+         * same way everywhere too.
+         *
+         * @param scale Fixed-point scale. Should be a power of two, so the rounding is exact.
+         */
+        void quantize(double scale);
+
+        /**
+         * @brief Round a value to the nearest multiple of 1 / scale, as \ref quantize "quantize()" does.
+         */
+        static inline GolfEngine::Scalar quantize(GolfEngine::Scalar value, double scale)
+        {
+            return (GolfEngine::Scalar)(std::round(value * scale) / scale);
+        }
+
+        /**
+         * @brief Fold the physics state of every slot into a hash, in slot order.
+         *
+         * Positions, velocities and accelerations are hashed as fixed-point integers, so the hash
+         * doesn't depend on how scalars are laid out in memory.
+         *
+         * @param hash Hash to fold the state into.
+         * @param scale Fixed-point scale.
+         * @returns The updated hash.
+         */
+        std::uint64_t hashState(std::uint64_t hash, double scale) const;
+
+        /**
+         * @brief Set the tag index entities are registered with while they are in the store.
+         *
+         * Entities already in the store are not registered or unregistered by this.
+         *
+         * @param index Index to use, or nullptr to stop indexing.
+         */
+        inline void setTagIndex(GolfEngine::EntityIndex *index)
+        {
+            this->tag_index = index;
+        }
+
+        /**
+         * @brief Change an attached entity's tag, keeping the tag index up to date.
+         *
+         * @param ent Entity to retag. Must be attached to this store.
+         * @param tag New tag.
+         */
+        void retag(GolfEngine::Entity *ent, const GolfEngine::Tag &tag);
+
+        /**
+         * @brief Clear an entity's dirty flag, once it has been taken off the dirty list.
+         *
+         * @param ent Entity to clear. Must be attached to this store.
+         */
+        void clearDirty(GolfEngine::Entity *ent);
+
+        // Physics state, indexed by slot.
+
+        std::vector<GolfEngine::Scalar> pos_x;
+        std::vector<GolfEngine::Scalar> pos_y;
+        std::vector<GolfEngine::Scalar> vel_x;
+        std::vector<GolfEngine::Scalar> vel_y;
+        std::vector<GolfEngine::Scalar> acc_x;
+        std::vector<GolfEngine::Scalar> acc_y;
+        std::vector<float> radius;
+        std::vector<unsigned int> flags;
+
+    private:
+        std::vector<GolfEngine::Entity *> owners;
+        std::vector<GolfEngine::Entity *> *dirty_list;
+        GolfEngine::EntityIndex *tag_index;
+
+        // Stores hand their slots out to entities, and cannot be copied.
+        EntityStore(const EntityStore &);
+        EntityStore &operator=(const EntityStore &);
+    };
+}
+
+#endif
@@ -0,0 +1,86 @@
+/**
+ * @file FrameArena.cpp
+ * @brief This file contains definitions for the FrameArena class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-27
+ */
+
+#include "FrameArena.hpp"
+#include <cstdint>
+#include <stdexcept>
+
+using GolfEngine::FrameArena;
+
+FrameArena::FrameArena(std::size_t block_size) : current(0), offset(0), used(0), heap_allocations(0)
+{
+    if (block_size == 0)
+    {
+        throw std::domain_error("Arena block size must be greater than 0.");
+    }
+    this->blocks.reserve(4);
+    this->addBlock(block_size);
+}
+
+FrameArena::~FrameArena()
+{
+    for (Block &block : this->blocks)
+    {
+        delete[] block.data;
+    }
+}
+
+void FrameArena::addBlock(std::size_t size)
+{
+    Block block;
+    block.data = new char[size];
+    block.size = size;
+    this->blocks.push_back(block);
+    this->heap_allocations++;
+}
+
+void FrameArena::reset()
+{
+    if (this->blocks.size() > 1)
+    {
+        // Last frame overflowed. Merge everything into one block big enough for it.
+        std::size_t capacity = this->getCapacity();
+        for (Block &block : this->blocks)
+        {
+            delete[] block.data;
+        }
+        this->blocks.clear();
+        this->addBlock(capacity);
+    }
+    this->current = 0;
+    this->offset = 0;
+    this->used = 0;
+}
+
+void *FrameArena::allocate(std::size_t bytes, std::size_t alignment)
+{
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > alignof(std::max_align_t))
+    {
+        throw std::invalid_argument("Arena alignment must be a power of two no larger than max_align_t's.");
+    }
+    while (true)
+    {
+        Block &block = this->blocks[this->current];
+        std::uintptr_t start = (std::uintptr_t)(block.data + this->offset);
+        std::size_t padding = (alignment - (start & (alignment - 1))) & (alignment - 1);
+        if (this->offset + padding + bytes <= block.size)
+        {
+            this->offset += padding + bytes;
+            this->used += padding + bytes;
+            return block.data + this->offset - bytes;
+        }
+        // Doesn't fit. Move on to a fresh block, making one if needed.
+        this->current++;
+        this->offset = 0;
+        if (this->current == this->blocks.size())
+        {
+            std::size_t size = this->blocks[this->current - 1].size * 2;
+            this->addBlock(size < bytes ? bytes : size);
+        }
+    }
+}
@@ -0,0 +1,129 @@
+/**
+ * @file FrameArena.hpp
+ * @brief This file contains declerations for the FrameArena class.
+ *
+ * A FrameArena is a linear allocator for data that only lives for a single frame. Allocating
+ * bumps an offset, and everything is released at once by \ref GolfEngine::FrameArena::reset "reset()"
+ * at the start of the next frame. If a frame ever needs more than one block, the blocks are merged
+ * into a single larger one on reset, so a steady state frame makes no heap allocations at all.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-27
+ */
+
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace GolfEngine
+{
+    class FrameArena
+    {
+    public:
+        /**
+         * @brief Default size, in bytes, of the arena's first block.
+         */
+        static const std::size_t DEFAULT_BLOCK_SIZE = 16 * 1024;
+
+        FrameArena() : FrameArena(FrameArena::DEFAULT_BLOCK_SIZE) {}
+
+        /**
+         * @param block_size Size, in bytes, of the arena's first block.
+         * @throws std::domain_error If the block size is 0.
+         */
+        FrameArena(std::size_t block_size);
+
+        ~FrameArena();
+
+        /**
+         * @brief Release everything allocated since the last reset.
+         *
+         * Pointers handed out before the reset must not be used afterwards.
+         */
+        void reset();
+
+        /**
+         * @brief Allocate raw memory from the arena.
+         *
+         * @param bytes Amount of bytes to allocate.
+         * @param alignment Alignment of the memory. Must be a power of two no larger than alignof(std::max_align_t).
+         * @returns Pointer to the memory. It is valid until the next reset.
+         * @throws std::invalid_argument If the alignment is not supported.
+         */
+        void *allocate(std::size_t bytes, std::size_t alignment);
+
+        /**
+         * @brief Allocate an uninitialized array from the arena.
+         *
+         * Nothing allocated from an arena is ever destroyed, so only trivially destructible types are allowed.
+         *
+         * @param count Amount of elements.
+         * @returns Pointer to the first element. It is valid until the next reset.
+         */
+        template <typename T>
+        inline T *allocate(std::size_t count)
+        {
+            static_assert(std::is_trivially_destructible<T>::value, "Arena allocated types are never destroyed.");
+            return static_cast<T *>(this->allocate(count * sizeof(T), alignof(T)));
+        }
+
+        /**
+         * @brief Get the amount of bytes handed out since the last reset, including alignment padding.
+         *
+         * @returns Bytes in use.
+         */
+        inline std::size_t getUsed() const
+        {
+            return this->used;
+        }
+
+        /**
+         * @brief Get the total size of the arena's blocks.
+         *
+         * @returns Capacity in bytes.
+         */
+        inline std::size_t getCapacity() const
+        {
+            std::size_t capacity = 0;
+            for (const Block &block : this->blocks)
+            {
+                capacity += block.size;
+            }
+            return capacity;
+        }
+
+        /**
+         * @brief Get the amount of blocks the arena has ever allocated from the heap.
+         *
+         * @returns Heap allocation count.
+         */
+        inline std::size_t getHeapAllocations() const
+        {
+            return this->heap_allocations;
+        }
+
+    private:
+        struct Block
+        {
+            char *data;
+            std::size_t size;
+        };
+
+        std::vector<Block> blocks;
+        std::size_t current;
+        std::size_t offset;
+        std::size_t used;
+        std::size_t heap_allocations;
+
+        void addBlock(std::size_t size);
+
+        // Arenas own their blocks, and cannot be copied.
+        FrameArena(const FrameArena &);
+        FrameArena &operator=(const FrameArena &);
+    };
+}
+
+#endif
@@ -11,26 +11,35 @@
 #include <iostream>
 using GolfEngine::Level;
 
+void Level::onCollision(GolfEngine::CollisionSpan collisions)
+{
+    for (GolfEngine::Collision &collision : collisions)
+    {
+        this->handleCollision(collision);
+    }
+}
+
 // General, shared level collisions.
-void Level::onCollision(GolfEngine::Collision &collision)
+void Level::handleCollision(GolfEngine::Collision &collision)
 {
     // Goal collisions.
-    if (collision.getAttached()->getTag() == "Goal")
+    if (collision.getAttached()->hasTag(GolfEngine::Tags::GOAL))
     {
         // Goal shouldn't have any collisions.
         return;
     }
     // Golfball collisions.
-    if (collision.getAttached()->getTag() == "Golfball")
+    if (collision.getAttached()->hasTag(GolfEngine::Tags::GOLFBALL))
     {
         // If golfball hits goal, we win!
-        if (collision.getCollider()->getTag() == "Goal")
+        if (collision.getCollider()->hasTag(GolfEngine::Tags::GOAL))
         {
+            this->goal_reached = true;
             this->endScene(true);
             return;
         }
         // If golball hits obstacle, respawn!
-        if (collision.getCollider()->getTag() == "Obstacle")
+        if (collision.getCollider()->hasTag(GolfEngine::Tags::OBSTACLE))
         {
             collision.getAttached()->respawn();
         }
@@ -38,6 +47,7 @@ void Level::onCollision(GolfEngine::Collision &collision)
     this->levelCollisions(collision);
 }
 
+#ifndef GOLFENGINE_HEADLESS
 /**
  * @brief Mouse down event. Fires when the player presses down on a mouse button.
  *
@@ -47,25 +57,33 @@ void Level::onMouseDown(sf::Event::MouseButtonEvent &event)
 {
     GolfEngine::Vector2 target(event.x, event.y);
     this->setTarget(target);
+    this->aiming = true;
 }
+#endif
 
+constexpr float Level::MAX_SWING_FORCE;
+
+GolfEngine::Vector2 Level::aimForce(const GolfEngine::Vector2 &current) const
+{
+    GolfEngine::Vector2 force = (this->getTarget() - current) * 10;
+    if (force.magnitudeSqr() > (Level::MAX_SWING_FORCE * Level::MAX_SWING_FORCE))
+    {
+        force = force.normalized() * Level::MAX_SWING_FORCE;
+    }
+    return force;
+}
+
+#ifndef GOLFENGINE_HEADLESS
 /**
  * @brief Mouse up event. Fires when the player presses up on a mouse button.
  *
  * @param event Mouse Button event.
  */
-
-const float MAX_SWING_FORCE = 10000;
-
 void Level::onMouseUp(sf::Event::MouseButtonEvent &event)
 {
     GolfEngine::Vector2 current(event.x, event.y);
-    GolfEngine::Vector2 force = (this->getTarget() - current) * 10;
-    if (force.magnitudeSqr() > (MAX_SWING_FORCE * MAX_SWING_FORCE))
-    {
-        force = force.normalized() * MAX_SWING_FORCE;
-    }
-    this->applyPlayerForce(force);
+    this->aiming = false;
+    this->applyPlayerForce(this->aimForce(current));
 }
 
 /**
@@ -75,18 +93,32 @@ void Level::onMouseUp(sf::Event::MouseButtonEvent &event)
  */
 void Level::onMouseMove(sf::Event::MouseMoveEvent &event)
 {
-    // do nothing
-    if (event.x == 42)
+    if (!this->aiming)
     {
         return;
     }
+    this->predictShot(this->aimForce(GolfEngine::Vector2(event.x, event.y)));
 }
+#endif
 
-const GolfEngine::Tag PLAYER_TAG = GolfEngine::Tag("Golfball");
+const std::vector<GolfEngine::Vector2> &Level::predictShot(const GolfEngine::Vector2 &force)
+{
+    for (GolfEngine::Entity *golfball : this->findEntitiesWithTag(GolfEngine::Tags::GOLFBALL))
+    {
+        GolfEngine::Golfball *player = (GolfEngine::Golfball *)(golfball);
+        if (player->getState() == GolfEngine::GolfballStates::STILL)
+        {
+            this->aim_preview = &this->predictor.predict(*golfball, force);
+            return *this->aim_preview;
+        }
+    }
+    this->aim_preview = &this->no_preview;
+    return *this->aim_preview;
+}
 
 void Level::applyPlayerForce(const GolfEngine::Vector2 &force)
 {
-    for (GolfEngine::Entity *golfball : this->findEntitiesWithTag(PLAYER_TAG))
+    for (GolfEngine::Entity *golfball : this->findEntitiesWithTag(GolfEngine::Tags::GOLFBALL))
     {
         GolfEngine::Golfball *player = (GolfEngine::Golfball *)(golfball);
         if (player->getState() == GolfEngine::GolfballStates::STILL)
@@ -97,17 +129,34 @@ void Level::applyPlayerForce(const GolfEngine::Vector2 &force)
     }
 }
 
-void Level::frameUpdate(uint dt)
+void Level::placeBall(const GolfEngine::Vector2 &position)
+{
+    for (GolfEngine::Entity *golfball : this->findEntitiesWithTag(GolfEngine::Tags::GOLFBALL))
+    {
+        GolfEngine::Golfball *player = (GolfEngine::Golfball *)(golfball);
+        player->setPosition(position);
+        player->setRespawnPosition(position);
+        player->setVelocity(GolfEngine::Vector2::zero);
+        player->setAcceleration(GolfEngine::Vector2::zero);
+        player->setState(GolfEngine::GolfballStates::STILL);
+    }
+    this->goal_reached = false;
+}
+
+void Level::frameUpdate(double dt_s)
 {
     if(this->isPaused()) return;
     this->getTilemap()->reorderEntities();
-    // Convert dt (which is in milliseconds) to seconds
-    double dt_s = dt / 1000.0;
 
     // Apply acceleration + velocity
     GolfEngine::Tilemap *map = this->getTilemap();
-    GolfEngine::Collision::CollisionList collisions = map->frameUpdate(dt_s);
-    for(GolfEngine::Collision& collision : collisions){
-        this->onCollision(collision);
+    GolfEngine::CollisionSpan collisions = map->frameUpdate(dt_s);
+    if (!this->isQuiet())
+    {
+        for (GolfEngine::Entity *golfball : map->getStoppedGolfballs())
+        {
+            std::cout << "New Score: " << ((GolfEngine::Golfball *)(golfball))->getScore() << std::endl;
+        }
     }
+    this->onCollision(collisions);
 }
\ No newline at end of file
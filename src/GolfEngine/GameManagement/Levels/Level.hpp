@@ -12,13 +12,21 @@
 #include "../Scene.hpp"
 #include "../Collision.hpp"
 #include "../Tile.hpp"
+#include "../TrajectoryPredictor.hpp"
+#include "../../Simulation/FixedTimestep.hpp"
+#include <vector>
 
 namespace GolfEngine {
     class Level : public GolfEngine::Scene {
         public:
-            Level() : GolfEngine::Scene() {
+            /**
+             * @brief Strongest force the player can strike the ball with.
+             */
+            static constexpr float MAX_SWING_FORCE = 10000;
+
+            Level() : GolfEngine::Scene(), goal_reached(false), aiming(false), predictor(this->getTilemap(), GolfEngine::FixedTimestep().getStepSeconds()), aim_preview(&no_preview) {
             };
-            Level(unsigned int side_length) : GolfEngine::Scene(side_length) {
+            Level(unsigned int side_length) : GolfEngine::Scene(side_length), goal_reached(false), aiming(false), predictor(this->getTilemap(), GolfEngine::FixedTimestep().getStepSeconds()), aim_preview(&no_preview) {
             };
 
             /**
@@ -31,7 +39,7 @@ namespace GolfEngine {
 
             virtual void levelCollisions(GolfEngine::Collision& collision) = 0;
 
-            void onCollision(GolfEngine::Collision& collision) override;
+            void onCollision(GolfEngine::CollisionSpan collisions) override;
 
             /**
              * @brief Set the target position.
@@ -51,6 +59,7 @@ namespace GolfEngine {
                 return this->target;
             }
 
+#ifndef GOLFENGINE_HEADLESS
             /**
              * @brief Mouse down event. Fires when the player presses down on a mouse button.
              *
@@ -71,19 +80,81 @@ namespace GolfEngine {
              * @param event Mouse Move event.
              */
             void onMouseMove(sf::Event::MouseMoveEvent &event) override;            
+#endif
 
             void applyPlayerForce(const GolfEngine::Vector2& force);
 
+            /**
+             * @brief Put the ball at rest at a position, ready to be struck, as if no shot had been taken yet.
+             *
+             * @param position Position to place the ball at. Also becomes where it respawns.
+             */
+            void placeBall(const GolfEngine::Vector2& position);
+
+            /**
+             * @brief Predict where the player's ball would go if it were struck with a force, without striking it.
+             *
+             * See \ref GolfEngine::TrajectoryPredictor. Small changes to the force reuse the last prediction.
+             *
+             * @param force Force the ball would be struck with.
+             * @returns The ball's predicted path, or an empty path if no ball is ready to be struck.
+             */
+            const std::vector<GolfEngine::Vector2>& predictShot(const GolfEngine::Vector2& force);
+
+            /**
+             * @brief Get the path predicted for the shot the player is currently aiming.
+             *
+             * @returns The latest path predicted while dragging, e.g. for drawing an aim preview. Empty if the player hasn't aimed yet.
+             */
+            inline const std::vector<GolfEngine::Vector2>& getAimPreview() const {
+                return *this->aim_preview;
+            }
+
+            /**
+             * @brief Check whether the player is dragging out a shot.
+             */
+            inline bool isAiming() const {
+                return this->aiming;
+            }
+
+            /**
+             * @brief Check whether a golfball has reached the goal.
+             * 
+             * @returns True if a golfball has collided with the goal, false otherwise.
+            */
+            inline bool hasReachedGoal() const {
+                return this->goal_reached;
+            }
+
             /**
              * @brief Frame update
              *
-             * @param dt Time since last frame update (in ms)
+             * @param dt_s Fixed physics step (in seconds)
              */
-            void frameUpdate(uint dt);
+            void frameUpdate(double dt_s);
 
         private:
             GolfEngine::Vector2 target;
+            bool goal_reached;
+            bool aiming;
 
+            GolfEngine::TrajectoryPredictor predictor;
+            const std::vector<GolfEngine::Vector2>* aim_preview;
+            std::vector<GolfEngine::Vector2> no_preview;
+
+            /**
+             * @brief Get the force a shot released at a position would have, given the current target.
+             *
+             * @param current Position the mouse is released at.
+             */
+            GolfEngine::Vector2 aimForce(const GolfEngine::Vector2& current) const;
+
+            /**
+             * @brief Handle a single collision, then pass it on to \ref levelCollisions "levelCollisions()".
+             *
+             * @param collision Collision to handle.
+            */
+            void handleCollision(GolfEngine::Collision& collision);
     };
 }
 
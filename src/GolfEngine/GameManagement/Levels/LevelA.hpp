@@ -22,6 +22,9 @@ namespace GolfEngine
         void initialize();
 
         inline void endScene(bool winStatus) {
+            if(this->isQuiet()){
+                return;
+            }
             if(winStatus){
                 std::cout << "Congrats!! You win!" << std::endl;
             } else {
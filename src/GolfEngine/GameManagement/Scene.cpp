@@ -13,6 +13,18 @@
 
 using GolfEngine::Scene;
 
+Scene::~Scene(){
+    // Entities take themselves out of their tile's store, so they have to go while the tiles are still around.
+    for(GolfEngine::Entity* entity : this->owned_entities){
+        delete entity;
+    }
+    delete this->tilemap;
+    // Shared geometry is only deleted by the tile that owns it. See Tile::shareGeometry.
+    for(GolfEngine::Tile* tile : this->owned_tiles){
+        delete tile;
+    }
+}
+
 bool Scene::addEntity(GolfEngine::Entity* entity){
     GolfEngine::Vector2 pos = entity->getOrigin();
     GolfEngine::Tile* tile = this->findTile(pos);
@@ -20,6 +32,7 @@ bool Scene::addEntity(GolfEngine::Entity* entity){
         return false;
     }
     tile->addEntity(entity);
+    this->owned_entities.push_back(entity);
     return true;
 }
 
@@ -17,7 +17,9 @@
 #include "Collision.hpp"
 #include <cmath>
 #include <vector>
+#ifndef GOLFENGINE_HEADLESS
 #include <SFML/Graphics.hpp>
+#endif
 
 namespace GolfEngine
 {
@@ -28,21 +30,23 @@ namespace GolfEngine
         {
             this->tilemap = new GolfEngine::Tilemap();
             this->paused = false;
+            this->quiet = false;
         }
         Scene(unsigned int side_length)
         {
             this->tilemap = new GolfEngine::Tilemap(side_length);
             this->paused = false;
+            this->quiet = false;
         };
-        ~Scene()
-        {
-            delete this->tilemap;
-        }
+        /**
+         * @brief Delete the scene, along with every tile and entity added to it.
+         */
+        virtual ~Scene();
 
         /**
          * @brief This function adds an entity to the scene.
          *
-         * @param ent The entity to add to the scene.
+         * @param ent The entity to add to the scene. If the addition succeeds, the scene owns, and deletes, it.
          * @returns True if the addition was a success, false otherwise.
          */
         bool addEntity(Entity *ent);
@@ -50,20 +54,25 @@ namespace GolfEngine
         /**
          * @brief This function adds a tile to the scene.
          *
-         * @param tile The tile to add to the scene.
+         * @param tile The tile to add to the scene. If the addition succeeds, the scene owns, and deletes, it.
          * @returns True if the addition was a success, false otherwise.
          */
         inline bool addTile(Tile *tile)
         {
-            return this->tilemap->addTile(tile);
+            if (!this->tilemap->addTile(tile))
+            {
+                return false;
+            }
+            this->owned_tiles.push_back(tile);
+            return true;
         };
 
         /**
          * @brief Frame update
          *
-         * @param dt Time since last frame update (in ms)
+         * @param dt_s Fixed physics step (in seconds)
          */
-        virtual void frameUpdate(uint dt_ms) = 0;
+        virtual void frameUpdate(double dt_s) = 0;
 
         /**
          * @brief This function finds and returns a tile designated by a position.
@@ -87,9 +96,11 @@ namespace GolfEngine
         };
 
         /**
-         * @brief Handle the collision between two entities.
+         * @brief Handle the collisions between entities found during a frame.
+         *
+         * @param collisions Every collision from the frame, in one contiguous buffer. Only valid until the next frame.
          */
-        virtual void onCollision(GolfEngine::Collision &collision) = 0;
+        virtual void onCollision(GolfEngine::CollisionSpan collisions) = 0;
 
         /**
          * @brief End the current scene.
@@ -98,6 +109,7 @@ namespace GolfEngine
          */
         virtual void endScene(bool winStatus) = 0;
 
+#ifndef GOLFENGINE_HEADLESS
         /**
          * @brief Mouse down event. Fires when the player presses down on a mouse button.
          *
@@ -118,6 +130,7 @@ namespace GolfEngine
          * @param event Mouse Move event.
          */
         virtual void onMouseMove(sf::Event::MouseMoveEvent &event) = 0;
+#endif
 
         /**
          * @brief Pause the game.
@@ -131,6 +144,17 @@ namespace GolfEngine
 
         inline bool isPaused() const { return this->paused; }
 
+        /**
+         * @brief Stop, or start again, printing game messages (like new scores, or winning) to standard output.
+         *
+         * The simulation classes quiet every scene they run, since they run many at once. They report outcomes in their results instead.
+         *
+         * @param quiet True to stop printing, false to print again.
+         */
+        inline void setQuiet(bool quiet) { this->quiet = quiet; }
+
+        inline bool isQuiet() const { return this->quiet; }
+
         /**
          * @brief Get the current mouse position.
          *
@@ -152,22 +176,48 @@ namespace GolfEngine
             this->mousePos = pos;
         }
 
-        inline GolfEngine::Entity::EntityList findEntitiesWithTag(const GolfEngine::Tag& tag) const{
+        /**
+         * @brief Find all entities in the scene with a certain tag. See \ref GolfEngine::Tilemap::findEntitiesWithTag.
+         */
+        inline const GolfEngine::Entity::EntityList& findEntitiesWithTag(const GolfEngine::Tag& tag) const{
             return this->tilemap->findEntitiesWithTag(tag);
         }
 
-        inline GolfEngine::Entity::EntityList getAllEntities() const {
+        /**
+         * @brief Get a view over every entity in the scene. See \ref GolfEngine::Tilemap::getAllEntities.
+         */
+        inline GolfEngine::EntityRange getAllEntities() const {
             return this->tilemap->getAllEntities();
         }
 
+        /**
+         * @brief Call a function on every entity in the scene. See \ref GolfEngine::Tilemap::forEachEntity.
+         */
+        template <typename Function>
+        inline void forEachEntity(Function fn) const {
+            this->tilemap->forEachEntity(fn);
+        }
+
+        /**
+         * @brief Call a function on every entity in the scene with a certain tag. See \ref GolfEngine::Tilemap::forEachEntityWithTag.
+         */
+        template <typename Function>
+        inline void forEachEntityWithTag(const GolfEngine::Tag& tag, Function fn) const {
+            this->tilemap->forEachEntityWithTag(tag, fn);
+        }
+
         inline GolfEngine::Tilemap* getTilemap() const {
             return this->tilemap;
         }
 
     private:
         GolfEngine::Tilemap *tilemap;
+        // Everything added to the scene, kept apart from the Tilemap since it drops entities that fall out of the map.
+        std::vector<GolfEngine::Tile *> owned_tiles;
+        GolfEngine::Entity::EntityList owned_entities;
         GolfEngine::Vector2 mousePos;
         bool paused;
+        bool quiet;
     };
 }
 
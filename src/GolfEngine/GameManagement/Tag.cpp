@@ -0,0 +1,61 @@
+/**
+ * @file Tag.cpp
+ * @brief This file contains definitions for the Tag class.
+ *
+ * @date 2023-06-27
+ * @author Willow Ciesialka
+ */
+
+#include "Tag.hpp"
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+using GolfEngine::Tag;
+
+namespace
+{
+    typedef std::unordered_map<Tag::Id, std::string> NameTable;
+
+    std::mutex names_mutex;
+
+    /**
+     * @brief Get the table of interned names, seeded with the built-in tags.
+     */
+    NameTable &names()
+    {
+        static NameTable table = {
+            {GolfEngine::Tags::DEFAULT.getId(), "Default"},
+            {GolfEngine::Tags::GOLFBALL.getId(), "Golfball"},
+            {GolfEngine::Tags::GOAL.getId(), "Goal"},
+            {GolfEngine::Tags::OBSTACLE.getId(), "Obstacle"}};
+        return table;
+    }
+}
+
+Tag::Tag(const std::string &tag_name) : id(Tag::hash(tag_name.c_str()))
+{
+    std::lock_guard<std::mutex> lock(names_mutex);
+    NameTable &table = names();
+    NameTable::iterator existing = table.find(this->id);
+    if (existing == table.end())
+    {
+        table[this->id] = tag_name;
+    }
+    else if (existing->second != tag_name)
+    {
+        throw std::logic_error("Tag \"" + tag_name + "\" has the same hash as tag \"" + existing->second + "\".");
+    }
+}
+
+std::string Tag::getTag() const
+{
+    std::lock_guard<std::mutex> lock(names_mutex);
+    NameTable &table = names();
+    NameTable::const_iterator existing = table.find(this->id);
+    if (existing == table.end())
+    {
+        return "";
+    }
+    return existing->second;
+}
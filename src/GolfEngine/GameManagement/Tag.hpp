@@ -2,6 +2,10 @@
  * @file Tag.hpp
  * @brief This file contains definitions for the Tag class.
  *
+ * Tags are interned: a Tag only holds the 32-bit FNV-1a hash of its name, and the name itself
+ * lives in a shared table. Comparing tags is an integer compare, and tags for string literals
+ * can be built at compile time with \ref GolfEngine::Tag::literal "Tag::literal()".
+ *
  * @date 2023-06-13
  * @author Willow Ciesialka
  */
@@ -11,38 +15,95 @@
 
 #include <string>
 #include <iostream>
+#include <cstdint>
 
 namespace GolfEngine
 {
     class Tag
     {
     public:
-        Tag() : name("Default"){};
-        Tag(const std::string& tag_name) : name(tag_name){};
+        typedef std::uint32_t Id;
+
+        constexpr Tag() : id(Tag::hash("Default")){};
+
+        /**
+         * @param tag_name Name of the tag. It is interned, so that \ref getTag "getTag()" can return it later.
+         * @throws std::logic_error If the name's hash collides with a different, already interned, name.
+         */
+        Tag(const std::string &tag_name);
+        Tag(const char *tag_name) : Tag(std::string(tag_name)){};
+
+        /**
+         * @brief Hash a tag name, at compile time if possible.
+         *
+         * @param name Null terminated name to hash.
+         * @param seed Hash of everything before name. Leave as the default.
+         * @returns The 32-bit FNV-1a hash of the name.
+         */
+        static constexpr Id hash(const char *name, Id seed = 2166136261u)
+        {
+            return (*name == '\0') ? seed : Tag::hash(name + 1, (seed ^ (Id)(unsigned char)(*name)) * 16777619u);
+        }
+
+        /**
+         * @brief Build a tag for a string literal at compile time.
+         *
+         * Unlike the string constructors, this does not intern the name. The built-in tags in
+         * \ref GolfEngine::Tags are always interned; any other name is only known to
+         * \ref getTag "getTag()" once a Tag has been constructed from it at runtime.
+         *
+         * @param name Name of the tag.
+         * @returns The tag.
+         */
+        static constexpr Tag literal(const char *name)
+        {
+            return Tag(Tag::hash(name), 0);
+        }
 
         /**
          * @brief Get the Tag in string format.
-         * 
-         * @returns The name of the tag.
-        */
-        inline std::string getTag() const
+         *
+         * @returns The name of the tag, or an empty string if it was never interned.
+         */
+        std::string getTag() const;
+
+        /**
+         * @brief Get the Tag's interned id.
+         *
+         * @returns The hash of the tag's name.
+         */
+        constexpr Id getId() const
         {
-            return this->name;
+            return this->id;
         }
 
-        inline bool operator ==(const Tag& rhs){
-            return this->getTag().compare(rhs.getTag()) == 0;
+        inline bool operator==(const Tag &rhs) const
+        {
+            return this->id == rhs.id;
         }
 
-        inline bool operator ==(const std::string& str){
-            return this->getTag().compare(str) == 0;
+        inline bool operator==(const std::string &str) const
+        {
+            return this->id == Tag::hash(str.c_str());
         }
 
-        inline bool operator !=(const Tag& rhs){
+        inline bool operator==(const char *str) const
+        {
+            return this->id == Tag::hash(str);
+        }
+
+        inline bool operator!=(const Tag &rhs) const
+        {
             return !(*this == rhs);
         }
 
-        inline bool operator !=(const std::string& str){
+        inline bool operator!=(const std::string &str) const
+        {
+            return !(*this == str);
+        }
+
+        inline bool operator!=(const char *str) const
+        {
             return !(*this == str);
         }
 
@@ -53,8 +114,22 @@ namespace GolfEngine
         };
 
     private:
-        std::string name;
+        Id id;
+
+        // The unused argument keeps this apart from the string constructors.
+        constexpr Tag(Id id, int) : id(id){};
     };
+
+    /**
+     * @brief Tags the engine itself uses.
+     */
+    namespace Tags
+    {
+        constexpr GolfEngine::Tag DEFAULT = GolfEngine::Tag::literal("Default");
+        constexpr GolfEngine::Tag GOLFBALL = GolfEngine::Tag::literal("Golfball");
+        constexpr GolfEngine::Tag GOAL = GolfEngine::Tag::literal("Goal");
+        constexpr GolfEngine::Tag OBSTACLE = GolfEngine::Tag::literal("Obstacle");
+    }
 }
 
 #endif
@@ -8,11 +8,13 @@
 
 #include <iostream>
 #include "Tile.hpp"
+#include "Tilemap.hpp"
 #include "Entities/Entity.hpp"
 #include "../Geometry/Vector2.hpp"
 #include <algorithm>
+#include <cmath>
 #include <vector>
-#include <SFML/Graphics.hpp>
+#include <stdexcept>
 #include "Collision.hpp"
 
 using GolfEngine::Tile;
@@ -22,49 +24,162 @@ inline GolfEngine::Entity::EntityList::iterator Tile::findEntity(GolfEngine::Ent
 }
 
 bool Tile::removeEntity(GolfEngine::Entity* entity){
-    GolfEngine::Entity::EntityList::iterator it = this->findEntity(entity);
-    if(it == this->entities->end()){
-        return false;
+    return this->store->remove(entity);
+}
+
+void Tile::shareGeometry(const GolfEngine::Tile* source){
+    if(source == this) return;
+    if(!(source->getOrigin() == this->getOrigin())){
+        throw std::invalid_argument("Cannot share geometry between tiles at different positions.");
     }
-    this->entities->erase(it);
-    return true;
+    if(this->owns_geometry){
+        delete this->geometry;
+    }
+    this->geometry = source->geometry;
+    this->owns_geometry = false;
 }
 
-GolfEngine::Collision::CollisionList Tile::frameUpdate(double dt_s){
-    GolfEngine::Collision::CollisionList collisions;
-    for(GolfEngine::Entity* ent : *this->entities){
-        //Apply acceleration + velocity
-        ent->applyAcceleration(dt_s);
-        ent->applyVelocity(dt_s);
-
-        // Apply friciton
-        float friction = this->getFriction() * dt_s;
-        ent->setVelocity(ent->getVelocity() * friction);
-
-        // Check collisions
-        for(GolfEngine::Entity* ent_other : *this->entities){
-            if(ent == ent_other) continue;
-            if(ent->getEntityType() == GolfEngine::EntityType::CIRCLE){
-                GolfEngine::CircleEntity* ent_shape = (GolfEngine::CircleEntity*)(ent);
-                if(ent_other->getEntityType() == GolfEngine::EntityType::CIRCLE){
-                    GolfEngine::CircleEntity* other_shape = (GolfEngine::CircleEntity*)(ent_other);
-                    if(ent_shape->getShape()->intersects(*other_shape->getShape())){
-                        GolfEngine::Collision collision(ent, ent_other);
-                        collisions.push_back(collision);
-                    }
-                }
+void Tile::frameUpdate(double dt_s){
+    GolfEngine::EntityStore* store = this->store;
+    GolfEngine::Entity::EntityList& owners = *this->entities;
+    this->stopped.clear();
+
+    //Apply acceleration + velocity, then friciton as a decay rate, so that it
+    // scales with dt instead of (nearly) zeroing velocity every step.
+    double friction = 1.0 - (this->getFriction() * dt_s);
+    if(friction < 0) friction = 0;
+
+    // Remember where everything started, so walls can be swept against the full step's motion.
+    std::size_t count = store->size();
+    bool walls = count > 0 && this->hasReachableWalls();
+    if(walls){
+        this->start_x.assign(store->pos_x.begin(), store->pos_x.end());
+        this->start_y.assign(store->pos_y.begin(), store->pos_y.end());
+    }
+    store->integrate(dt_s, friction);
+    if(walls){
+        this->resolveWallSweeps();
+    }
+
+    // Flag anything that left the tile, so the Tilemap can move it without checking everything.
+    double tile_length = GolfEngine::TileGeometry::TILE_SIZE;
+    GolfEngine::Vector2 origin = this->getOrigin();
+    store->markEscaped(origin.x, origin.y, origin.x + tile_length, origin.y + tile_length);
+
+    const unsigned int* flags = store->flags.data();
+    const unsigned int moving_golfball = GolfEngine::EntityStore::FLAG_GOLFBALL | GolfEngine::EntityStore::FLAG_MOVING;
+
+    // Golfballs rolling into a hole fall out, and go back to where they were hit from.
+    // They're checked as one batch, so the ones near a hole's edge are tested against each polygon hole together.
+    if(this->geometry->hasHoles()){
+        this->hole_x.clear();
+        this->hole_y.clear();
+        this->hole_slot.clear();
+        for(std::size_t i = 0; i < count; i++){
+            if((flags[i] & moving_golfball) != moving_golfball) continue;
+            this->hole_x.push_back(store->pos_x[i] - origin.x);
+            this->hole_y.push_back(store->pos_y[i] - origin.y);
+            this->hole_slot.push_back(i);
+        }
+        this->in_hole.resize(this->hole_slot.size());
+        this->geometry->isInHole(this->hole_x.data(), this->hole_y.data(), this->hole_slot.size(), this->in_hole.data());
+        for(std::size_t k = 0; k < this->hole_slot.size(); k++){
+            if(this->in_hole[k]){
+                owners[this->hole_slot[k]]->respawn();
             }
         }
+    }
 
-        // Checl if player movin
-        if(ent->hasTag("Golfball")){
-            GolfEngine::Golfball* player = (GolfEngine::Golfball*)(ent);
-            if(player->getState() == GolfballStates::MOVING && player->getAcceleration() == GolfEngine::Vector2::zero){
-                player->setState(GolfballStates::STILL);
-                player->setRespawnPosition(player->getPosition());
-                player->addScore();
-            }
+    // Checl if player movin
+    for(std::size_t i = 0; i < count; i++){
+        if((flags[i] & moving_golfball) == moving_golfball && store->acc_x[i] == 0 && store->acc_y[i] == 0){
+            GolfEngine::Golfball* player = (GolfEngine::Golfball*)(owners[i]);
+            player->setState(GolfballStates::STILL);
+            player->setRespawnPosition(player->getPosition());
+            player->addScore();
+            this->stopped.push_back(player);
+        }
+    }
+}
+
+
+bool Tile::hasReachableWalls() const{
+    if(this->tilemap != nullptr) return this->tilemap->hasWalls();
+    return !this->geometry->getLines().empty();
+}
+
+bool Tile::sweepWalls(const GolfEngine::Vector2& center, const GolfEngine::Vector2& motion, double radius, GolfEngine::SweepHit& hit) const{
+    if(this->tilemap == nullptr){
+        // Walls are in the tile's local space. Sweep in it too, rather than moving every wall.
+        return this->geometry->getWallGrid().sweep(center - this->getOrigin(), motion, radius, hit);
+    }
+
+    // Every tile the sweep's bounds overlap, however far the step goes.
+    const double size = GolfEngine::TileGeometry::TILE_SIZE;
+    const double last = this->tilemap->getSideLength() - 1;
+    GolfEngine::Vector2 end = center + motion;
+    double x0 = std::floor((std::min(center.x, end.x) - radius) / size), x1 = std::floor((std::max(center.x, end.x) + radius) / size);
+    double y0 = std::floor((std::min(center.y, end.y) - radius) / size), y1 = std::floor((std::max(center.y, end.y) + radius) / size);
+    // Written so that NaN bounds fail the check too.
+    if(!(x1 >= 0 && y1 >= 0 && x0 <= last && y0 <= last)) return false;
+    unsigned int first_x = (unsigned int)std::max(x0, 0.0), last_x = (unsigned int)std::min(x1, last);
+    unsigned int first_y = (unsigned int)std::max(y0, 0.0), last_y = (unsigned int)std::min(y1, last);
+
+    bool found = false;
+    for(unsigned int y = first_y; y <= last_y; y++){
+        for(unsigned int x = first_x; x <= last_x; x++){
+            const GolfEngine::Tile* tile = this->tilemap->getTile(x, y);
+            if(tile == nullptr) continue;
+            GolfEngine::Vector2 local = center - tile->getOrigin();
+            found = tile->geometry->getWallGrid().sweep(local, motion, radius, hit) || found;
+        }
+    }
+    return found;
+}
+
+bool Tile::bounceOffWalls(const GolfEngine::Vector2& start, double radius, GolfEngine::Vector2& position, GolfEngine::Vector2& velocity, GolfEngine::Vector2& acceleration) const{
+    // Keep bounced balls a hair off of the wall, so the next step doesn't start out touching it.
+    const double skin = 1e-6;
+    GolfEngine::Vector2 center = start;
+    GolfEngine::Vector2 motion = position - center;
+    if(motion.x == 0 && motion.y == 0) return false;
+
+    bool bounced = false;
+    for(unsigned int bounce = 0; bounce <= Tile::MAX_WALL_BOUNCES; bounce++){
+        GolfEngine::SweepHit hit;
+        if(!this->sweepWalls(center, motion, radius, hit)) break;
+        bounced = true;
+        center = center + (motion * hit.time) + (hit.normal * skin);
+        if(bounce == Tile::MAX_WALL_BOUNCES){
+            // Out of bounces (i.e. wedged in a corner). Stop at the wall.
+            motion = GolfEngine::Vector2::zero;
+            break;
         }
+        // Whatever motion is left over carries on, reflected off of the wall.
+        motion = GolfEngine::ContinuousCollision::reflect(motion * (1 - hit.time), hit.normal, GolfEngine::TileGeometry::WALL_RESTITUTION);
+        velocity = GolfEngine::ContinuousCollision::reflect(velocity, hit.normal, GolfEngine::TileGeometry::WALL_RESTITUTION);
+        acceleration = GolfEngine::ContinuousCollision::reflect(acceleration, hit.normal, GolfEngine::TileGeometry::WALL_RESTITUTION);
+    }
+    if(bounced){
+        position = center + motion;
+    }
+    return bounced;
+}
+
+void Tile::resolveWallSweeps(){
+    GolfEngine::EntityStore* store = this->store;
+    for(std::size_t i = 0; i < store->size(); i++){
+        const unsigned int circle = GolfEngine::EntityStore::FLAG_ACTIVE | GolfEngine::EntityStore::FLAG_CIRCLE;
+        if((store->flags[i] & circle) != circle) continue;
+        GolfEngine::Vector2 position(store->pos_x[i], store->pos_y[i]);
+        GolfEngine::Vector2 velocity(store->vel_x[i], store->vel_y[i]);
+        GolfEngine::Vector2 acceleration(store->acc_x[i], store->acc_y[i]);
+        if(!this->bounceOffWalls(GolfEngine::Vector2(this->start_x[i], this->start_y[i]), store->radius[i], position, velocity, acceleration)) continue;
+        store->pos_x[i] = position.x;
+        store->pos_y[i] = position.y;
+        store->vel_x[i] = velocity.x;
+        store->vel_y[i] = velocity.y;
+        store->acc_x[i] = acceleration.x;
+        store->acc_y[i] = acceleration.y;
     }
-    return collisions;
 }
\ No newline at end of file
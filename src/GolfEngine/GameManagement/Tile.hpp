@@ -15,7 +15,8 @@
 #include "../Rendering/Renderable.hpp"
 #include "../Rendering/RenderableVisitor.hpp"
 #include "TileGeometry.hpp"
-#include <SFML/Graphics.hpp>
+#include "EntityStore.hpp"
+#include "../Physics/ContinuousCollision.hpp"
 #include <vector>
 #include <math.h>
 #include <iostream>
@@ -23,25 +24,53 @@
 
 namespace GolfEngine
 {
+    class Tilemap;
+
+    /**
+     * @brief Directions to a Tile's neighbours. North is towards negative y.
+     */
+    enum TileDirection {
+        NORTH,
+        EAST,
+        SOUTH,
+        WEST
+    };
+
     class Tile : public GolfEngine::Renderable
     {
     public:
+        static const unsigned int NEIGHBOUR_COUNT = 4;
+
+        /**
+         * @brief Most wall bounces resolved for a single entity in a single step. Anything past this stops at the wall.
+         */
+        static const unsigned int MAX_WALL_BOUNCES = 4;
+
         Tile() : GolfEngine::Renderable()
         {
-            this->entities = new GolfEngine::Entity::EntityList();
+            this->store = new GolfEngine::EntityStore();
+            this->entities = this->store->getEntities();
             this->geometry = new GolfEngine::TileGeometry(GolfEngine::Vector2::zero);
+            this->owns_geometry = true;
+            this->clearNeighbours();
         }
 
         Tile(const GolfEngine::Vector2 &pos) : GolfEngine::Renderable(pos)
         {
-            this->entities = new GolfEngine::Entity::EntityList();
+            this->store = new GolfEngine::EntityStore();
+            this->entities = this->store->getEntities();
             this->geometry = new GolfEngine::TileGeometry(pos);
+            this->owns_geometry = true;
+            this->clearNeighbours();
         }
 
-        ~Tile()
+        virtual ~Tile()
         {
-            delete this->entities;
-            delete this->geometry;
+            delete this->store;
+            if (this->owns_geometry)
+            {
+                delete this->geometry;
+            }
         }
 
         /**
@@ -66,7 +95,7 @@ namespace GolfEngine
             if(!isEntityWithinBounds(ent)){
                 throw std::out_of_range("Cannot add entity with an origin that is outside of Tile's bounds.");
             }
-            this->entities->push_back(ent);
+            this->store->add(ent);
         };
 
         /**
@@ -98,6 +127,25 @@ namespace GolfEngine
             return this->geometry;
         }
 
+        /**
+         * @brief Use another tile's geometry in place of this tile's own, dropping this tile's.
+         *
+         * Lets many copies of a level hold a single copy of its walls and holes. Geometry is only read
+         * once a tile is initialized, so tiles in different threads may share it.
+         *
+         * @param source Tile to share geometry with. Must be at the same position, and must outlive this tile.
+         * @throws std::invalid_argument If the tiles are at different positions.
+         */
+        void shareGeometry(const GolfEngine::Tile *source);
+
+        /**
+         * @brief Check whether this tile's geometry belongs to another tile. See \ref shareGeometry.
+         */
+        inline bool isSharingGeometry() const
+        {
+            return !this->owns_geometry;
+        }
+
         /**
          * @brief Render the tile
          *
@@ -122,14 +170,139 @@ namespace GolfEngine
             return this->entities;
         }
 
+        /**
+         * @brief Get the store holding the physics state of the Tile's entities.
+         *
+         * @returns Pointer to the Tile's EntityStore.
+         */
+        inline GolfEngine::EntityStore* getEntityStore() const {
+            return this->store;
+        }
+
+        /**
+         * @brief Get the golfballs that came to rest on the Tile during its last update.
+         *
+         * Their scores have already been counted. Nothing is printed here, since tiles may be updated on worker threads.
+         *
+         * @returns The golfballs, in the order the tile found them.
+         */
+        inline const GolfEngine::Entity::EntityList& getStoppedGolfballs() const {
+            return this->stopped;
+        }
+
         virtual float getFriction() = 0;
 
-        // note this returns a list of collisions that happen in the frame :)
-        GolfEngine::Collision::CollisionList frameUpdate(double dt_s);
+        /**
+         * @brief Move a circle through a step's motion, bouncing it off of any walls in its way.
+         *
+         * Walls of every tile in the Tilemap that the sweep's bounds overlap are checked, so fast circles can't
+         * skip over a diagonal or farther tile. This is what the tile does for each of its own circles after
+         * integrating them.
+         *
+         * @param start Where the circle started the step, in world space.
+         * @param radius Radius of the circle.
+         * @param position Where integration left the circle. Updated to where it ends up if it bounced.
+         * @param velocity The circle's velocity. Reflected along with the motion.
+         * @param acceleration The circle's acceleration. Reflected along with the motion.
+         * @returns True if the circle hit a wall, false if everything was left untouched.
+         */
+        bool bounceOffWalls(const GolfEngine::Vector2& start, double radius, GolfEngine::Vector2& position, GolfEngine::Vector2& velocity, GolfEngine::Vector2& acceleration) const;
+
+        /**
+         * @brief Get the Tile bordering this one in a direction.
+         *
+         * Links are set up by the \ref GolfEngine::Tilemap "Tilemap" when tiles are added to it.
+         *
+         * @param direction Direction to look in.
+         * @returns The neighbouring Tile, or nullptr if there is none.
+         */
+        inline GolfEngine::Tile *getNeighbour(GolfEngine::TileDirection direction) const
+        {
+            return this->neighbours[direction];
+        }
+
+        /**
+         * @brief Get the Tile's index in its Tilemap, in row order.
+         *
+         * @returns The Tile's index. Only meaningful once the Tile has been added to a Tilemap.
+         */
+        inline unsigned int getMapIndex() const
+        {
+            return this->map_index;
+        }
+
+        /**
+         * @brief Integrate the Tile's entities and update golfball states.
+         *
+         * Circles are swept against the walls of every tile their step passes over, so fast moving
+         * balls bounce off of walls instead of passing through them. Moving golfballs that end the step
+         * in one of the tile's holes are \ref GolfEngine::Entity::respawn "respawned", which stops them.
+         *
+         * Collisions between entities are not checked here, since entities can collide across tile boundaries.
+         * The \ref GolfEngine::Tilemap "Tilemap" checks them scene-wide instead.
+         *
+         * @param dt_s Time, in seconds, to factor in.
+         */
+        void frameUpdate(double dt_s);
 
     private:
+        GolfEngine::EntityStore *store;
         GolfEngine::Entity::EntityList *entities;
         GolfEngine::TileGeometry *geometry;
+        bool owns_geometry;
+        GolfEngine::Tile *neighbours[Tile::NEIGHBOUR_COUNT];
+        unsigned int map_index;
+
+        // Tilemap the Tile was added to, or nullptr if it is on its own.
+        const GolfEngine::Tilemap *tilemap;
+
+        // Positions before integration, kept between frames to avoid reallocating them.
+        std::vector<GolfEngine::Scalar> start_x;
+        std::vector<GolfEngine::Scalar> start_y;
+
+        // Local positions of moving golfballs and their slots, gathered for one batched hole check.
+        std::vector<GolfEngine::Scalar> hole_x;
+        std::vector<GolfEngine::Scalar> hole_y;
+        std::vector<std::size_t> hole_slot;
+        std::vector<unsigned char> in_hole;
+
+        // Golfballs that stopped during the last update.
+        GolfEngine::Entity::EntityList stopped;
+
+        friend class GolfEngine::Tilemap;
+
+        /**
+         * @brief Check whether any tile this tile's circles could reach has walls.
+         */
+        bool hasReachableWalls() const;
+
+        /**
+         * @brief Sweep a circle against the walls of every tile its bounds overlap.
+         *
+         * Tiles that aren't on a Tilemap only check their own walls.
+         *
+         * @param center Center of the circle, in world space.
+         * @param motion Displacement of the circle.
+         * @param radius Radius of the circle.
+         * @param hit Filled in with the earliest impact.
+         * @returns True if the circle hits a wall, false otherwise.
+         */
+        bool sweepWalls(const GolfEngine::Vector2 &center, const GolfEngine::Vector2 &motion, double radius, GolfEngine::SweepHit &hit) const;
+
+        /**
+         * @brief Bounce every circle that hit a wall during integration off of it.
+         */
+        void resolveWallSweeps();
+
+        inline void clearNeighbours()
+        {
+            for (unsigned int i = 0; i < Tile::NEIGHBOUR_COUNT; i++)
+            {
+                this->neighbours[i] = nullptr;
+            }
+            this->map_index = 0;
+            this->tilemap = nullptr;
+        }
 
         /**
          * @brief Find the entity in the Tile, if it exists.
@@ -10,6 +10,72 @@
 
 using GolfEngine::TileGeometry;
 
+// Points are handed to the polygon kernel in batches of this size, so no scratch space needs allocating.
+static const std::size_t QUERY_BATCH_SIZE = 64;
+
+void TileGeometry::updateWalls()
+{
+    this->wall_grid.build(*this->line_geometry);
+}
+
+void TileGeometry::isInHole(const GolfEngine::Scalar *x, const GolfEngine::Scalar *y, std::size_t count, unsigned char *in_hole) const
+{
+    GolfEngine::Scalar edge_x[QUERY_BATCH_SIZE];
+    GolfEngine::Scalar edge_y[QUERY_BATCH_SIZE];
+    std::size_t edge_index[QUERY_BATCH_SIZE];
+    std::size_t pending = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        GolfEngine::HoleCoverage coverage = this->hole_mask.lookup(GolfEngine::Vector2(x[i], y[i]));
+        in_hole[i] = (coverage == GolfEngine::HoleCoverage::FULL);
+        if (coverage != GolfEngine::HoleCoverage::PARTIAL)
+        {
+            continue;
+        }
+        // Near a hole's edge. Save it for an exact test.
+        edge_x[pending] = x[i];
+        edge_y[pending] = y[i];
+        edge_index[pending] = i;
+        pending++;
+        if (pending == QUERY_BATCH_SIZE)
+        {
+            this->resolveHoleBatch(edge_x, edge_y, edge_index, pending, in_hole);
+            pending = 0;
+        }
+    }
+    this->resolveHoleBatch(edge_x, edge_y, edge_index, pending, in_hole);
+}
+
+void TileGeometry::resolveHoleBatch(const GolfEngine::Scalar *x, const GolfEngine::Scalar *y, const std::size_t *index, std::size_t count, unsigned char *in_hole) const
+{
+    if (count == 0)
+    {
+        return;
+    }
+    for (const GolfEngine::Circle &circle : *this->circle_geometry)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            in_hole[index[i]] |= circle.contains(GolfEngine::Vector2(x[i], y[i]));
+        }
+    }
+    unsigned char inside[QUERY_BATCH_SIZE];
+    for (const GolfEngine::Polygon &poly : *this->polygon_geometry)
+    {
+        poly.contains(x, y, count, inside);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            in_hole[index[i]] |= inside[i];
+        }
+    }
+}
+
+#ifdef GOLFENGINE_HEADLESS
+void TileGeometry::render(sf::RenderWindow *)
+{
+    /* Headless builds have nothing to draw onto. */
+}
+#else
 void TileGeometry::render(sf::RenderWindow *window)
 {
     // First, render base layer
@@ -28,15 +94,16 @@ void TileGeometry::render(sf::RenderWindow *window)
 
         sf::Vertex render_line[2];
 
-        render_line[1] = sf::Vertex(sf::Vector2f(render_a.x, render_a.y));
+        render_line[0] = sf::Vertex(sf::Vector2f(render_a.x, render_a.y));
+        render_line[0].color = sf::Color(TileGeometry::WALL_COLOR);
+        render_line[1] = sf::Vertex(sf::Vector2f(render_b.x, render_b.y));
         render_line[1].color = sf::Color(TileGeometry::WALL_COLOR);
-        render_line[2] = sf::Vertex(sf::Vector2f(render_b.x, render_b.y));
-        render_line[2].color = sf::Color(TileGeometry::WALL_COLOR);
 
         window->draw(render_line, 2, sf::Lines);
     }
     // Visitor will take care of the rest!
 }
+#endif
 
 void TileGeometry::visit(GolfEngine::RenderableVisitor* visitor){
     // First, render ourselves.
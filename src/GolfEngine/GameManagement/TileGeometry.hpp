@@ -18,6 +18,8 @@
 #include "../Geometry/Line.hpp"
 #include "../Geometry/Shapes/Polygon.hpp"
 #include "../Geometry/Shapes/Circle.hpp"
+#include "../Physics/WallGrid.hpp"
+#include "../Physics/HoleMask.hpp"
 #include <vector>
 #include <stdexcept>
 #include "../Rendering/Renderable.hpp"
@@ -35,7 +37,12 @@ namespace GolfEngine
         static const int WALL_COLOR = 0xC0C2C9ff;
         static const int HOLE_COLOR = 0x000000ff;
 
-        TileGeometry(GolfEngine::Vector2 origin) : GolfEngine::Renderable(origin)
+        /**
+         * @brief Fraction of a ball's speed into a wall that it keeps when bouncing off of it.
+         */
+        static constexpr double WALL_RESTITUTION = 0.8;
+
+        TileGeometry(GolfEngine::Vector2 origin) : GolfEngine::Renderable(origin), wall_grid(TileGeometry::TILE_SIZE, GolfEngine::WallGrid::DEFAULT_CELLS_PER_SIDE), hole_mask(TileGeometry::TILE_SIZE, GolfEngine::HoleMask::DEFAULT_CELLS_PER_SIDE)
         {
             this->line_geometry = new GolfEngine::Line::LineList();
             this->circle_geometry = new GolfEngine::Circle::CircleList();
@@ -93,9 +100,10 @@ namespace GolfEngine
          */
         inline bool isPolygonValid(const GolfEngine::Polygon &poly) const
         {
-            for (uint i = 0; i < poly.getVertexCount(); i++)
+            // Holes are placed by their origin, so it is the world vertices that have to fit in the tile.
+            for (const GolfEngine::Vector2 &point : poly.getWorldVertices())
             {
-                bool pointValidity = this->isPointValid(poly.getPoint(i));
+                bool pointValidity = this->isPointValid(point);
                 if (!pointValidity)
                 {
                     return false;
@@ -108,6 +116,7 @@ namespace GolfEngine
          * @brief Add a line to the tile geometry.
          *
          * Lines define walls, which golfballs will bounce off of.
+         * The wall grid is rebuilt on every call, so prefer \ref addLines when adding many walls at once.
          *
          * @param line Line to add.
          * @throws std::out_of_range If the Line falls outside of tile bounds.
@@ -119,6 +128,26 @@ namespace GolfEngine
                 throw std::out_of_range("Line falls outside of map geometry.");
             }
             this->line_geometry->push_back(line);
+            this->updateWalls();
+        }
+
+        /**
+         * @brief Add several lines to the tile geometry, building the wall grid once.
+         *
+         * @param lines Lines to add.
+         * @throws std::out_of_range If any Line falls outside of tile bounds. No lines are added if so.
+         */
+        inline void addLines(const GolfEngine::Line::LineList& lines)
+        {
+            for (const GolfEngine::Line &line : lines)
+            {
+                if (!this->isLineValid(line))
+                {
+                    throw std::out_of_range("Line falls outside of map geometry.");
+                }
+            }
+            this->line_geometry->insert(this->line_geometry->end(), lines.begin(), lines.end());
+            this->updateWalls();
         }
 
         /**
@@ -136,6 +165,7 @@ namespace GolfEngine
                 throw std::out_of_range("Circle falls outside of map geometry.");
             }
             this->circle_geometry->push_back(circle);
+            this->hole_mask.build(*this->circle_geometry, *this->polygon_geometry);
         }
 
         /**
@@ -153,6 +183,7 @@ namespace GolfEngine
                 throw std::out_of_range("Polygon falls outside of map geometry.");
             }
             this->polygon_geometry->push_back(poly);
+            this->hole_mask.build(*this->circle_geometry, *this->polygon_geometry);
         }
 
         /**
@@ -161,9 +192,9 @@ namespace GolfEngine
          * @param shape Shape to check.
          * @returns True if the shape is in a wall collision, false otherwise.
          */
-        inline bool checkWallCollisions(const GolfEngine::Shape &shape)
+        inline bool checkWallCollisions(const GolfEngine::Shape &shape) const
         {
-            for (GolfEngine::Line &line : *this->line_geometry)
+            for (const GolfEngine::Line &line : *this->line_geometry)
             {
                 if (shape.intersects(line))
                 {
@@ -173,6 +204,36 @@ namespace GolfEngine
             return false;
         }
 
+        /**
+         * @brief Get the walls in the tile.
+         *
+         * @returns The wall lines, in local space.
+         */
+        inline const GolfEngine::Line::LineList &getLines() const
+        {
+            return *this->line_geometry;
+        }
+
+        /**
+         * @brief Get the grid the walls are binned into, for sweeping against them.
+         *
+         * @returns The wall grid, in local space.
+         */
+        inline const GolfEngine::WallGrid &getWallGrid() const
+        {
+            return this->wall_grid;
+        }
+
+        /**
+         * @brief Check whether the tile has any holes.
+         *
+         * @returns True if the tile has at least one circle or polygon hole, false otherwise.
+         */
+        inline bool hasHoles() const
+        {
+            return !this->circle_geometry->empty() || !this->polygon_geometry->empty();
+        }
+
         /**
          * @brief Check hole collisions on a shape.
          * 
@@ -180,10 +241,75 @@ namespace GolfEngine
          * @returns True if shape is in a hole collision, false otherwise.
          * @note A hole collision is NOT the same as an intersection - the shape's centroid MUST be contained by a hole to count.
         */
-        inline bool checkHoleCollisions(const GolfEngine::Shape &shape) {
-            GolfEngine::Vector2 point = shape.getCentroid();
+        inline bool checkHoleCollisions(const GolfEngine::Shape &shape) const {
+            return this->isInHole(shape.getCentroid());
+        }
+
+        /**
+         * @brief Check if a point is in a hole.
+         *
+         * Most points are answered by the hole mask alone. Only points near a hole's edge are tested against the holes themselves.
+         *
+         * @param point Point to check, in local space.
+         * @returns True if the point is in a hole, false otherwise.
+         */
+        inline bool isInHole(const GolfEngine::Vector2 &point) const {
+            switch(this->hole_mask.lookup(point)){
+                case GolfEngine::HoleCoverage::EMPTY:
+                    return false;
+                case GolfEngine::HoleCoverage::FULL:
+                    return true;
+                default:
+                    return this->isInHoleExact(point);
+            }
+        }
+
+        /**
+         * @brief Check which of a batch of points are in a hole.
+         *
+         * Gives the same answers as calling \ref isInHole(const GolfEngine::Vector2&) const "isInHole" on each point.
+         * Points the hole mask can't answer are gathered up and tested against each polygon hole as a batch.
+         *
+         * @param x X coordinates of the points, in local space.
+         * @param y Y coordinates of the points, in local space.
+         * @param count Amount of points.
+         * @param in_hole Set to 1 for every point in a hole, 0 otherwise. Must hold count elements.
+         */
+        void isInHole(const GolfEngine::Scalar *x, const GolfEngine::Scalar *y, std::size_t count, unsigned char *in_hole) const;
+
+        void render(sf::RenderWindow* window);
+
+        void visit(GolfEngine::RenderableVisitor* visitor);
+
+    private:
+        GolfEngine::Line::LineList* line_geometry;
+        GolfEngine::Circle::CircleList* circle_geometry;
+        GolfEngine::Polygon::PolygonList* polygon_geometry;
+        GolfEngine::WallGrid wall_grid;
+        GolfEngine::HoleMask hole_mask;
+
+        /**
+         * @brief Rebuild everything derived from the walls, after they change.
+         */
+        void updateWalls();
+
+        /**
+         * @brief Test gathered points against every hole, marking the ones inside of one.
+         *
+         * @param x X coordinates of the points.
+         * @param y Y coordinates of the points.
+         * @param index Index, in in_hole, of each point.
+         * @param count Amount of points gathered.
+         * @param in_hole Output of \ref isInHole(const GolfEngine::Scalar*, const GolfEngine::Scalar*, std::size_t, unsigned char*) const "isInHole".
+         */
+        void resolveHoleBatch(const GolfEngine::Scalar *x, const GolfEngine::Scalar *y, const std::size_t *index, std::size_t count, unsigned char *in_hole) const;
+
+        /**
+         * @brief Check if a point is in a hole by testing it against every hole.
+         */
+        inline bool isInHoleExact(const GolfEngine::Vector2 &point) const {
             // First, check circles.
-            for (GolfEngine::Circle &circle : *this->circle_geometry)
+            for (const GolfEngine::Circle &circle : *this->circle_geometry)
             {
                 if (circle.contains(point))
                 {
@@ -191,22 +317,13 @@ namespace GolfEngine
                 }
             }
             // Then, check polygons.
-            for (GolfEngine::Polygon &poly : *this->polygon_geometry){
+            for (const GolfEngine::Polygon &poly : *this->polygon_geometry){
                 if(poly.contains(point)){
                     return true;
                 }
             }
             return false;
         }
-
-        void render(sf::RenderWindow* window);
-
-        void visit(GolfEngine::RenderableVisitor* visitor);
-
-    private:
-        GolfEngine::Line::LineList* line_geometry;
-        GolfEngine::Circle::CircleList* circle_geometry;
-        GolfEngine::Polygon::PolygonList* polygon_geometry;
     };
 }
 
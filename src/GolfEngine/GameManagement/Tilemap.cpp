@@ -7,74 +7,340 @@
  */
 
 #include "Tilemap.hpp"
+#include "../Geometry/Shapes/Circle.hpp"
+#include "Entities/PolygonEntity.hpp"
+#include "../Simulation/WorkStealingPool.hpp"
+#include <algorithm>
+#include <new>
 using GolfEngine::Tilemap;
 
-GolfEngine::Tile *Tilemap::findTile(GolfEngine::Vector2 pos) const
+Tilemap::~Tilemap()
 {
-    int i = this->getTileIndex(pos);
+    for (GolfEngine::Tile *tile : this->tiles)
+    {
+        tile->getEntityStore()->setDirtyList(nullptr);
+        tile->getEntityStore()->setTagIndex(nullptr);
+        tile->tilemap = nullptr;
+    }
+    delete this->worker_pool;
+    delete this->broadphase;
+}
 
-    auto result = this->tiles.find(i);
-    // If the tile doesn't exist, return nullptr.
-    if (result == this->tiles.end())
+void Tilemap::initializeSlots()
+{
+    unsigned long slot_count = (unsigned long)this->side_length * this->side_length;
+    if (slot_count <= Tilemap::MAX_DENSE_TILES)
     {
-        return nullptr;
+        this->chunks_per_side = 0;
+        this->slots.assign(slot_count, nullptr);
     }
     else
     {
-        return result->second;
+        this->chunks_per_side = (this->side_length + Tilemap::CHUNK_SIDE_LENGTH - 1) / Tilemap::CHUNK_SIDE_LENGTH;
+        this->chunks.resize(this->chunks_per_side * this->chunks_per_side);
     }
 }
 
-bool Tilemap::addTile(GolfEngine::Tile *tile)
+GolfEngine::Tile *&Tilemap::slotAt(unsigned int x, unsigned int y)
 {
-    if (this->findTile(tile->getOrigin()))
+    if (this->chunks_per_side == 0)
     {
-        return false;
+        return this->slots[x + (y * this->side_length)];
     }
-    int i = this->getTileIndex(tile->getOrigin());
-    this->tiles[i] = tile;
-    return true;
+    std::vector<GolfEngine::Tile *> &chunk = this->chunks[(x / Tilemap::CHUNK_SIDE_LENGTH) + ((y / Tilemap::CHUNK_SIDE_LENGTH) * this->chunks_per_side)];
+    if (chunk.empty())
+    {
+        chunk.assign(Tilemap::CHUNK_SIDE_LENGTH * Tilemap::CHUNK_SIDE_LENGTH, nullptr);
+    }
+    return chunk[(x % Tilemap::CHUNK_SIDE_LENGTH) + ((y % Tilemap::CHUNK_SIDE_LENGTH) * Tilemap::CHUNK_SIDE_LENGTH)];
 }
 
-GolfEngine::Entity::EntityList Tilemap::findEntitiesWithTag(const GolfEngine::Tag &tag) const
+bool Tilemap::addTile(GolfEngine::Tile *tile)
 {
-    GolfEngine::Entity::EntityList tagged_entities;
-    for (GolfEngine::Entity *entity : this->getAllEntities())
+    int index = this->getTileIndex(tile->getOrigin());
+    if (index < 0 || this->findTile(tile->getOrigin()))
     {
-        if (entity->hasTag(tag))
-        {
-            tagged_entities.push_back(entity);
-        }
+        return false;
     }
-    return tagged_entities;
+    unsigned int i = index;
+    unsigned int x = i % this->side_length;
+    unsigned int y = i / this->side_length;
+    // Tile geometry (and the wall grid built from it) is only set up once, when the tile is placed.
+    tile->initialize();
+    this->slotAt(x, y) = tile;
+    tile->map_index = i;
+    tile->tilemap = this;
+    tile->getEntityStore()->setDirtyList(&this->dirty);
+    tile->getEntityStore()->setTagIndex(&this->tag_index);
+    for (GolfEngine::Entity *entity : *tile->getEntities())
+    {
+        this->tag_index.insert(entity);
+    }
+
+    auto position = std::lower_bound(this->tiles.begin(), this->tiles.end(), tile, [](const GolfEngine::Tile *lhs, const GolfEngine::Tile *rhs)
+                                     { return lhs->getMapIndex() < rhs->getMapIndex(); });
+    this->tiles.insert(position, tile);
+
+    // Link the tile up with its neighbours, both ways.
+    GolfEngine::Tile *north = (y > 0) ? this->getTile(x, y - 1) : nullptr;
+    GolfEngine::Tile *east = this->getTile(x + 1, y);
+    GolfEngine::Tile *south = this->getTile(x, y + 1);
+    GolfEngine::Tile *west = (x > 0) ? this->getTile(x - 1, y) : nullptr;
+    tile->neighbours[GolfEngine::TileDirection::NORTH] = north;
+    tile->neighbours[GolfEngine::TileDirection::EAST] = east;
+    tile->neighbours[GolfEngine::TileDirection::SOUTH] = south;
+    tile->neighbours[GolfEngine::TileDirection::WEST] = west;
+    if (north)
+        north->neighbours[GolfEngine::TileDirection::SOUTH] = tile;
+    if (east)
+        east->neighbours[GolfEngine::TileDirection::WEST] = tile;
+    if (south)
+        south->neighbours[GolfEngine::TileDirection::NORTH] = tile;
+    if (west)
+        west->neighbours[GolfEngine::TileDirection::EAST] = tile;
+    return true;
 }
 
 void Tilemap::reorderEntities()
 {
-    for (auto pair : this->tiles)
+    // Respawning sets an entity's position, which puts it back on the dirty list, so keep going until it settles.
+    while (!this->dirty.empty())
     {
-        GolfEngine::Tile *tile = pair.second;
-        GolfEngine::Entity::EntityList *entities = tile->getEntities();
-        GolfEngine::Entity::EntityList copy;
-        copy.assign(entities->begin(), entities->end());
-        for (GolfEngine::Entity *entity : copy)
+        this->pending.swap(this->dirty);
+        for (GolfEngine::Entity *entity : this->pending)
         {
-            if (!tile->isEntityWithinBounds(entity))
+            // Stores take entities off the dirty list when removing them, so everything here is still attached.
+            GolfEngine::EntityStore *from = entity->getEntityStore();
+            from->clearDirty(entity);
+            GolfEngine::Tile *new_tile = this->findTile(entity->getPosition());
+            if (new_tile == nullptr)
             {
-                GolfEngine::Tile *new_tile;
-                try
+                // Out of bounds or in the void. Respawn, unless that would just land it back in the void.
+                if (this->findTile(entity->getRespawnPosition()) == nullptr)
                 {
-                    new_tile = this->findTile(entity->getOrigin());
+                    from->remove(entity);
                 }
-                catch (std::out_of_range& ex)
+                else
                 {
-                    // if oob, respawn
                     entity->respawn();
-                    continue;
                 }
-                tile->removeEntity(entity);
+                continue;
+            }
+            if (new_tile->getEntityStore() != from)
+            {
+                from->remove(entity);
                 new_tile->addEntity(entity);
             }
         }
+        this->pending.clear();
+    }
+}
+
+GolfEngine::CollisionSpan Tilemap::frameUpdate(double dt_s)
+{
+    this->frame_arena.reset();
+    this->has_walls = false;
+    for (GolfEngine::Tile *tile : this->tiles)
+    {
+        if (!tile->getTileGeometry()->getLines().empty())
+        {
+            this->has_walls = true;
+            break;
+        }
     }
-}
\ No newline at end of file
+    if (this->worker_pool != nullptr && this->tiles.size() > 1)
+    {
+        this->updateTilesInParallel(dt_s);
+    }
+    else
+    {
+        for (GolfEngine::Tile *tile : this->tiles)
+        {
+            this->updateTile(tile, dt_s);
+        }
+    }
+    this->stopped.clear();
+    for (GolfEngine::Tile *tile : this->tiles)
+    {
+        const GolfEngine::Entity::EntityList &stopped = tile->getStoppedGolfballs();
+        this->stopped.insert(this->stopped.end(), stopped.begin(), stopped.end());
+    }
+    return this->detectCollisions();
+}
+
+void Tilemap::updateTile(GolfEngine::Tile *tile, double dt_s)
+{
+    tile->frameUpdate(dt_s);
+    if (this->deterministic)
+    {
+        // Tiles don't read each other's entities, so rounding each one right after its update is the same as rounding them all afterwards.
+        tile->getEntityStore()->quantize((double)(1ULL << Tilemap::FIXED_POINT_BITS));
+    }
+}
+
+void Tilemap::updateTilesInParallel(double dt_s)
+{
+    // Split the tiles into contiguous ranges with about as many entities each. Every tile counts as one more, for its own overhead.
+    std::size_t total = 0;
+    for (GolfEngine::Tile *tile : this->tiles)
+    {
+        total += tile->getEntityStore()->size() + 1;
+    }
+    std::size_t range_count = std::min(this->tiles.size(), (std::size_t)this->worker_pool->size() * Tilemap::RANGES_PER_WORKER);
+    this->range_starts.clear();
+    std::size_t seen = 0;
+    for (std::size_t t = 0; t < this->tiles.size(); t++)
+    {
+        if (seen * range_count >= this->range_starts.size() * total)
+        {
+            this->range_starts.push_back(t);
+        }
+        seen += this->tiles[t]->getEntityStore()->size() + 1;
+    }
+    this->range_starts.push_back(this->tiles.size());
+    if (this->escapes.size() < this->range_starts.size() - 1)
+    {
+        this->escapes.resize(this->range_starts.size() - 1);
+    }
+
+    for (std::size_t r = 0; r + 1 < this->range_starts.size(); r++)
+    {
+        this->worker_pool->submit([this, r, dt_s](unsigned int)
+                                  {
+            // Entities leaving these tiles go on the range's own list, not the shared one.
+            GolfEngine::Entity::EntityList *escaped = &this->escapes[r];
+            for (std::size_t t = this->range_starts[r]; t < this->range_starts[r + 1]; t++)
+            {
+                GolfEngine::EntityStore *store = this->tiles[t]->getEntityStore();
+                store->setDirtyList(escaped);
+                this->updateTile(this->tiles[t], dt_s);
+                store->setDirtyList(&this->dirty);
+            } });
+    }
+    this->worker_pool->wait();
+
+    // Ranges are in tile order, so this is the order a serial update would have found them in.
+    for (std::size_t r = 0; r + 1 < this->range_starts.size(); r++)
+    {
+        GolfEngine::EntityStore::appendDirty(this->dirty, this->escapes[r]);
+    }
+}
+
+void Tilemap::setWorkerCount(unsigned int worker_count)
+{
+    if (worker_count <= 1)
+    {
+        delete this->worker_pool;
+        this->worker_pool = nullptr;
+        return;
+    }
+    if (this->worker_pool != nullptr && this->worker_pool->size() == worker_count)
+    {
+        return;
+    }
+    delete this->worker_pool;
+    this->worker_pool = new GolfEngine::WorkStealingPool(worker_count);
+}
+
+unsigned int Tilemap::getWorkerCount() const
+{
+    return this->worker_pool == nullptr ? 1 : this->worker_pool->size();
+}
+
+void Tilemap::shareGeometry(const GolfEngine::Tilemap &source)
+{
+    const std::vector<GolfEngine::Tile *> &shared = source.getTiles();
+    if (this->tiles.size() != shared.size())
+    {
+        throw std::logic_error("Every copy of a level must have the same tiles.");
+    }
+    for (std::size_t t = 0; t < this->tiles.size(); t++)
+    {
+        if (this->tiles[t]->getMapIndex() != shared[t]->getMapIndex())
+        {
+            throw std::logic_error("Every copy of a level must have the same tiles.");
+        }
+        this->tiles[t]->shareGeometry(shared[t]);
+    }
+}
+
+std::uint64_t Tilemap::hashState() const
+{
+    const double scale = (double)(1ULL << Tilemap::FIXED_POINT_BITS);
+    std::uint64_t hash = 0xCBF29CE484222325ULL;
+    for (GolfEngine::Tile *tile : this->tiles)
+    {
+        hash = tile->getEntityStore()->hashState(hash, scale);
+    }
+    return hash;
+}
+
+GolfEngine::CollisionSpan Tilemap::detectCollisions()
+{
+    const unsigned int collidable = GolfEngine::EntityStore::FLAG_CIRCLE | GolfEngine::EntityStore::FLAG_POLYGON;
+    this->bodies.clear();
+    this->contact_bodies.clear();
+    this->bounds.clear();
+    this->pairs.clear();
+
+    // Gather bounds straight from each tile's store, so entities in neighbouring tiles are checked against each other.
+    for (GolfEngine::Tile *tile : this->tiles)
+    {
+        GolfEngine::EntityStore *store = tile->getEntityStore();
+        GolfEngine::Entity::EntityList &owners = *store->getEntities();
+        for (std::size_t i = 0; i < store->size(); i++)
+        {
+            unsigned int flags = store->flags[i];
+            if (!(flags & GolfEngine::EntityStore::FLAG_ACTIVE) || !(flags & collidable))
+            {
+                continue;
+            }
+            double r = store->radius[i];
+            GolfEngine::ContactBody body;
+            body.owner = owners[i];
+            body.position = GolfEngine::Vector2(store->pos_x[i], store->pos_y[i]);
+            body.radius = r;
+            if (flags & GolfEngine::EntityStore::FLAG_POLYGON)
+            {
+                // World vertices are found once per body here, rather than once per pair it is in.
+                GolfEngine::Polygon *shape = ((GolfEngine::PolygonEntity *)owners[i])->getShape();
+                shape->setOrigin(body.position);
+                const std::vector<GolfEngine::Vector2> &vertices = shape->getWorldVertices();
+                body.kind = GolfEngine::ShapeKind::POLYGON_SHAPE;
+                body.vertices = vertices.data();
+                body.vertex_count = vertices.size();
+            }
+            this->bodies.push_back(owners[i]);
+            this->contact_bodies.push_back(body);
+            this->bounds.push_back(GolfEngine::AABB(store->pos_x[i] - r, store->pos_y[i] - r, store->pos_x[i] + r, store->pos_y[i] + r));
+        }
+    }
+
+    this->broadphase->findPairs(this->bounds, this->pairs);
+    // Strategies report pairs in different orders. Sort them so collisions are handled the same way regardless.
+    std::sort(this->pairs.begin(), this->pairs.end(), [](const GolfEngine::CandidatePair &lhs, const GolfEngine::CandidatePair &rhs)
+              { return lhs.a < rhs.a || (lhs.a == rhs.a && lhs.b < rhs.b); });
+
+    // Keep only the pairs that pass the narrowphase, so the collisions can be allocated in one go.
+    std::size_t hits = 0;
+    this->contacts.resize(this->pairs.size());
+    for (const GolfEngine::CandidatePair &pair : this->pairs)
+    {
+        if (GolfEngine::CollisionDispatch::findContact(this->contact_bodies[pair.a], this->contact_bodies[pair.b], this->axis_cache, this->contacts[hits]))
+        {
+            this->pairs[hits++] = pair;
+        }
+    }
+    this->axis_cache.prune();
+
+    GolfEngine::Collision *collisions = this->frame_arena.allocate<GolfEngine::Collision>(hits * 2);
+    for (std::size_t i = 0; i < hits; i++)
+    {
+        GolfEngine::Entity *a = this->bodies[this->pairs[i].a];
+        GolfEngine::Entity *b = this->bodies[this->pairs[i].b];
+        const GolfEngine::Contact &contact = this->contacts[i];
+        new (&collisions[2 * i]) GolfEngine::Collision(a, b, contact.normal, contact.depth);
+        new (&collisions[(2 * i) + 1]) GolfEngine::Collision(b, a, contact.normal * -1, contact.depth);
+    }
+    return GolfEngine::CollisionSpan(collisions, hits * 2);
+}
@@ -11,18 +11,62 @@
 
 #include "../Rendering/Renderable.hpp"
 #include "Tile.hpp"
+#include "Collision.hpp"
+#include "EntityIndex.hpp"
+#include "EntityRange.hpp"
+#include "FrameArena.hpp"
+#include "../Physics/Broadphase.hpp"
+#include "../Physics/Narrowphase.hpp"
+#include "CollisionDispatch.hpp"
+#include <vector>
+#include <cstdint>
 #include <unordered_map>
+#include <utility>
+#include <functional>
 #include <stdexcept>
 #include <iostream>
 
 namespace GolfEngine
 {
+    class WorkStealingPool;
+
     class Tilemap
     {
     public:
         static const unsigned int DEFAULT_SIDE_LENGTH = 64;
-        Tilemap() : side_length(Tilemap::DEFAULT_SIDE_LENGTH) {}
-        Tilemap(unsigned int side_length) : side_length(side_length) {}
+        static const GolfEngine::BroadphaseStrategy DEFAULT_BROADPHASE = GolfEngine::BroadphaseStrategy::UNIFORM_GRID;
+
+        /**
+         * @brief Maps with at most this many tile slots keep them in a single flat array.
+         * Larger maps split the slots into chunks, which are only allocated once a tile is placed in them.
+         */
+        static const unsigned int MAX_DENSE_TILES = 512 * 512;
+
+        /**
+         * @brief Side length, in tiles, of a chunk in a chunked map.
+         */
+        static const unsigned int CHUNK_SIDE_LENGTH = 16;
+
+        /**
+         * @brief Fractional bits of the fixed-point lattice state is rounded to in deterministic mode.
+         */
+        static const unsigned int FIXED_POINT_BITS = 16;
+
+        /**
+         * @brief Amount of ranges of tiles handed to each worker per update, when updating tiles in parallel.
+         */
+        static const unsigned int RANGES_PER_WORKER = 4;
+
+        Tilemap() : side_length(Tilemap::DEFAULT_SIDE_LENGTH), deterministic(false), has_walls(false), broadphase(GolfEngine::Broadphase::create(Tilemap::DEFAULT_BROADPHASE)), worker_pool(nullptr)
+        {
+            this->initializeSlots();
+        }
+        Tilemap(unsigned int side_length) : side_length(side_length), deterministic(false), has_walls(false), broadphase(GolfEngine::Broadphase::create(Tilemap::DEFAULT_BROADPHASE)), worker_pool(nullptr)
+        {
+            this->initializeSlots();
+        }
+
+        ~Tilemap();
 
         /**
          * @brief Visit the object with a RenderableVisitor.
@@ -31,9 +75,9 @@ namespace GolfEngine
          */
         inline void visit(GolfEngine::RenderableVisitor *visitor)
         {
-            for (auto it : this->tiles)
+            for (GolfEngine::Tile *tile : this->tiles)
             {
-                it.second->visit(visitor);
+                tile->visit(visitor);
             }
         }
 
@@ -41,38 +85,94 @@ namespace GolfEngine
          * @brief This function finds and returns a tile designated by a position.
          *
          * @param pos Position of tile.
-         * @returns Tile found at given position. Returns nullptr if no such tile exists.
+         * @returns Tile found at given position. Returns nullptr if no such tile exists, including outside of the Tilemap's limits.
+         */
+        inline Tile *findTile(GolfEngine::Vector2 pos) const
+        {
+            double x = std::floor(pos.x / GolfEngine::TileGeometry::TILE_SIZE);
+            double y = std::floor(pos.y / GolfEngine::TileGeometry::TILE_SIZE);
+            // Written so that NaN positions fail the check too.
+            if (!(x >= 0 && y >= 0 && x < this->side_length && y < this->side_length))
+            {
+                return nullptr;
+            }
+            return this->getTile((unsigned int)x, (unsigned int)y);
+        }
+
+        /**
+         * @brief Get the tile at a tile coordinate.
+         *
+         * @param x Column of the tile.
+         * @param y Row of the tile.
+         * @returns Tile at the coordinate. Returns nullptr if there is no tile there, or the coordinate is outside of the Tilemap.
+         */
+        inline Tile *getTile(unsigned int x, unsigned int y) const
+        {
+            if (x >= this->side_length || y >= this->side_length)
+            {
+                return nullptr;
+            }
+            if (this->chunks_per_side == 0)
+            {
+                return this->slots[x + (y * this->side_length)];
+            }
+            const std::vector<GolfEngine::Tile *> &chunk = this->chunks[(x / Tilemap::CHUNK_SIDE_LENGTH) + ((y / Tilemap::CHUNK_SIDE_LENGTH) * this->chunks_per_side)];
+            if (chunk.empty())
+            {
+                return nullptr;
+            }
+            return chunk[(x % Tilemap::CHUNK_SIDE_LENGTH) + ((y % Tilemap::CHUNK_SIDE_LENGTH) * Tilemap::CHUNK_SIDE_LENGTH)];
+        }
+
+        /**
+         * @brief Get every tile in the Tilemap.
+         *
+         * @returns The tiles, in row order (ascending \ref GolfEngine::Tile::getMapIndex "map index").
+         */
+        inline const std::vector<GolfEngine::Tile *> &getTiles() const
+        {
+            return this->tiles;
+        }
+
+        /**
+         * @brief Have every tile use the geometry of the matching tile in another Tilemap, instead of its own.
+         *
+         * See \ref GolfEngine::Tile::shareGeometry. The source has to outlive this Tilemap's tiles.
+         *
+         * @param source Tilemap with the same tiles, at the same map indices.
+         * @throws std::logic_error If the tiles don't match.
          */
-        Tile *findTile(GolfEngine::Vector2 pos) const;
+        void shareGeometry(const GolfEngine::Tilemap &source);
 
         /**
          * @brief This function adds a tile to the tilemap.
          *
+         * The tile is \ref GolfEngine::Tile::initialize "initialized" as it is added, so it should not be initialized beforehand.
+         *
          * @param tile The tile to add to the tilemap.
-         * @returns True if the addition was a success, false otherwise.
+         * @returns True if the addition was a success, false if there is already a tile there or it is outside of the Tilemap's limits.
          */
         bool addTile(GolfEngine::Tile *tile);
 
         /**
          * @brief Convert a position vector to a tile index.
          * 
-         * Each Tile is stored with an index in the Tilemap's internal unordered map.
+         * Each Tile is stored with a row ordered index, x + (y * side length).
          * This function will convert a position vector into an appropriate index.
          *
          * @param vec Position of the Tile to find.
-         * @returns Index of the Tile sharing that position in the Tilemap.
-         * @throws std::out_of_range If trying to find an index corresponding to a position outside of the Tilemap's limits.
+         * @returns Index of the Tile sharing that position in the Tilemap, or -1 if the position is outside of the Tilemap's limits.
          */
         inline int getTileIndex(GolfEngine::Vector2 vec) const
         {
-            // floor int
-            int x = std::floor(vec.x / GolfEngine::TileGeometry::TILE_SIZE);
-            int y = std::floor(vec.y / GolfEngine::TileGeometry::TILE_SIZE);
-            if(x < 0 || x >= (int)(this->getSideLength()) || y < 0 || y >= (int)(this->getSideLength())){
-                throw std::out_of_range("Tried to find tile outside of Tilemap limits.");
+            double x = std::floor(vec.x / GolfEngine::TileGeometry::TILE_SIZE);
+            double y = std::floor(vec.y / GolfEngine::TileGeometry::TILE_SIZE);
+            // Written so that NaN positions fail the check too, as in findTile.
+            if (!(x >= 0 && y >= 0 && x < this->side_length && y < this->side_length))
+            {
+                return -1;
             }
-            int i = x + (y * this->getSideLength());
-            return i;
+            return (int)x + ((int)y * (int)this->side_length);
         }
 
         /**
@@ -84,43 +184,264 @@ namespace GolfEngine
             return this->side_length;
         }
 
+        /**
+         * @brief Move entities that have left their tile into the tile they are now in.
+         *
+         * Only entities on the dirty list are checked. Tiles add entities that leave their bounds during
+         * \ref frameUpdate "frameUpdate()", and entities add themselves whenever their position is set.
+         * Entities that end up outside of every tile are respawned. If their respawn position is outside
+         * of every tile too, they are removed from the Tilemap.
+         */
         void reorderEntities();
 
         /**
          * @brief Find all entities in the Tilemap that contains a certain tag.
+         *
+         * This is a lookup in the Tilemap's tag index, and does not copy anything.
          * 
          * @param tag Tag to search for
-         * @returns List of all entities with that tag.
+         * @returns List of all entities with that tag. It is only valid until an entity is added, removed, retagged or changes tile.
+        */
+        inline const GolfEngine::Entity::EntityList& findEntitiesWithTag(const GolfEngine::Tag& tag) const {
+            return this->tag_index.find(tag);
+        }
+
+        /**
+         * @brief Get a view over every entity in the Tilemap, in tile order.
+         *
+         * @returns A lazy range over the entities. It is only valid until an entity is added, removed or changes tile.
+        */
+        inline GolfEngine::EntityRange getAllEntities() const {
+            return GolfEngine::EntityRange(this->tiles);
+        }
+
+        /**
+         * @brief Call a function on every entity in the Tilemap, in tile order.
+         *
+         * @param fn Function taking a GolfEngine::Entity*. It must not add, remove or move entities.
         */
-        GolfEngine::Entity::EntityList findEntitiesWithTag(const GolfEngine::Tag& tag) const;
-
-        inline GolfEngine::Entity::EntityList getAllEntities() const {
-            GolfEngine::Entity::EntityList list;
-            for(auto pair : this->tiles){
-                GolfEngine::Tile* tile = pair.second;
-                for(GolfEngine::Entity* ent : *(tile->getEntities())){
-                    list.push_back(ent);
+        template <typename Function>
+        inline void forEachEntity(Function fn) const {
+            for(GolfEngine::Tile* tile : this->tiles){
+                for(GolfEngine::Entity* ent : *tile->getEntities()){
+                    fn(ent);
                 }
             }
-            return list;
         }
 
-        // this, like tile, returns list of all collisions to be handled!
-        inline GolfEngine::Collision::CollisionList frameUpdate(float dt_s){
-            GolfEngine::Collision::CollisionList collisions;
-            for(auto pair : this->tiles){
-                GolfEngine::Tile* tile = pair.second;
-                GolfEngine::Collision::CollisionList per_tile_collisions = tile->frameUpdate(dt_s);
-                for(GolfEngine::Collision& collision : per_tile_collisions){
-                    collisions.push_back(collision);
-                }
+        /**
+         * @brief Call a function on every entity in the Tilemap with a certain tag.
+         *
+         * @param tag Tag to search for.
+         * @param fn Function taking a GolfEngine::Entity*. It must not add, remove, retag or move entities.
+        */
+        template <typename Function>
+        inline void forEachEntityWithTag(const GolfEngine::Tag& tag, Function fn) const {
+            for(GolfEngine::Entity* ent : this->tag_index.find(tag)){
+                fn(ent);
             }
-            return collisions;
         }
 
+        /**
+         * @brief Update every tile, then check for collisions across the whole Tilemap.
+         *
+         * Collisions are allocated from the Tilemap's frame arena, which is reset at the start of every update.
+         *
+         * With more than one worker (see \ref setWorkerCount), tiles are updated in parallel, in contiguous ranges.
+         * Entities that leave their tile are gathered per range and merged in tile order, and are only moved by
+         * the next \ref reorderEntities "reorderEntities()", so the update and the collisions it reports are the
+         * same as a serial update's. Golfballs that came to rest are gathered the same way, see
+         * \ref getStoppedGolfballs "getStoppedGolfballs()".
+         *
+         * @param dt_s Time, in seconds, to factor in.
+         * @returns Every collision that happened during the update. Each colliding pair is reported in both orders.
+         * The span is only valid until the next update.
+         */
+        GolfEngine::CollisionSpan frameUpdate(double dt_s);
+
+        /**
+         * @brief Get the golfballs that came to rest during the last update.
+         *
+         * Tiles only record them, so anything the game does about it (like printing scores) happens on the
+         * calling thread, after the update.
+         *
+         * @returns The golfballs, in tile order, the same whether or not tiles were updated in parallel.
+         */
+        inline const GolfEngine::Entity::EntityList &getStoppedGolfballs() const
+        {
+            return this->stopped;
+        }
+
+        /**
+         * @brief Check whether any tile had walls at the start of the last update.
+         *
+         * Tiles skip sweeping their circles against walls when there are none to hit.
+         *
+         * @returns True if some tile has walls, false otherwise.
+         */
+        inline bool hasWalls() const
+        {
+            return this->has_walls;
+        }
+
+        /**
+         * @brief Get the arena frame-transient data is allocated from.
+         *
+         * @returns Pointer to the Tilemap's frame arena.
+         */
+        inline GolfEngine::FrameArena *getFrameArena()
+        {
+            return &this->frame_arena;
+        }
+
+        /**
+         * @brief Get the broadphase used to find collision candidates.
+         *
+         * @returns Pointer to the Tilemap's broadphase.
+         */
+        inline GolfEngine::Broadphase *getBroadphase() const
+        {
+            return this->broadphase;
+        }
+
+        /**
+         * @brief Replace the broadphase used to find collision candidates.
+         *
+         * Every strategy finds the same collisions, in the same order. They only differ in speed.
+         *
+         * @param strategy Strategy to switch to.
+         */
+        inline void setBroadphaseStrategy(GolfEngine::BroadphaseStrategy strategy)
+        {
+            if (strategy == this->broadphase->getStrategy())
+            {
+                return;
+            }
+            delete this->broadphase;
+            this->broadphase = GolfEngine::Broadphase::create(strategy);
+        }
+
+        /**
+         * @brief Set the amount of threads tiles are updated on.
+         *
+         * @param worker_count Amount of worker threads. 0 or 1 updates tiles on the calling thread.
+         */
+        void setWorkerCount(unsigned int worker_count);
+
+        /**
+         * @brief Get the amount of threads tiles are updated on.
+         */
+        unsigned int getWorkerCount() const;
+
+        /**
+         * @brief Turn deterministic mode on or off.
+         *
+         * In deterministic mode, every position, velocity and acceleration is rounded to a fixed-point
+         * lattice (see \ref FIXED_POINT_BITS) after the tiles update, so state carried from one frame to
+         * the next is exactly representable, and can be recorded and restored without drift.
+         *
+         * @param deterministic True to turn deterministic mode on, false to turn it off.
+         */
+        inline void setDeterministic(bool deterministic)
+        {
+            this->deterministic = deterministic;
+        }
+
+        inline bool isDeterministic() const
+        {
+            return this->deterministic;
+        }
+
+        /**
+         * @brief Hash the physics state of every entity in the Tilemap.
+         *
+         * Tiles are visited in row order and entities in slot order, so two runs that do the same
+         * things in the same order hash the same, frame for frame.
+         *
+         * @returns 64 bit FNV-1a hash of the state, as fixed-point integers.
+         */
+        std::uint64_t hashState() const;
+
     private:
         unsigned int side_length;
-        std::unordered_map<unsigned int, Tile *> tiles;
+        bool deterministic;
+
+        // Whether any tile has walls, checked at the start of every update.
+        bool has_walls;
+
+        // Tile slots, indexed by position. Dense maps use slots, chunked maps use chunks (and have chunks_per_side set).
+        std::vector<GolfEngine::Tile *> slots;
+        std::vector<std::vector<GolfEngine::Tile *>> chunks;
+        unsigned int chunks_per_side;
+
+        // Every tile, kept in row order so iteration is deterministic.
+        std::vector<GolfEngine::Tile *> tiles;
+
+        // Entities that may have changed tile, filled in by the tiles' stores.
+        GolfEngine::Entity::EntityList dirty;
+        GolfEngine::Entity::EntityList pending;
+
+        // Every entity in the Tilemap, by tag.
+        GolfEngine::EntityIndex tag_index;
+        GolfEngine::Broadphase *broadphase;
+
+        // Threads tiles are updated on, or nullptr to update them on the calling thread.
+        GolfEngine::WorkStealingPool *worker_pool;
+
+        // For parallel updates: the first tile of each range, then the tile count, and the entities each range found leaving their tile.
+        std::vector<std::size_t> range_starts;
+        std::vector<GolfEngine::Entity::EntityList> escapes;
+
+        // Golfballs that stopped during the last update, gathered from the tiles.
+        GolfEngine::Entity::EntityList stopped;
+
+        // Scratch space for collision checks, kept between frames to avoid reallocating it.
+        GolfEngine::Entity::EntityList bodies;
+        GolfEngine::AABB::AABBList bounds;
+        GolfEngine::CandidatePair::CandidatePairList pairs;
+
+        // Frame-transient data, reset at the start of every update.
+        GolfEngine::FrameArena frame_arena;
+
+        // Contact for each pair that passed the narrowphase, lined up with the start of pairs.
+        std::vector<GolfEngine::Contact> contacts;
+
+        // Shape of each entity in bodies, lined up with it.
+        std::vector<GolfEngine::ContactBody> contact_bodies;
+
+        // Warm start data for every polygon pair tested last collision check, kept so the next check can reuse it.
+        GolfEngine::SeparatingAxisCache axis_cache;
+
+        /**
+         * @brief Check every active entity in the Tilemap against every other.
+         *
+         * @returns The collisions found, allocated from the frame arena.
+         */
+        GolfEngine::CollisionSpan detectCollisions();
+
+        /**
+         * @brief Update a single tile, as a step of \ref frameUpdate "frameUpdate()".
+         */
+        void updateTile(GolfEngine::Tile *tile, double dt_s);
+
+        /**
+         * @brief Update every tile across the worker pool, then merge what each range found leaving its tiles.
+         */
+        void updateTilesInParallel(double dt_s);
+
+        /**
+         * @brief Set up empty tile slots, picking the dense or chunked layout based on side length.
+         */
+        void initializeSlots();
+
+        /**
+         * @brief Get a reference to the slot at a tile coordinate, allocating its chunk if needed.
+         */
+        GolfEngine::Tile *&slotAt(unsigned int x, unsigned int y);
+
+        // Tilemaps own their broadphase, and cannot be copied.
+        Tilemap(const Tilemap &);
+        Tilemap &operator=(const Tilemap &);
     };
 }
 
@@ -0,0 +1,126 @@
+/**
+ * @file TrajectoryPredictor.cpp
+ * @brief This file contains definitions for the TrajectoryPredictor class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#include "TrajectoryPredictor.hpp"
+#include "../Physics/IntegrationKernel.hpp"
+
+using GolfEngine::TrajectoryPredictor;
+
+TrajectoryPredictor::Body TrajectoryPredictor::readBody(const GolfEngine::Entity &ball)
+{
+    Body body;
+    const GolfEngine::EntityStore *store = ball.getEntityStore();
+    if (store != nullptr)
+    {
+        std::size_t slot = ball.getSlot();
+        body.pos_x = store->pos_x[slot];
+        body.pos_y = store->pos_y[slot];
+        body.vel_x = store->vel_x[slot];
+        body.vel_y = store->vel_y[slot];
+        body.acc_x = store->acc_x[slot];
+        body.acc_y = store->acc_y[slot];
+        body.radius = store->radius[slot];
+        return body;
+    }
+    GolfEngine::Vector2 position = ball.getPosition();
+    GolfEngine::Vector2 velocity = ball.getVelocity();
+    GolfEngine::Vector2 acceleration = ball.getAcceleration();
+    body.pos_x = position.x;
+    body.pos_y = position.y;
+    body.vel_x = velocity.x;
+    body.vel_y = velocity.y;
+    body.acc_x = acceleration.x;
+    body.acc_y = acceleration.y;
+    body.radius = ball.getRadius();
+    return body;
+}
+
+const std::vector<GolfEngine::Vector2> &TrajectoryPredictor::predict(const GolfEngine::Entity &ball, const GolfEngine::Vector2 &force, unsigned int steps)
+{
+    Body body = TrajectoryPredictor::readBody(ball);
+    if (this->valid && steps == this->steps && body == this->start && (force - this->force).magnitudeSqr() <= this->tolerance * this->tolerance)
+    {
+        return this->path;
+    }
+    this->valid = true;
+    this->steps = steps;
+    this->force = force;
+    this->start = body;
+
+    // Strike the ball the way Level::applyPlayerForce does.
+    GolfEngine::Vector2 acceleration = GolfEngine::Vector2(body.acc_x, body.acc_y) + force;
+    if (acceleration.magnitudeSqr() < 1)
+    {
+        acceleration = GolfEngine::Vector2::zero;
+    }
+    body.acc_x = acceleration.x;
+    body.acc_y = acceleration.y;
+    this->simulate(body, steps);
+    return this->path;
+}
+
+void TrajectoryPredictor::simulate(Body body, unsigned int steps)
+{
+    const double scale = (double)(1ULL << GolfEngine::Tilemap::FIXED_POINT_BITS);
+    const bool deterministic = this->map->isDeterministic();
+    GolfEngine::IntegrationBatch batch;
+    batch.pos_x = &body.pos_x;
+    batch.pos_y = &body.pos_y;
+    batch.vel_x = &body.vel_x;
+    batch.vel_y = &body.vel_y;
+    batch.acc_x = &body.acc_x;
+    batch.acc_y = &body.acc_y;
+    batch.count = 1;
+
+    this->path.clear();
+    this->path.reserve(steps + 1);
+    this->path.push_back(GolfEngine::Vector2(body.pos_x, body.pos_y));
+    for (unsigned int step = 0; step < steps; step++)
+    {
+        // This is the tile the Tilemap would have moved the ball into before the step.
+        GolfEngine::Tile *tile = this->map->findTile(GolfEngine::Vector2(body.pos_x, body.pos_y));
+        if (tile == nullptr)
+        {
+            break;
+        }
+        double friction = 1.0 - (tile->getFriction() * this->step_s);
+        if (friction < 0)
+        {
+            friction = 0;
+        }
+
+        // Same steps as Tile::frameUpdate, for a single ball.
+        GolfEngine::Vector2 start(body.pos_x, body.pos_y);
+        GolfEngine::IntegrationKernel::integrateScalar(batch, this->step_s, friction);
+        GolfEngine::Vector2 position(body.pos_x, body.pos_y);
+        GolfEngine::Vector2 velocity(body.vel_x, body.vel_y);
+        GolfEngine::Vector2 acceleration(body.acc_x, body.acc_y);
+        if (tile->bounceOffWalls(start, body.radius, position, velocity, acceleration))
+        {
+            body.pos_x = position.x;
+            body.pos_y = position.y;
+            body.vel_x = velocity.x;
+            body.vel_y = velocity.y;
+            body.acc_x = acceleration.x;
+            body.acc_y = acceleration.y;
+        }
+        if (deterministic)
+        {
+            GolfEngine::Scalar *fields[] = {&body.pos_x, &body.pos_y, &body.vel_x, &body.vel_y, &body.acc_x, &body.acc_y};
+            for (GolfEngine::Scalar *field : fields)
+            {
+                *field = GolfEngine::EntityStore::quantize(*field, scale);
+            }
+        }
+        this->path.push_back(GolfEngine::Vector2(body.pos_x, body.pos_y));
+        if (body.vel_x == 0 && body.vel_y == 0 && body.acc_x == 0 && body.acc_y == 0)
+        {
+            break;
+        }
+    }
+}
@@ -0,0 +1,129 @@
+/**
+ * @file TrajectoryPredictor.hpp
+ * @brief This file contains declerations for the TrajectoryPredictor class.
+ *
+ * A TrajectoryPredictor forward-simulates a single golfball against the static geometry of a
+ * Tilemap, e.g. to preview a shot while the player is aiming. The ball is stepped exactly as
+ * the Tilemap would step it (integration, wall bounces and, in deterministic mode, rounding),
+ * but none of the Tilemap's bookkeeping is done and nothing in it is changed. Other entities,
+ * such as the goal and obstacles, are ignored.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#ifndef TRAJECTORYPREDICTOR_H
+#define TRAJECTORYPREDICTOR_H
+
+#include "../Geometry/Vector2.hpp"
+#include "Entities/Entity.hpp"
+#include "Tilemap.hpp"
+#include <vector>
+#include <stdexcept>
+
+namespace GolfEngine
+{
+    class TrajectoryPredictor
+    {
+    public:
+        /**
+         * @brief Default amount of physics steps to predict.
+         */
+        static const unsigned int DEFAULT_STEPS = 300;
+
+        /**
+         * @brief Default distance a shot's force can drift from the last prediction's before it is predicted again.
+         */
+        static constexpr double DEFAULT_TOLERANCE = 1;
+
+        /**
+         * @param map Tilemap to predict against.
+         * @param step_s Length of a single physics step, in seconds. Should match the one the Tilemap is updated with.
+         * @throws std::domain_error If the step is not within (0, 1].
+         */
+        TrajectoryPredictor(GolfEngine::Tilemap *map, double step_s) : map(map), step_s(step_s), tolerance(TrajectoryPredictor::DEFAULT_TOLERANCE), valid(false), steps(0)
+        {
+            if (step_s <= 0 || step_s > 1)
+            {
+                throw std::domain_error("Step length must be greater than 0 and no greater than 1 second.");
+            }
+        }
+
+        /**
+         * @brief Predict the path of a ball if it were struck with a force.
+         *
+         * If the ball hasn't changed since the last prediction, and the force is within tolerance of
+         * the last prediction's, the last path is returned as is.
+         *
+         * @param ball Ball to predict the path of. It is not changed.
+         * @param force Force the ball would be struck with.
+         * @param steps Most physics steps to predict.
+         * @returns The ball's position before the shot, then after each step. The path ends early if the
+         * ball comes to rest or leaves the map. Only valid until the next prediction.
+         */
+        const std::vector<GolfEngine::Vector2> &predict(const GolfEngine::Entity &ball, const GolfEngine::Vector2 &force, unsigned int steps = TrajectoryPredictor::DEFAULT_STEPS);
+
+        /**
+         * @brief Set how far a shot's force can drift before it is predicted again.
+         *
+         * @param tolerance Distance between forces. 0 predicts every new force.
+         */
+        inline void setTolerance(double tolerance)
+        {
+            this->tolerance = tolerance;
+        }
+
+        inline double getTolerance() const
+        {
+            return this->tolerance;
+        }
+
+        /**
+         * @brief Forget the last prediction, e.g. because the map's geometry changed.
+         */
+        inline void invalidate()
+        {
+            this->valid = false;
+        }
+
+    private:
+        GolfEngine::Tilemap *map;
+        double step_s;
+        double tolerance;
+
+        /**
+         * @brief Physics state of the predicted ball, at the precision its EntityStore keeps it.
+         */
+        struct Body
+        {
+            GolfEngine::Scalar pos_x, pos_y;
+            GolfEngine::Scalar vel_x, vel_y;
+            GolfEngine::Scalar acc_x, acc_y;
+            double radius;
+
+            inline bool operator==(const Body &rhs) const
+            {
+                return this->pos_x == rhs.pos_x && this->pos_y == rhs.pos_y && this->vel_x == rhs.vel_x && this->vel_y == rhs.vel_y && this->acc_x == rhs.acc_x && this->acc_y == rhs.acc_y && this->radius == rhs.radius;
+            }
+        };
+
+        // What the current path was predicted from.
+        bool valid;
+        unsigned int steps;
+        GolfEngine::Vector2 force;
+        Body start;
+        std::vector<GolfEngine::Vector2> path;
+
+        /**
+         * @brief Read a ball's state, straight from its store if it has one.
+         */
+        static Body readBody(const GolfEngine::Entity &ball);
+
+        /**
+         * @brief Step a body forward, filling in path.
+         */
+        void simulate(Body body, unsigned int steps);
+    };
+}
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * @file Fixed.hpp
+ * @brief This file contains declerations for the Fixed class.
+ *
+ * Fixed is a signed fixed-point number with 16 fractional bits, stored in 64 bits. Its
+ * arithmetic is integer arithmetic, so results are the same on every compiler and CPU,
+ * e.g. for replays and offline analysis through \ref GolfEngine::Vector2x "Vector2x".
+ * Products and quotients stay exact as long as values stay within +/-2^31.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-07-02
+ */
+
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+
+namespace GolfEngine
+{
+    class Fixed
+    {
+    public:
+        /**
+         * @brief Amount of fractional bits.
+         */
+        static const int FRACTION_BITS = 16;
+
+        /**
+         * @brief The raw value of 1.
+         */
+        static const std::int64_t ONE = std::int64_t(1) << FRACTION_BITS;
+
+        constexpr Fixed() : raw(0){};
+        constexpr Fixed(int value) : raw(std::int64_t(value) * ONE){};
+
+        /**
+         * @brief Convert a floating point value, rounding to the nearest fixed-point value.
+         */
+        constexpr explicit Fixed(double value) : raw(std::int64_t((value * ONE) + ((value < 0) ? -0.5 : 0.5))){};
+
+        /**
+         * @brief Create a value from its raw representation.
+         *
+         * @param raw The value multiplied by \ref ONE.
+         */
+        static constexpr Fixed fromRaw(std::int64_t raw)
+        {
+            return Fixed(raw, 0);
+        }
+
+        /**
+         * @brief Get the raw representation.
+         *
+         * @returns The value multiplied by \ref ONE.
+         */
+        constexpr std::int64_t getRaw() const
+        {
+            return this->raw;
+        }
+
+        constexpr explicit operator double() const
+        {
+            return double(this->raw) / ONE;
+        }
+        constexpr explicit operator float() const
+        {
+            return float(double(*this));
+        }
+
+        constexpr Fixed operator-() const
+        {
+            return Fixed::fromRaw(-this->raw);
+        }
+        constexpr Fixed operator+(const Fixed &rhs) const
+        {
+            return Fixed::fromRaw(this->raw + rhs.raw);
+        }
+        constexpr Fixed operator-(const Fixed &rhs) const
+        {
+            return Fixed::fromRaw(this->raw - rhs.raw);
+        }
+        // Split the left side into whole and fractional parts so the product does not need 128 bits.
+        constexpr Fixed operator*(const Fixed &rhs) const
+        {
+            return Fixed::fromRaw(((this->raw >> FRACTION_BITS) * rhs.raw) + (((this->raw & (ONE - 1)) * rhs.raw) >> FRACTION_BITS));
+        }
+        /**
+         * @throws std::domain_error If rhs is 0.
+         */
+        constexpr Fixed operator/(const Fixed &rhs) const
+        {
+            return (rhs.raw == 0) ? throw std::domain_error("Fixed-point division by zero.") : Fixed::fromRaw((this->raw * ONE) / rhs.raw);
+        }
+        inline Fixed &operator+=(const Fixed &rhs)
+        {
+            return *this = *this + rhs;
+        }
+        inline Fixed &operator-=(const Fixed &rhs)
+        {
+            return *this = *this - rhs;
+        }
+        inline Fixed &operator*=(const Fixed &rhs)
+        {
+            return *this = *this * rhs;
+        }
+        inline Fixed &operator/=(const Fixed &rhs)
+        {
+            return *this = *this / rhs;
+        }
+
+        // Comparison
+        constexpr bool operator==(const Fixed &rhs) const { return this->raw == rhs.raw; }
+        constexpr bool operator!=(const Fixed &rhs) const { return this->raw != rhs.raw; }
+        constexpr bool operator<(const Fixed &rhs) const { return this->raw < rhs.raw; }
+        constexpr bool operator>(const Fixed &rhs) const { return this->raw > rhs.raw; }
+        constexpr bool operator<=(const Fixed &rhs) const { return this->raw <= rhs.raw; }
+        constexpr bool operator>=(const Fixed &rhs) const { return this->raw >= rhs.raw; }
+
+        /**
+         * @brief Square root, rounded to the nearest fixed-point value.
+         *
+         * Found through IEEE-754 sqrt, which is correctly rounded everywhere, so the result is still deterministic.
+         *
+         * @throws std::domain_error If value is negative.
+         */
+        inline friend Fixed sqrt(const Fixed &value)
+        {
+            if (value.raw < 0)
+            {
+                throw std::domain_error("Fixed-point square root of a negative value.");
+            }
+            // sqrt(raw / ONE) * ONE == sqrt(raw) * sqrt(ONE)
+            return Fixed::fromRaw(std::llround(std::sqrt(double(value.raw)) * 256.0));
+        }
+
+        // tostring
+        inline friend std::ostream &operator<<(std::ostream &os, const Fixed &value)
+        {
+            os << double(value);
+            return os;
+        }
+
+    private:
+        std::int64_t raw;
+
+        constexpr Fixed(std::int64_t raw_, int) : raw(raw_){};
+    };
+}
+
+#endif
@@ -15,10 +15,10 @@ using GolfEngine::Line;
 #define IS_APPROXIMATELY(n, m) (ABS((n-m)) < MAX_CLOSENESS)
 
 bool Line::intersects(const GolfEngine::Vector2& point) const {
-    float d1 = point.distance(this->a);
-    float d2 = point.distance(this->b);
+    GolfEngine::Scalar d1 = point.distance(this->a);
+    GolfEngine::Scalar d2 = point.distance(this->b);
 
-    float dsum = (d1+d2);
+    GolfEngine::Scalar dsum = (d1+d2);
 
     if( IS_APPROXIMATELY(dsum, this->length()) ){
         return true;
@@ -27,18 +27,18 @@ bool Line::intersects(const GolfEngine::Vector2& point) const {
 }
 
 bool Line::intersects(const Line& other) const {
-    float denominator = ((this->b.x - this->a.x) * (other.b.y - other.a.y)) - ((this->b.y - this->a.y) * (other.b.x - other.a.x));
-    float numerator1 = ((this->a.y - other.a.y) * (other.b.x - other.a.x)) - ((this->a.x - other.a.x) * (other.b.y - other.a.y));
-    float numerator2 = ((this->a.y - other.a.y) * (this->b.x - this->a.x)) - ((this->a.x - other.a.x) * (this->b.y - this->a.y));
+    double denominator = ((this->b.x - this->a.x) * (other.b.y - other.a.y)) - ((this->b.y - this->a.y) * (other.b.x - other.a.x));
+    double numerator1 = ((this->a.y - other.a.y) * (other.b.x - other.a.x)) - ((this->a.x - other.a.x) * (other.b.y - other.a.y));
+    double numerator2 = ((this->a.y - other.a.y) * (this->b.x - this->a.x)) - ((this->a.x - other.a.x) * (this->b.y - this->a.y));
 
     if(denominator == 0) {
         return (numerator1 == 0) && (numerator2 == 0);
     } 
 
-    float r = numerator1 / denominator;
-    float s = numerator2 / denominator;
+    double r = numerator1 / denominator;
+    double s = numerator2 / denominator;
 
-    return (r >= 0 && r <= 1) && (s >= 0 && s <= 0);
+    return (r >= 0 && r <= 1) && (s >= 0 && s <= 1);
 }
 
 #undef IS_APPROXIMATELY
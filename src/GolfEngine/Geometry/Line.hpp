@@ -19,7 +19,7 @@ namespace GolfEngine
         GolfEngine::Vector2 a;
         GolfEngine::Vector2 b;
         Line(GolfEngine::Vector2 start, GolfEngine::Vector2 end) : a(start), b(end){};
-        inline float length() const
+        inline GolfEngine::Scalar length() const
         {
             return this->a.distance(this->b);
         }
@@ -19,10 +19,10 @@ bool Circle::intersects(const GolfEngine::Line& line) const
         return true;
     }
     // Find the closest point on the line to the circle
-    float dot = (this->getPosition() - line.a) * (line.b - line.a);
+    GolfEngine::Scalar dot = (this->getPosition() - line.a) * (line.b - line.a);
     dot /= SQR(line.length());
-    float closestX = line.a.x + (dot * (line.b.x - line.a.x));
-    float closestY = line.a.y + (dot * (line.b.y - line.a.y));
+    GolfEngine::Scalar closestX = line.a.x + (dot * (line.b.x - line.a.x));
+    GolfEngine::Scalar closestY = line.a.y + (dot * (line.b.y - line.a.y));
     GolfEngine::Vector2 closest(closestX, closestY);
     // Check to see if the closest point on the line
     // is within the bounds of the line's endpoints.
@@ -33,9 +33,14 @@ bool Circle::intersects(const GolfEngine::Line& line) const
     return this->contains(closest);
 }
 
+#ifdef GOLFENGINE_HEADLESS
+void Circle::render(sf::RenderWindow *){
+    /* Headless builds have nothing to draw onto. */
+}
+#else
 void Circle::render(sf::RenderWindow *window){
     sf::CircleShape shape(this->getRadius());
-    shape.setFillColor(this->getColor());
+    shape.setFillColor(sf::Color(this->getColor()));
 
     sf::Vector2f render_pos(this->getOrigin().x, this->getOrigin().y);
 
@@ -43,5 +48,6 @@ void Circle::render(sf::RenderWindow *window){
 
     window->draw(shape);
 }
+#endif
 
 #undef SQR
\ No newline at end of file
@@ -21,16 +21,16 @@ namespace GolfEngine
     class Circle : public GolfEngine::Shape
     {
     public:
-        Circle(float radius) : GolfEngine::Shape()
+        Circle(GolfEngine::Scalar radius) : GolfEngine::Shape()
         {
             this->setRadius(radius);
         }
-        Circle(float radius, GolfEngine::Vector2 pos) : GolfEngine::Shape(pos)
+        Circle(GolfEngine::Scalar radius, GolfEngine::Vector2 pos) : GolfEngine::Shape(pos)
         {
             this->setRadius(radius);
             this->setPosition(pos);
         }
-        Circle(float radius, GolfEngine::Vector2 pos, GolfEngine::Vector2 origin) : GolfEngine::Shape(origin)
+        Circle(GolfEngine::Scalar radius, GolfEngine::Vector2 pos, GolfEngine::Vector2 origin) : GolfEngine::Shape(origin)
         {
             this->setRadius(radius);
             this->setPosition(pos);
@@ -44,7 +44,7 @@ namespace GolfEngine
          *
          * @param radius New radius.
          */
-        inline void setRadius(float radius)
+        inline void setRadius(GolfEngine::Scalar radius)
         {
             if (radius < 0)
             {
@@ -58,7 +58,7 @@ namespace GolfEngine
          *
          * @returns The radius of the circle.
          */
-        inline float getRadius() const
+        inline GolfEngine::Scalar getRadius() const
         {
             return this->radius;
         }
@@ -91,12 +91,12 @@ namespace GolfEngine
             return this->getPosition().distance(other.getPosition()) <= (this->getRadius() + other.getRadius());
         }
 
-        inline virtual float getPerimeter() const
+        inline virtual GolfEngine::Scalar getPerimeter() const
         {
             return 2.0 * GolfEngine::pi * this->getRadius();
         }
 
-        virtual float getArea() const
+        virtual GolfEngine::Scalar getArea() const
         {
             return GolfEngine::pi * SQR(this->getRadius());
         }
@@ -110,7 +110,7 @@ namespace GolfEngine
 
     private:
         GolfEngine::Vector2 position;
-        float radius;
+        GolfEngine::Scalar radius;
     };
 }
 
@@ -10,88 +10,275 @@
 #include "Shape.hpp"
 #include "../Vector2.hpp"
 #include "../Line.hpp"
-#include <cstring>
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
+#include <utility>
 
 #include <iostream>
 
 using GolfEngine::Polygon;
 
+void Polygon::initializeVertices(uint max_vertices)
+{
+    this->vertices = this->inline_vertices;
+    this->setMaxVertices(max_vertices);
+    if (max_vertices > Polygon::INLINE_VERTICES)
+    {
+        this->vertices = new GolfEngine::Vector2[max_vertices];
+    }
+    this->setVertexCount(0);
+}
+
+void Polygon::copyFrom(const Polygon &other)
+{
+    this->releaseVertices();
+    this->max_vertices = other.max_vertices;
+    if (this->max_vertices > Polygon::INLINE_VERTICES)
+    {
+        this->vertices = new GolfEngine::Vector2[this->max_vertices];
+    }
+    std::copy(other.vertices, other.vertices + other.vertex_count, this->vertices);
+    this->vertex_count = other.vertex_count;
+
+    this->cached_flags = other.cached_flags;
+    this->area = other.area;
+    this->perimeter = other.perimeter;
+    this->centroid = other.centroid;
+    this->local_bounds = other.local_bounds;
+    this->world_vertices = other.world_vertices;
+    this->world_edges = other.world_edges;
+    this->world_origin = other.world_origin;
+    this->world_valid = other.world_valid;
+}
+
+Polygon::Polygon(const Polygon &other) : GolfEngine::Shape(other), vertices(inline_vertices)
+{
+    this->copyFrom(other);
+}
+
+Polygon::Polygon(Polygon &&other) : GolfEngine::Shape(other), vertices(inline_vertices)
+{
+    *this = std::move(other);
+}
+
+Polygon &Polygon::operator=(const Polygon &other)
+{
+    if (this != &other)
+    {
+        GolfEngine::Shape::operator=(other);
+        this->copyFrom(other);
+    }
+    return *this;
+}
+
+Polygon &Polygon::operator=(Polygon &&other)
+{
+    if (this == &other)
+    {
+        return *this;
+    }
+    GolfEngine::Shape::operator=(other);
+    if (other.vertices == other.inline_vertices)
+    {
+        // Inline vertices can't be handed over, so they are copied like any other.
+        this->copyFrom(other);
+        return *this;
+    }
+    this->releaseVertices();
+    this->vertices = other.vertices;
+    this->max_vertices = other.max_vertices;
+    this->vertex_count = other.vertex_count;
+    this->cached_flags = other.cached_flags;
+    this->area = other.area;
+    this->perimeter = other.perimeter;
+    this->centroid = other.centroid;
+    this->local_bounds = other.local_bounds;
+    this->world_vertices.swap(other.world_vertices);
+    this->world_edges.swap(other.world_edges);
+    this->world_origin = other.world_origin;
+    this->world_valid = other.world_valid;
+
+    // Leave the other polygon empty, but still usable.
+    other.vertices = other.inline_vertices;
+    other.max_vertices = Polygon::INLINE_VERTICES;
+    other.vertex_count = 0;
+    other.invalidate();
+    return *this;
+}
+
 void Polygon::addPoint(GolfEngine::Vector2 point)
 {
-    // If we have hit our max vertices, we need to adjust our list of vertices.
+    // If we have hit our max vertices, double them.
     if (this->getVertexCount() == this->getMaxVertices())
     {
-        this->setMaxVertices(this->getMaxVertices() + 1);
-        GolfEngine::Vector2 *new_vertices = new GolfEngine::Vector2[this->getMaxVertices()];
-        memcpy(new_vertices, this->vertices, this->getVertexCount());
-        delete[] this->vertices;
-        this->vertices = new_vertices;
+        uint new_max = this->getMaxVertices() * 2;
+        GolfEngine::Vector2 *new_vertices = (new_max > Polygon::INLINE_VERTICES) ? new GolfEngine::Vector2[new_max] : this->inline_vertices;
+        if (new_vertices != this->vertices)
+        {
+            std::copy(this->vertices, this->vertices + this->getVertexCount(), new_vertices);
+            this->releaseVertices();
+            this->vertices = new_vertices;
+        }
+        this->setMaxVertices(new_max);
     }
-    this->setPoint(this->getVertexCount(), point);
+    // The new vertex is past the current count, so setPoint would reject it.
+    this->vertices[this->getVertexCount()] = point;
     this->setVertexCount(this->getVertexCount() + 1);
+    this->invalidate();
 }
 
-float Polygon::getPerimeter() const
+void Polygon::updateCache(unsigned int wanted) const
 {
-    if (this->getVertexCount() < 3)
+    unsigned int missing = wanted & ~this->cached_flags;
+    if (missing == 0)
     {
-        throw std::logic_error("Cannot get the perimeter of an open polygon.");
+        return;
     }
-    Vector2 a, b;
-    float perimeter = 0;
-    for (uint i = 0; i < this->getVertexCount(); i++)
+    uint count = this->getVertexCount();
+    if ((missing & (Polygon::CACHED_AREA | Polygon::CACHED_PERIMETER | Polygon::CACHED_CENTROID)) && count < Polygon::MIN_POSSIBLE_VERTICES)
+    {
+        throw std::logic_error("Cannot measure an open polygon.");
+    }
+    // The centroid is scaled by the area, so make sure it is there first.
+    if (missing & (Polygon::CACHED_AREA | Polygon::CACHED_CENTROID))
+    {
+        // A polygon encompasses the area 1/2 * summation(x_i * y_i+1 - x_i+1 * y_i) for each point in the Polygon.
+        GolfEngine::Scalar summation = 0;
+        uint j = count - 1;
+        for (uint i = 0; i < count; i++)
+        {
+            Vector2 a = this->vertices[i];
+            Vector2 b = this->vertices[j];
+            GolfEngine::Scalar iteration = (a.x + b.x) * (a.y - b.y);
+            summation += iteration;
+            j = i;
+        }
+        this->area = summation / 2.0;
+    }
+    if (missing & Polygon::CACHED_PERIMETER)
+    {
+        GolfEngine::Scalar perimeter = 0;
+        for (uint i = 0; i < count; i++)
+        {
+            perimeter += this->vertices[i].distance(this->vertices[(i + 1) % count]);
+        }
+        this->perimeter = perimeter;
+    }
+    if (missing & Polygon::CACHED_CENTROID)
+    {
+        // See Paul Bourke's Centroid paper for more info.
+        // http://paulbourke.net/geometry/polygonmesh/centroid.pdf
+        GolfEngine::Scalar x_summation = 0, y_summation = 0;
+        GolfEngine::Scalar scalar = 1 / (6 * this->area);
+
+        for (uint i = 0; i < count; i++)
+        {
+            uint j = (i + 1) % count;
+            GolfEngine::Vector2 a = this->vertices[i];
+            GolfEngine::Vector2 b = this->vertices[j];
+            GolfEngine::Scalar factor = (a.x * b.y) - (b.x * a.y);
+            x_summation += (a.x + b.x) * factor;
+            y_summation += (a.y + b.y) * factor;
+        }
+        this->centroid = scalar * GolfEngine::Vector2(x_summation, y_summation);
+    }
+    if (missing & Polygon::CACHED_BOUNDS)
     {
-        a = this->getPoint(i);
-        b = this->getPoint((i + 1) % this->getVertexCount());
-        perimeter += a.distance(b);
+        GolfEngine::AABB bounds(INFINITY, INFINITY, -INFINITY, -INFINITY);
+        for (uint i = 0; i < count; i++)
+        {
+            bounds.min_x = std::min(bounds.min_x, this->vertices[i].x);
+            bounds.min_y = std::min(bounds.min_y, this->vertices[i].y);
+            bounds.max_x = std::max(bounds.max_x, this->vertices[i].x);
+            bounds.max_y = std::max(bounds.max_y, this->vertices[i].y);
+        }
+        this->local_bounds = bounds;
     }
-    return perimeter;
+    this->cached_flags |= missing;
 }
 
-float Polygon::getArea() const
+void Polygon::updateWorldCache() const
 {
-    if (this->getVertexCount() < 3)
+    GolfEngine::Vector2 origin = this->getOrigin();
+    if (this->world_valid && this->world_origin == origin)
     {
-        throw std::logic_error("Cannot get the area of an open polygon.");
+        return;
     }
-    // A polygon encompasses the area 1/2 * summation(x_i * y_i+1 - x_i+1 * y_i) for each point in the Polygon.
-    Vector2 a, b;
-    float summation = 0;
-    uint j = this->getVertexCount() - 1;
-    for (uint i = 0; i < this->getVertexCount(); i++)
+    uint count = this->getVertexCount();
+    this->world_vertices.resize(count);
+    for (uint i = 0; i < count; i++)
     {
-        a = this->getPoint(i);
-        b = this->getPoint(j);
-        float iteration = (a.x + b.x) * (a.y - b.y);
-        summation += iteration;
-        j = i;
+        this->world_vertices[i] = this->vertices[i] + origin;
     }
-    return summation / 2.0;
+    this->world_edges.resize(count * 4);
+    GolfEngine::Scalar *a_x = this->world_edges.data();
+    GolfEngine::Scalar *a_y = a_x + count;
+    GolfEngine::Scalar *b_x = a_y + count;
+    GolfEngine::Scalar *b_y = b_x + count;
+    for (uint i = 0; i < count; i++)
+    {
+        const GolfEngine::Vector2 &a = this->world_vertices[i];
+        const GolfEngine::Vector2 &b = this->world_vertices[(i + 1) % count];
+        a_x[i] = a.x;
+        a_y[i] = a.y;
+        b_x[i] = b.x;
+        b_y[i] = b.y;
+    }
+    this->world_origin = origin;
+    this->world_valid = true;
 }
 
-GolfEngine::Vector2 Polygon::getCentroid() const
+const std::vector<GolfEngine::Vector2> &Polygon::getWorldVertices() const
 {
-    // See Paul Bourke's Centroid paper for more info.
-    // http://paulbourke.net/geometry/polygonmesh/centroid.pdf
+    this->updateWorldCache();
+    return this->world_vertices;
+}
 
-    float area = this->getArea();
-    float x_summation = 0, y_summation = 0;
-    float scalar = 1 / (6 * area);
+GolfEngine::EdgeList Polygon::getWorldEdges() const
+{
+    this->updateWorldCache();
+    GolfEngine::EdgeList edges;
+    edges.count = this->getVertexCount();
+    edges.a_x = this->world_edges.data();
+    edges.a_y = edges.a_x + edges.count;
+    edges.b_x = edges.a_y + edges.count;
+    edges.b_y = edges.b_x + edges.count;
+    return edges;
+}
 
-    for (uint i = 0; i < this->getVertexCount(); i++)
+GolfEngine::Scalar Polygon::getPerimeter() const
+{
+    if (this->getVertexCount() < 3)
     {
-        uint j = (i + 1) % this->getVertexCount();
-        GolfEngine::Vector2 a = this->getPoint(i);
-        GolfEngine::Vector2 b = this->getPoint(j);
-        float factor = (a.x * b.y) - (b.x * a.y);
-        x_summation += (a.x + b.x) * factor;
-        y_summation += (a.y + b.y) * factor;
+        throw std::logic_error("Cannot get the perimeter of an open polygon.");
     }
+    this->updateCache(Polygon::CACHED_PERIMETER);
+    return this->perimeter;
+}
 
-    return scalar * GolfEngine::Vector2(x_summation, y_summation);
+GolfEngine::Scalar Polygon::getArea() const
+{
+    if (this->getVertexCount() < 3)
+    {
+        throw std::logic_error("Cannot get the area of an open polygon.");
+    }
+    this->updateCache(Polygon::CACHED_AREA);
+    return this->area;
 }
 
+GolfEngine::Vector2 Polygon::getCentroid() const
+{
+    this->updateCache(Polygon::CACHED_CENTROID);
+    return this->centroid;
+}
+
+#ifdef GOLFENGINE_HEADLESS
+void Polygon::render(sf::RenderWindow *)
+{
+    /* Headless builds have nothing to draw onto. */
+}
+#else
 void Polygon::render(sf::RenderWindow *window)
 {
     if (this->getVertexCount() < Polygon::MIN_POSSIBLE_VERTICES)
@@ -112,75 +299,63 @@ void Polygon::render(sf::RenderWindow *window)
 
     window->draw(convex);
 }
+#endif
 
 bool Polygon::contains(const GolfEngine::Vector2& point) const
 {
-    bool collision = false;
-
-    for (uint i = 0; i < this->getVertexCount(); i++)
-    {
-        uint j = (i + 1) % this->getVertexCount();
-        GolfEngine::Vector2 a = this->localToWorld(this->getPoint(i));
-        GolfEngine::Vector2 b = this->localToWorld(this->getPoint(j));
-
-        // Check if the point is between the two points in the y axis.
-        if ((a.y > point.y) != (b.y > point.y))
-        {
-            // Use the Jordan Curve Theorem
-            float winding_number = (b.x - a.x) * (point.y - a.y) / (b.y - a.y) + a.x;
-            if (point.x < winding_number)
-            {
-                collision = !collision;
-            }
-        }
-    }
+    unsigned char inside;
+    GolfEngine::PolygonKernel::containsPointsScalar(this->getWorldEdges(), &point.x, &point.y, 1, &inside);
+    return inside;
+}
 
-    return collision;
+void Polygon::contains(const GolfEngine::Scalar *x, const GolfEngine::Scalar *y, std::size_t count, unsigned char *inside) const
+{
+    GolfEngine::PolygonKernel::containsPoints(this->getWorldEdges(), x, y, count, inside);
 }
 
 bool Polygon::intersects(const GolfEngine::Line& line) const
 {
     // Check if the given line intersects any of the
     // lines formed by each consecutive vertex on the polygon.
-    uint j = this->getVertexCount() - 1;
-    for (uint i = 0; i < this->getVertexCount(); i++)
-    {
-        GolfEngine::Vector2 a = this->localToWorld(this->getPoint(i));
-        GolfEngine::Vector2 b = this->localToWorld(this->getPoint(j));
-
-        GolfEngine::Line edge(a, b);
-        if (edge.intersects(line))
-        {
-            return true;
-        }
+    GolfEngine::SegmentBatch segment;
+    segment.a_x = &line.a.x;
+    segment.a_y = &line.a.y;
+    segment.b_x = &line.b.x;
+    segment.b_y = &line.b.y;
+    segment.count = 1;
+    unsigned char crossed;
+    GolfEngine::PolygonKernel::crossesSegmentsScalar(this->getWorldEdges(), segment, &crossed);
+    return crossed;
+}
 
-        j = i;
-    }
-    return false;
+void Polygon::intersects(const GolfEngine::SegmentBatch &segments, unsigned char *crossed) const
+{
+    GolfEngine::PolygonKernel::crossesSegments(this->getWorldEdges(), segments, crossed);
 }
 
 bool Polygon::intersects(const Polygon& other) const
 {
-    if (*this == other)
-    {
-        return true;
-    }
-    // Check to see if the given polygon intersects
-    // any of the lines formed by each consecutive vertex
-    // on the polygon.
-    uint j = this->getVertexCount() - 1;
-    for (uint i = 0; i < this->getVertexCount(); i++)
+    // Check to see if any of this polygon's edges cross the other's, all in world space.
+    // Edges are handed over in fixed size batches, so nothing needs allocating.
+    const std::size_t batch_size = 64;
+    unsigned char crossed[batch_size];
+    GolfEngine::EdgeList edges = this->getWorldEdges();
+    for (std::size_t start = 0; start < edges.count; start += batch_size)
     {
-        GolfEngine::Vector2 a = this->getPoint(i);
-        GolfEngine::Vector2 b = this->getPoint(j);
-
-        GolfEngine::Line edge(a, b);
-        if (other.intersects(edge))
+        GolfEngine::SegmentBatch segments;
+        segments.a_x = edges.a_x + start;
+        segments.a_y = edges.a_y + start;
+        segments.b_x = edges.b_x + start;
+        segments.b_y = edges.b_y + start;
+        segments.count = std::min(batch_size, edges.count - start);
+        other.intersects(segments, crossed);
+        for (std::size_t i = 0; i < segments.count; i++)
         {
-            return true;
+            if (crossed[i])
+            {
+                return true;
+            }
         }
-
-        j = i;
     }
     return false;
 }
@@ -188,7 +363,7 @@ bool Polygon::intersects(const Polygon& other) const
 bool Polygon::operator==(const Polygon &other) const
 {
     // First, check that they are of the same cardinality.
-    if (!(this->getMaxVertices() == other.getMaxVertices() && this->getVertexCount() == other.getVertexCount()))
+    if (this->getVertexCount() != other.getVertexCount())
     {
         return false;
     }
@@ -206,11 +381,12 @@ bool Polygon::operator==(const Polygon &other) const
 bool Polygon::intersects(const GolfEngine::Circle& circle) const
 {
     // Check if any of the lines formed by consecutive vertices intersect the circle.
+    const std::vector<GolfEngine::Vector2> &world = this->getWorldVertices();
     uint j = this->getVertexCount() - 1;
     for (uint i = 0; i < this->getVertexCount(); i++)
     {
-        GolfEngine::Vector2 a = this->localToWorld(this->getPoint(i));
-        GolfEngine::Vector2 b = this->localToWorld(this->getPoint(j));
+        const GolfEngine::Vector2 &a = world[i];
+        const GolfEngine::Vector2 &b = world[j];
 
         GolfEngine::Line edge(a, b);
         if (circle.intersects(edge))
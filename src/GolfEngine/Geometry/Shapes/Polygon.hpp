@@ -13,8 +13,9 @@
 #include "Circle.hpp"
 #include "../Vector2.hpp"
 #include "../Line.hpp"
+#include "../../Physics/AABB.hpp"
+#include "../../Physics/PolygonKernel.hpp"
 #include <stdexcept>
-#include <SFML/Graphics.hpp>
 #include <vector>
 
 namespace GolfEngine
@@ -29,30 +30,39 @@ namespace GolfEngine
         */
         static const unsigned int MIN_POSSIBLE_VERTICES = 3;
 
+        /**
+         * @brief Polygons with at most this many vertices keep them inline, without a heap allocation.
+         */
+        static const unsigned int INLINE_VERTICES = 8;
+
         Polygon() : GolfEngine::Shape()
         {
-            this->vertices = new GolfEngine::Vector2[this->getMaxVertices()];
-            this->setVertexCount(0);
+            this->initializeVertices(Polygon::INLINE_VERTICES);
         }
 
         Polygon(uint max_vertices) : GolfEngine::Shape()
         {
-            this->setMaxVertices(max_vertices);
-            this->vertices = new GolfEngine::Vector2[this->getMaxVertices()];
-            this->setVertexCount(0);
+            this->initializeVertices(max_vertices);
         }
 
         Polygon(GolfEngine::Vector2 pos) : GolfEngine::Shape(pos)
         {
-            this->vertices = new GolfEngine::Vector2[this->getMaxVertices()];
-            this->setVertexCount(0);
+            this->initializeVertices(Polygon::INLINE_VERTICES);
         }
 
         Polygon(GolfEngine::Vector2 pos, uint max_vertices) : GolfEngine::Shape(pos)
         {
-            this->setMaxVertices(max_vertices);
-            this->vertices = new GolfEngine::Vector2[this->getMaxVertices()];
-            this->setVertexCount(0);
+            this->initializeVertices(max_vertices);
+        }
+
+        Polygon(const Polygon &other);
+        Polygon(Polygon &&other);
+        Polygon &operator=(const Polygon &other);
+        Polygon &operator=(Polygon &&other);
+
+        virtual ~Polygon()
+        {
+            this->releaseVertices();
         }
 
         /**
@@ -78,6 +88,8 @@ namespace GolfEngine
         /**
          * @brief Add a point to the polygon.
          *
+         * If the polygon is full, its max vertices is doubled.
+         *
          * @param point The point to add to the polygon.
          * @note Points must be added either CLOCKWISE or COUNTER-CLOCKWISE.
          */
@@ -92,11 +104,12 @@ namespace GolfEngine
          */
         inline void setPoint(uint i, GolfEngine::Vector2 point)
         {
-            if (i > this->getVertexCount())
+            if (i >= this->getVertexCount())
             {
                 throw std::length_error("Cannot set a point outside of current polygon vertex count.");
             }
             this->vertices[i] = point;
+            this->invalidate();
         }
 
         /**
@@ -107,13 +120,43 @@ namespace GolfEngine
          */
         inline GolfEngine::Vector2 getPoint(uint i) const
         {
-            if (i > this->getVertexCount())
+            if (i >= this->getVertexCount())
             {
                 throw std::out_of_range("Cannot get a point outside of current polygon vertex count.");
             }
             return this->vertices[i];
         }
 
+        /**
+         * @brief Get the vertices of the polygon, in world space.
+         *
+         * These are cached, and only recalculated after a point or the origin changes.
+         *
+         * @returns The vertices, offset by the polygon's origin.
+         */
+        const std::vector<GolfEngine::Vector2> &getWorldVertices() const;
+
+        /**
+         * @brief Get the edges of the polygon, in world space, as structure-of-arrays.
+         *
+         * Edge i runs from vertex i to vertex i + 1. These are cached alongside the world vertices.
+         *
+         * @returns The edges. Only valid until a point or the origin changes.
+         */
+        GolfEngine::EdgeList getWorldEdges() const;
+
+        /**
+         * @brief Get the bounding box of the polygon, in world space.
+         *
+         * @returns Box holding every vertex.
+         */
+        inline GolfEngine::AABB getBounds() const
+        {
+            this->updateCache(Polygon::CACHED_BOUNDS);
+            GolfEngine::Vector2 origin = this->getOrigin();
+            return GolfEngine::AABB(this->local_bounds.min_x + origin.x, this->local_bounds.min_y + origin.y, this->local_bounds.max_x + origin.x, this->local_bounds.max_y + origin.y);
+        }
+
         /**
          * @brief Check whether the polygon is interesecting a line.
          *
@@ -122,9 +165,23 @@ namespace GolfEngine
          */
         virtual bool intersects(const GolfEngine::Line& line) const;
 
+        /**
+         * @brief Check which of a batch of segments intersect the polygon's edges.
+         *
+         * Gives the same answers as calling \ref intersects(const GolfEngine::Line&) const "intersects" on each segment,
+         * but tests several segments at once. See \ref GolfEngine::PolygonKernel.
+         *
+         * @param segments Segments to check, in world space.
+         * @param crossed Set to 1 for every segment intersecting the polygon, 0 otherwise. Must hold segments.count elements.
+         */
+        void intersects(const GolfEngine::SegmentBatch &segments, unsigned char *crossed) const;
+
         /**
          * @brief Check if the polygon is intersecting another polygon.
          *
+         * Only edge crossings count, so a polygon entirely inside of the other does not intersect it.
+         * For overlap depth and direction, see \ref GolfEngine::Narrowphase::polygonPolygon.
+         *
          * @param other Polygon to compare against.
          * @returns True if there is an intersection, false otherwise.
          */
@@ -150,20 +207,106 @@ namespace GolfEngine
             return polygon.intersects(circle);
         }
 
-        virtual float getPerimeter() const;
-        virtual float getArea() const;
+        virtual GolfEngine::Scalar getPerimeter() const;
+        virtual GolfEngine::Scalar getArea() const;
         virtual GolfEngine::Vector2 getCentroid() const;
         virtual bool contains(const Vector2& point) const;
+
+        /**
+         * @brief Check which of a batch of points are inside of the polygon.
+         *
+         * Gives the same answers as calling \ref contains(const Vector2&) const "contains" on each point,
+         * but tests several points at once. See \ref GolfEngine::PolygonKernel.
+         *
+         * @param x X coordinates of the points, in world space.
+         * @param y Y coordinates of the points, in world space.
+         * @param count Amount of points.
+         * @param inside Set to 1 for every point inside of the polygon, 0 otherwise. Must hold count elements.
+         */
+        void contains(const GolfEngine::Scalar *x, const GolfEngine::Scalar *y, std::size_t count, unsigned char *inside) const;
+
         virtual void render(sf::RenderWindow *window);
 
+        /**
+         * @brief Compare the vertices of two polygons.
+         *
+         * @note Only the vertices are compared, not the max vertices or origin.
+         */
         bool operator==(const Polygon &other) const;
         inline bool operator!=(const Polygon &other) const { return !(*this == other); }
 
     private:
+        // Bits of cached_flags, one per piece of derived data.
+        static const unsigned int CACHED_AREA = 1 << 0;
+        static const unsigned int CACHED_PERIMETER = 1 << 1;
+        static const unsigned int CACHED_CENTROID = 1 << 2;
+        static const unsigned int CACHED_BOUNDS = 1 << 3;
+
         uint max_vertices;
         uint vertex_count;
 
+        // Points at inline_vertices, unless max_vertices is greater than INLINE_VERTICES.
         GolfEngine::Vector2 *vertices;
+        GolfEngine::Vector2 inline_vertices[Polygon::INLINE_VERTICES];
+
+        // Derived data, filled in on first use after a change.
+        mutable unsigned int cached_flags;
+        mutable GolfEngine::Scalar area;
+        mutable GolfEngine::Scalar perimeter;
+        mutable GolfEngine::Vector2 centroid;
+        mutable GolfEngine::AABB local_bounds;
+        mutable std::vector<GolfEngine::Vector2> world_vertices;
+        // World edge i runs from vertex i to vertex i + 1, with coordinates laid out as a_x, a_y, b_x, b_y blocks.
+        mutable std::vector<GolfEngine::Scalar> world_edges;
+        // Origin world_vertices was built for, and whether it is valid at all.
+        mutable GolfEngine::Vector2 world_origin;
+        mutable bool world_valid;
+
+        /**
+         * @brief Set up empty vertex storage.
+         *
+         * @param max_vertices Max vertices of the polygon.
+         * @throws std::out_of_range If the value is less than 3.
+         */
+        void initializeVertices(uint max_vertices);
+
+        /**
+         * @brief Free the vertex storage, if it is on the heap.
+         */
+        inline void releaseVertices()
+        {
+            if (this->vertices != this->inline_vertices)
+            {
+                delete[] this->vertices;
+            }
+            this->vertices = this->inline_vertices;
+        }
+
+        /**
+         * @brief Take on the vertices and cached data of another polygon.
+         */
+        void copyFrom(const Polygon &other);
+
+        /**
+         * @brief Forget every piece of derived data.
+         */
+        inline void invalidate()
+        {
+            this->cached_flags = 0;
+            this->world_valid = false;
+        }
+
+        /**
+         * @brief Calculate whichever requested pieces of derived data are not already cached.
+         *
+         * @param wanted CACHED_* bits to fill in.
+         */
+        void updateCache(unsigned int wanted) const;
+
+        /**
+         * @brief Rebuild the world vertices and edges, if the points or origin have changed since they were built.
+         */
+        void updateWorldCache() const;
 
         /**
          * @brief Set the max vertices of the polygon.
@@ -194,6 +337,7 @@ namespace GolfEngine
                 throw std::length_error("Vertex count cannot exceed max vertices.");
             }
             this->vertex_count = new_count;
+            this->invalidate();
         }
     };
 }
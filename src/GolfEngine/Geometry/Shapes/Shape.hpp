@@ -13,7 +13,7 @@
 #include "../../Rendering/RenderableVisitor.hpp"
 #include "../Vector2.hpp"
 #include "../Line.hpp"
-#include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <stdexcept>
 
 namespace GolfEngine
@@ -51,14 +51,14 @@ namespace GolfEngine
          *
          * @returns Perimeter of the shape
          */
-        virtual float getPerimeter() const = 0;
+        virtual GolfEngine::Scalar getPerimeter() const = 0;
 
         /**
          * @brief Returns the area of the shape.
          *
          * @returns Area of the shape.
          */
-        virtual float getArea() const = 0;
+        virtual GolfEngine::Scalar getArea() const = 0;
 
         /**
          * @brief Get the "centroid" of the shape.
@@ -78,10 +78,15 @@ namespace GolfEngine
             {
                 throw std::out_of_range("Color must be int containing three bytes (R, G, B) in form 0xRRGGBB.");
             }
-            this->color = sf::Color((rgb << 8) | 0xFF);
+            this->color = (rgb << 8) | 0xFF;
         }
 
-        inline sf::Color getColor() const
+        /**
+         * @brief Get the shape's color.
+         *
+         * @returns The color as 0xRRGGBBAA.
+         */
+        inline std::uint32_t getColor() const
         {
             return this->color;
         }
@@ -91,7 +96,12 @@ namespace GolfEngine
         }
 
     private:
-        sf::Color color;
+        /**
+         * @brief Color stored as 0xRRGGBBAA.
+         *
+         * Kept as a plain integer so that headless builds never need SFML.
+         */
+        std::uint32_t color;
     };
 }
 
@@ -7,6 +7,7 @@
 */
 
 #include "Vector2.hpp"
-using GolfEngine::Vector2;
 
-const Vector2 Vector2::zero = Vector2(0.0, 0.0);
+template class GolfEngine::BasicVector2<float>;
+template class GolfEngine::BasicVector2<double>;
+template class GolfEngine::BasicVector2<GolfEngine::Fixed>;
@@ -2,6 +2,10 @@
  * @file Vector2.hpp
  * @brief This file contains the decleration for the Vector2 class.
  *
+ * Vector2 is a BasicVector2 over the engine's scalar type, which is float unless
+ * GOLFENGINE_DOUBLE_PRECISION is defined. Vector2f, Vector2d and the fixed-point Vector2x
+ * are always available for code that needs a particular precision, e.g. offline analysis.
+ *
  * @author Willow Ciesialka
  * @date 2023-06-02
  */
@@ -10,27 +14,35 @@
 #define VECTOR2_H
 
 #include <iostream>
-#include <math.h>
-
-#define SQR(a) (a * a)
+#include <cmath>
+#include "Fixed.hpp"
 
 namespace GolfEngine
 {
-    class Vector2
+    template <typename Scalar>
+    class BasicVector2
     {
     public:
+        typedef Scalar ScalarType;
+
         // Vector properties
 
-        double x;
-        double y;
+        Scalar x;
+        Scalar y;
 
-        Vector2() : x(0), y(0){};
-        Vector2(double x_, double y_) : x(x_), y(y_){};
+        constexpr BasicVector2() : x(0), y(0){};
+        constexpr BasicVector2(Scalar x_, Scalar y_) : x(x_), y(y_){};
+
+        /**
+         * @brief Convert a vector of another precision.
+         */
+        template <typename Other>
+        constexpr explicit BasicVector2(const BasicVector2<Other> &other) : x(Scalar(other.x)), y(Scalar(other.y)){}
 
         /**
          * @brief The zero vector is a vector with zero length and undefined direction.
          */
-        static const Vector2 zero;
+        static const BasicVector2 zero;
 
         /**
          * @brief Returns the square of the vector's magnitude (length)
@@ -38,7 +50,7 @@ namespace GolfEngine
          * @return The square of the vector's magnitude.
          * @note Magnitude is returned by \ref magnitude "magnitude()" function.
          */
-        inline double magnitudeSqr() const { return SQR(this->x) + SQR(this->y); }
+        constexpr Scalar magnitudeSqr() const { return (this->x * this->x) + (this->y * this->y); }
 
         /**
          * @brief Returns the vector's magnitude (length).
@@ -46,7 +58,11 @@ namespace GolfEngine
          * @return The vector's magnitude.
          * @note This function uses \ref magnitudeSqr "mangitudeSqr()" internally.
          */
-        inline double magnitude() const { return sqrt(this->magnitudeSqr()); };
+        inline Scalar magnitude() const
+        {
+            using std::sqrt;
+            return sqrt(this->magnitudeSqr());
+        };
 
         /**
          * @brief Returns the normalized form of the vector.
@@ -56,9 +72,7 @@ namespace GolfEngine
          *
          * @return Normalized form of the vector.
          */
-        inline Vector2 normalized() const { return Vector2(
-            SQR(this->x) / this->magnitudeSqr(),
-            SQR(this->y) / this->magnitudeSqr()); }
+        inline BasicVector2 normalized() const { return *this / this->magnitude(); }
 
         // Vector-Vector Arithmetic
 
@@ -68,9 +82,9 @@ namespace GolfEngine
          * @return The square of the distance between two vectors.
          * @note The distance between two vectors is returned by \ref distance "distance(Vector2)"
          */
-        inline double distanceSqr(const Vector2 &other) const
+        constexpr Scalar distanceSqr(const BasicVector2 &other) const
         {
-            return SQR((this->x - other.x)) + SQR((this->y - other.y));
+            return (*this - other).magnitudeSqr();
         }
 
         /**
@@ -82,77 +96,96 @@ namespace GolfEngine
          * @return The distance between two vectors.
          * @note This function uses \ref distanceSqr "distanceSqr(Vector2)" internally.
          */
-        inline double distance(const Vector2 &other) const
+        inline Scalar distance(const BasicVector2 &other) const
         {
+            using std::sqrt;
             return sqrt(this->distanceSqr(other));
         }
 
-        inline Vector2 operator+(const Vector2 &rhs) const
+        constexpr BasicVector2 operator+(const BasicVector2 &rhs) const
         {
-            return Vector2(
+            return BasicVector2(
                 this->x + rhs.x,
                 this->y + rhs.y);
         }
-        inline Vector2 operator-(const Vector2 &rhs) const
+        constexpr BasicVector2 operator-(const BasicVector2 &rhs) const
         {
-            return Vector2(
+            return BasicVector2(
                 this->x - rhs.x,
                 this->y - rhs.y);
         }
-        inline Vector2 &operator+=(const Vector2 &rhs)
+        inline BasicVector2 &operator+=(const BasicVector2 &rhs)
         {
             this->x += rhs.x;
             this->y += rhs.y;
             return *this;
         }
-        inline Vector2 &operator-=(const Vector2 &rhs)
+        inline BasicVector2 &operator-=(const BasicVector2 &rhs)
         {
             this->x -= rhs.x;
             this->y -= rhs.y;
             return *this;
         }
-        inline double operator*(const Vector2 &rhs) const
+        constexpr Scalar operator*(const BasicVector2 &rhs) const
         {
             return (this->x * rhs.x) + (this->y * rhs.y);
         }
 
         // Vector-Scalar Arithmetic
-        inline Vector2 operator*(double scalar) const
+        constexpr BasicVector2 operator*(Scalar scalar) const
         {
-            return Vector2(
+            return BasicVector2(
                 this->x * scalar,
                 this->y * scalar);
         }
-        inline Vector2 operator/(double scalar) const
+        constexpr BasicVector2 operator/(Scalar scalar) const
         {
-            return Vector2(
+            return BasicVector2(
                 this->x / scalar,
                 this->y / scalar);
         }
-        inline friend Vector2 operator*(double scalar, const Vector2 &vec)
+        constexpr friend BasicVector2 operator*(Scalar scalar, const BasicVector2 &vec)
         {
             return vec * scalar;
         }
 
         // Comparison
-        inline bool operator==(const Vector2 &rhs) const
+        constexpr bool operator==(const BasicVector2 &rhs) const
         {
             return this->x == rhs.x && this->y == rhs.y;
         }
-        inline bool operator!=(const Vector2 &rhs) const
+        constexpr bool operator!=(const BasicVector2 &rhs) const
         {
             return !(*this == rhs);
         }
 
         // tostring
-        inline friend std::ostream &operator<<(std::ostream &os, const Vector2 &vec)
+        inline friend std::ostream &operator<<(std::ostream &os, const BasicVector2 &vec)
         {
             os << "Vector2(" << vec.x << ", " << vec.y << ")";
             return os;
         };
     };
-}
 
-#undef SQR
+    template <typename Scalar>
+    const BasicVector2<Scalar> BasicVector2<Scalar>::zero = BasicVector2<Scalar>(0, 0);
+
+    typedef BasicVector2<float> Vector2f;
+    typedef BasicVector2<double> Vector2d;
+    typedef BasicVector2<GolfEngine::Fixed> Vector2x;
+
+#ifdef GOLFENGINE_DOUBLE_PRECISION
+    typedef double Scalar;
+#else
+    typedef float Scalar;
+#endif
+
+    typedef BasicVector2<GolfEngine::Scalar> Vector2;
+
+    // Every precision is instantiated once, in Vector2.cpp.
+    extern template class BasicVector2<float>;
+    extern template class BasicVector2<double>;
+    extern template class BasicVector2<GolfEngine::Fixed>;
+}
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,45 @@
+/**
+ * @file AABB.hpp
+ * @brief This file defines the AABB helper struct.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-26
+ */
+
+#ifndef AABB_H
+#define AABB_H
+
+#include "../Geometry/Vector2.hpp"
+#include <vector>
+
+namespace GolfEngine
+{
+    /**
+     * @brief An axis-aligned bounding box, in world space.
+     */
+    struct AABB
+    {
+        GolfEngine::Scalar min_x;
+        GolfEngine::Scalar min_y;
+        GolfEngine::Scalar max_x;
+        GolfEngine::Scalar max_y;
+
+        AABB() : min_x(0), min_y(0), max_x(0), max_y(0){};
+        AABB(GolfEngine::Scalar min_x, GolfEngine::Scalar min_y, GolfEngine::Scalar max_x, GolfEngine::Scalar max_y) : min_x(min_x), min_y(min_y), max_x(max_x), max_y(max_y){};
+
+        /**
+         * @brief Returns whether the box overlaps another box. Touching boxes count as overlapping.
+         *
+         * @param other Box to compare against.
+         * @returns True if the boxes overlap, false otherwise.
+         */
+        inline bool overlaps(const AABB &other) const
+        {
+            return this->min_x <= other.max_x && other.min_x <= this->max_x && this->min_y <= other.max_y && other.min_y <= this->max_y;
+        }
+
+        typedef std::vector<AABB> AABBList;
+    };
+}
+
+#endif
@@ -0,0 +1,26 @@
+/**
+ * @file Broadphase.cpp
+ * @brief This file contains definitions for the Broadphase abstract class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-26
+ */
+
+#include "Broadphase.hpp"
+#include "UniformGridBroadphase.hpp"
+#include "SweepAndPruneBroadphase.hpp"
+
+using GolfEngine::Broadphase;
+
+Broadphase *Broadphase::create(GolfEngine::BroadphaseStrategy strategy)
+{
+    switch (strategy)
+    {
+    case GolfEngine::BroadphaseStrategy::UNIFORM_GRID:
+        return new GolfEngine::UniformGridBroadphase();
+    case GolfEngine::BroadphaseStrategy::SWEEP_AND_PRUNE:
+        return new GolfEngine::SweepAndPruneBroadphase();
+    default:
+        return new GolfEngine::BruteForceBroadphase();
+    }
+}
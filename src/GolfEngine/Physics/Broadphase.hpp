@@ -0,0 +1,97 @@
+/**
+ * @file Broadphase.hpp
+ * @brief This file contains declerations for the Broadphase abstract class.
+ *
+ * A broadphase takes the bounds of every collidable body and cheaply narrows the set of
+ * pairs that could be colliding. Only those candidate pairs are handed to the (expensive)
+ * narrowphase shape tests.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-26
+ */
+
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include "AABB.hpp"
+#include <vector>
+
+namespace GolfEngine
+{
+    /**
+     * @brief A pair of body indices whose bounds overlap. a is always less than b.
+     */
+    struct CandidatePair
+    {
+        unsigned int a;
+        unsigned int b;
+
+        CandidatePair(unsigned int a, unsigned int b) : a(a), b(b){};
+
+        typedef std::vector<CandidatePair> CandidatePairList;
+    };
+
+    enum BroadphaseStrategy
+    {
+        BRUTE_FORCE,
+        UNIFORM_GRID,
+        SWEEP_AND_PRUNE
+    };
+
+    class Broadphase
+    {
+    public:
+        virtual ~Broadphase() {}
+
+        /**
+         * @brief Find every pair of overlapping bounds.
+         *
+         * @param bounds Bounds of every body, indexed by body.
+         * @param pairs List to append candidate pairs to. Each pair is reported once.
+         */
+        virtual void findPairs(const GolfEngine::AABB::AABBList &bounds, GolfEngine::CandidatePair::CandidatePairList &pairs) = 0;
+
+        /**
+         * @brief Get the strategy the broadphase implements.
+         *
+         * @returns The broadphase's strategy.
+         */
+        virtual GolfEngine::BroadphaseStrategy getStrategy() const = 0;
+
+        /**
+         * @brief Create a broadphase implementing a strategy.
+         *
+         * @param strategy Strategy to use.
+         * @returns A new broadphase. The caller owns it.
+         */
+        static Broadphase *create(GolfEngine::BroadphaseStrategy strategy);
+    };
+
+    /**
+     * @brief Tests every pair of bounds. O(n²), but has no overhead - useful as a baseline.
+     */
+    class BruteForceBroadphase : public GolfEngine::Broadphase
+    {
+    public:
+        inline void findPairs(const GolfEngine::AABB::AABBList &bounds, GolfEngine::CandidatePair::CandidatePairList &pairs)
+        {
+            for (unsigned int i = 0; i < bounds.size(); i++)
+            {
+                for (unsigned int j = i + 1; j < bounds.size(); j++)
+                {
+                    if (bounds[i].overlaps(bounds[j]))
+                    {
+                        pairs.push_back(GolfEngine::CandidatePair(i, j));
+                    }
+                }
+            }
+        }
+
+        inline GolfEngine::BroadphaseStrategy getStrategy() const
+        {
+            return GolfEngine::BroadphaseStrategy::BRUTE_FORCE;
+        }
+    };
+}
+
+#endif
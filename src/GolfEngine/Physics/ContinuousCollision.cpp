@@ -0,0 +1,92 @@
+/**
+ * @file ContinuousCollision.cpp
+ * @brief This file contains definitions for the ContinuousCollision class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-28
+ */
+
+#include "ContinuousCollision.hpp"
+#include <cmath>
+
+using GolfEngine::ContinuousCollision;
+
+/**
+ * @brief Sweep a circle against a single point (a segment's endpoint).
+ */
+static bool sweepCirclePoint(const GolfEngine::Vector2 &center, const GolfEngine::Vector2 &motion, double radius, const GolfEngine::Vector2 &point, GolfEngine::SweepHit &hit)
+{
+    // Solve |center + motion * t - point| = radius for the smallest t.
+    GolfEngine::Vector2 offset = center - point;
+    double a = motion * motion;
+    double b = offset * motion;
+    double c = (offset * offset) - (radius * radius);
+    if (a == 0 || b >= 0)
+    {
+        // Not moving, or moving away.
+        return false;
+    }
+    double discriminant = (b * b) - (a * c);
+    if (discriminant < 0)
+    {
+        return false;
+    }
+    double t = (c <= 0) ? 0 : (-b - std::sqrt(discriminant)) / a;
+    if (t >= hit.time)
+    {
+        return false;
+    }
+    GolfEngine::Vector2 normal = offset + (motion * t);
+    double length = normal.magnitude();
+    if (length == 0)
+    {
+        return false;
+    }
+    hit.time = t;
+    hit.normal = normal / length;
+    return true;
+}
+
+bool ContinuousCollision::sweepCircle(const GolfEngine::Vector2 &center, const GolfEngine::Vector2 &motion, double radius, const GolfEngine::Line &line, GolfEngine::SweepHit &hit)
+{
+    GolfEngine::Vector2 direction = line.b - line.a;
+    double length_sqr = direction * direction;
+    if (length_sqr == 0)
+    {
+        return sweepCirclePoint(center, motion, radius, line.a, hit);
+    }
+
+    // First, the segment's face. Orient the normal towards where the circle starts.
+    double length = std::sqrt(length_sqr);
+    GolfEngine::Vector2 normal(-direction.y / length, direction.x / length);
+    double distance = (center - line.a) * normal;
+    if (distance < 0)
+    {
+        normal = normal * -1;
+        distance = -distance;
+    }
+    double approach = motion * normal;
+    bool found = false;
+    if (approach < 0)
+    {
+        double t = (distance <= radius) ? 0 : (radius - distance) / approach;
+        if (t < hit.time)
+        {
+            // Only counts if the touching point is on the segment itself.
+            GolfEngine::Vector2 moved = center + (motion * t);
+            GolfEngine::Vector2 contact = moved - (normal * ((moved - line.a) * normal));
+            double along = ((contact - line.a) * direction) / length_sqr;
+            if (along >= 0 && along <= 1)
+            {
+                hit.time = t;
+                hit.normal = normal;
+                found = true;
+            }
+        }
+    }
+
+    // Then, the rounded ends.
+    found = sweepCirclePoint(center, motion, radius, line.a, hit) || found;
+    found = sweepCirclePoint(center, motion, radius, line.b, hit) || found;
+    return found;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file ContinuousCollision.hpp
+ * @brief This file contains declerations for the ContinuousCollision class.
+ *
+ * Continuous collision sweeps a circle along its motion for a step and finds the first point
+ * it would touch a wall, instead of only checking where it ends up. Fast balls can then move
+ * many times their own radius in a single step without tunnelling through walls.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-28
+ */
+
+#ifndef CONTINUOUSCOLLISION_H
+#define CONTINUOUSCOLLISION_H
+
+#include "../Geometry/Vector2.hpp"
+#include "../Geometry/Line.hpp"
+
+namespace GolfEngine
+{
+    /**
+     * @brief Where a swept circle first touches something.
+     */
+    struct SweepHit
+    {
+        /**
+         * @brief Time of impact, as a fraction of the motion in [0, 1].
+         */
+        double time;
+        /**
+         * @brief Unit normal of the surface at the point of impact, pointing back towards the circle.
+         */
+        GolfEngine::Vector2 normal;
+
+        SweepHit() : time(1), normal(GolfEngine::Vector2::zero){};
+    };
+
+    class ContinuousCollision
+    {
+    public:
+        /**
+         * @brief Sweep a circle against a line segment.
+         *
+         * @param center Center of the circle at the start of the motion.
+         * @param motion Displacement of the circle over the motion.
+         * @param radius Radius of the circle.
+         * @param line Segment to sweep against, in the same space as the circle.
+         * @param hit Filled in with the impact, if there is one earlier than hit.time. Lets several segments be swept into one hit.
+         * @returns True if the circle touches the segment before hit.time, false otherwise.
+         * @note Circles that start out overlapping the segment only hit it if they are moving further into it.
+         */
+        static bool sweepCircle(const GolfEngine::Vector2 &center, const GolfEngine::Vector2 &motion, double radius, const GolfEngine::Line &line, GolfEngine::SweepHit &hit);
+
+        /**
+         * @brief Reflect a vector off of a surface.
+         *
+         * @param vec Vector to reflect.
+         * @param normal Unit normal of the surface.
+         * @param restitution Fraction of the vector's normal component to keep, in [0, 1].
+         * @returns The reflected vector. Vectors already moving away from the surface are returned unchanged.
+         */
+        static inline GolfEngine::Vector2 reflect(const GolfEngine::Vector2 &vec, const GolfEngine::Vector2 &normal, double restitution)
+        {
+            double into = vec * normal;
+            if (into >= 0)
+            {
+                return vec;
+            }
+            return vec - (normal * ((1 + restitution) * into));
+        }
+    };
+}
+
+#endif
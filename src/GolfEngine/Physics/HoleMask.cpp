@@ -0,0 +1,163 @@
+/**
+ * @file HoleMask.cpp
+ * @brief This file contains definitions for the HoleMask class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-28
+ */
+
+#include "HoleMask.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using GolfEngine::HoleMask;
+
+// Margin kept between a hole's edge and any cell marked EMPTY or FULL, to absorb rounding in the exact tests.
+static const double EDGE_MARGIN = 1e-4;
+
+/**
+ * @brief Check if a segment touches a rectangle, using Liang-Barsky clipping.
+ */
+static bool segmentTouchesRect(const GolfEngine::Vector2 &a, const GolfEngine::Vector2 &b, double min_x, double min_y, double max_x, double max_y)
+{
+    double t0 = 0, t1 = 1;
+    double d[2] = {b.x - a.x, b.y - a.y};
+    double p[2] = {a.x, a.y};
+    double lo[2] = {min_x, min_y};
+    double hi[2] = {max_x, max_y};
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (d[axis] == 0)
+        {
+            if (p[axis] < lo[axis] || p[axis] > hi[axis])
+            {
+                return false;
+            }
+            continue;
+        }
+        double t_near = (lo[axis] - p[axis]) / d[axis];
+        double t_far = (hi[axis] - p[axis]) / d[axis];
+        if (t_near > t_far)
+        {
+            std::swap(t_near, t_far);
+        }
+        t0 = std::max(t0, t_near);
+        t1 = std::min(t1, t_far);
+        if (t0 > t1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+HoleMask::HoleMask(double extent, unsigned int cells_per_side) : cells_per_side(cells_per_side)
+{
+    if (!(extent > 0) || cells_per_side == 0)
+    {
+        throw std::domain_error("Hole mask extent and cell count must be greater than 0.");
+    }
+    this->cell_size = extent / cells_per_side;
+    this->inverse_cell_size = cells_per_side / extent;
+    this->coverage.assign(cells_per_side * cells_per_side, GolfEngine::HoleCoverage::EMPTY);
+}
+
+void HoleMask::build(const GolfEngine::Circle::CircleList &circles, const GolfEngine::Polygon::PolygonList &polygons)
+{
+    std::fill(this->coverage.begin(), this->coverage.end(), (unsigned char)(GolfEngine::HoleCoverage::EMPTY));
+    for (const GolfEngine::Circle &circle : circles)
+    {
+        this->rasterize(circle);
+    }
+    for (const GolfEngine::Polygon &polygon : polygons)
+    {
+        this->rasterize(polygon);
+    }
+}
+
+bool HoleMask::cellRange(double min_x, double min_y, double max_x, double max_y, unsigned int &x0, unsigned int &y0, unsigned int &x1, unsigned int &y1) const
+{
+    double last = this->cells_per_side - 1;
+    double fx0 = std::floor(min_x * this->inverse_cell_size) - 1, fx1 = std::floor(max_x * this->inverse_cell_size) + 1;
+    double fy0 = std::floor(min_y * this->inverse_cell_size) - 1, fy1 = std::floor(max_y * this->inverse_cell_size) + 1;
+    if (!(fx1 >= 0 && fy1 >= 0 && fx0 <= last && fy0 <= last))
+    {
+        return false;
+    }
+    x0 = (unsigned int)std::max(fx0, 0.0);
+    y0 = (unsigned int)std::max(fy0, 0.0);
+    x1 = (unsigned int)std::min(fx1, last);
+    y1 = (unsigned int)std::min(fy1, last);
+    return true;
+}
+
+void HoleMask::rasterize(const GolfEngine::Circle &circle)
+{
+    GolfEngine::Vector2 center = circle.getCentroid();
+    double radius = circle.getRadius();
+    unsigned int x0, y0, x1, y1;
+    if (!this->cellRange(center.x - radius, center.y - radius, center.x + radius, center.y + radius, x0, y0, x1, y1))
+    {
+        return;
+    }
+    for (unsigned int y = y0; y <= y1; y++)
+    {
+        double min_y = y * this->cell_size, max_y = min_y + this->cell_size;
+        for (unsigned int x = x0; x <= x1; x++)
+        {
+            double min_x = x * this->cell_size, max_x = min_x + this->cell_size;
+            // Nearest and farthest points of the cell from the center.
+            double near_x = std::max(min_x, std::min((double)center.x, max_x)) - center.x;
+            double near_y = std::max(min_y, std::min((double)center.y, max_y)) - center.y;
+            double far_x = std::max(std::abs(min_x - center.x), std::abs(max_x - center.x));
+            double far_y = std::max(std::abs(min_y - center.y), std::abs(max_y - center.y));
+            if (std::sqrt((far_x * far_x) + (far_y * far_y)) < radius - EDGE_MARGIN)
+            {
+                this->cover(x, y, GolfEngine::HoleCoverage::FULL);
+            }
+            else if (std::sqrt((near_x * near_x) + (near_y * near_y)) <= radius + EDGE_MARGIN)
+            {
+                this->cover(x, y, GolfEngine::HoleCoverage::PARTIAL);
+            }
+        }
+    }
+}
+
+void HoleMask::rasterize(const GolfEngine::Polygon &polygon)
+{
+    unsigned int count = polygon.getVertexCount();
+    if (count == 0)
+    {
+        return;
+    }
+    const std::vector<GolfEngine::Vector2> &points = polygon.getWorldVertices();
+    GolfEngine::AABB bounds = polygon.getBounds();
+    unsigned int x0, y0, x1, y1;
+    if (!this->cellRange(bounds.min_x, bounds.min_y, bounds.max_x, bounds.max_y, x0, y0, x1, y1))
+    {
+        return;
+    }
+    for (unsigned int y = y0; y <= y1; y++)
+    {
+        double cell_min_y = y * this->cell_size, cell_max_y = cell_min_y + this->cell_size;
+        for (unsigned int x = x0; x <= x1; x++)
+        {
+            double cell_min_x = x * this->cell_size, cell_max_x = cell_min_x + this->cell_size;
+            bool edge = false;
+            for (unsigned int i = 0; i < count && !edge; i++)
+            {
+                edge = segmentTouchesRect(points[i], points[(i + 1) % count], cell_min_x - EDGE_MARGIN, cell_min_y - EDGE_MARGIN, cell_max_x + EDGE_MARGIN, cell_max_y + EDGE_MARGIN);
+            }
+            if (edge)
+            {
+                this->cover(x, y, GolfEngine::HoleCoverage::PARTIAL);
+            }
+            // No edge crosses the cell, so it is either entirely in the polygon or entirely out of it.
+            else if (polygon.contains(GolfEngine::Vector2(cell_min_x + (this->cell_size / 2), cell_min_y + (this->cell_size / 2))))
+            {
+                this->cover(x, y, GolfEngine::HoleCoverage::FULL);
+            }
+        }
+    }
+}
@@ -0,0 +1,107 @@
+/**
+ * @file HoleMask.hpp
+ * @brief This file contains declerations for the HoleMask class.
+ *
+ * A HoleMask rasterizes static holes into a coverage grid, so checking whether a point is in a
+ * hole is a single lookup. Cells that a hole's edge passes through can't be answered by the
+ * grid, and are marked for an exact test instead.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-28
+ */
+
+#ifndef HOLEMASK_H
+#define HOLEMASK_H
+
+#include "../Geometry/Vector2.hpp"
+#include "../Geometry/Shapes/Circle.hpp"
+#include "../Geometry/Shapes/Polygon.hpp"
+#include <vector>
+
+namespace GolfEngine
+{
+    /**
+     * @brief How much of a cell is covered by holes.
+     */
+    enum HoleCoverage
+    {
+        EMPTY,
+        PARTIAL,
+        FULL
+    };
+
+    class HoleMask
+    {
+    public:
+        /**
+         * @brief Default amount of cells along each side of the mask.
+         */
+        static const unsigned int DEFAULT_CELLS_PER_SIDE = 64;
+
+        /**
+         * @param extent Side length of the square area, starting at (0, 0), the mask covers.
+         * @param cells_per_side Amount of cells along each side.
+         * @throws std::domain_error If the extent or cell count is not greater than 0.
+         */
+        HoleMask(double extent, unsigned int cells_per_side);
+
+        /**
+         * @brief Rebuild the mask from a set of holes.
+         *
+         * @param circles Round holes.
+         * @param polygons Polygonal holes.
+         */
+        void build(const GolfEngine::Circle::CircleList &circles, const GolfEngine::Polygon::PolygonList &polygons);
+
+        /**
+         * @brief Look up how much of the cell holding a point is covered by holes.
+         *
+         * @param point Point to look up.
+         * @returns FULL if the point is certainly in a hole, EMPTY if it certainly isn't,
+         * and PARTIAL if it needs an exact test. Points outside of the mask are always PARTIAL.
+         */
+        inline GolfEngine::HoleCoverage lookup(const GolfEngine::Vector2 &point) const
+        {
+            double x = point.x * this->inverse_cell_size;
+            double y = point.y * this->inverse_cell_size;
+            // Written so that NaN positions fail the check too.
+            if (!(x >= 0 && y >= 0 && x < this->cells_per_side && y < this->cells_per_side))
+            {
+                return GolfEngine::HoleCoverage::PARTIAL;
+            }
+            return (GolfEngine::HoleCoverage)(this->coverage[(unsigned int)x + ((unsigned int)y * this->cells_per_side)]);
+        }
+
+    private:
+        double cell_size;
+        double inverse_cell_size;
+        unsigned int cells_per_side;
+
+        // Coverage of each cell, in row order.
+        std::vector<unsigned char> coverage;
+
+        /**
+         * @brief Raise the coverage of a cell, keeping whichever is greater.
+         */
+        inline void cover(unsigned int x, unsigned int y, GolfEngine::HoleCoverage cell_coverage)
+        {
+            unsigned char &cell = this->coverage[x + (y * this->cells_per_side)];
+            if (cell_coverage > cell)
+            {
+                cell = (unsigned char)(cell_coverage);
+            }
+        }
+
+        /**
+         * @brief Convert bounds into the range of cells they overlap, padded by a cell and clamped to the mask.
+         *
+         * @returns False if the bounds are entirely outside of the mask.
+         */
+        bool cellRange(double min_x, double min_y, double max_x, double max_y, unsigned int &x0, unsigned int &y0, unsigned int &x1, unsigned int &y1) const;
+
+        void rasterize(const GolfEngine::Circle &circle);
+        void rasterize(const GolfEngine::Polygon &polygon);
+    };
+}
+
+#endif
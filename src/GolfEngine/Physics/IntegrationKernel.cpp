@@ -0,0 +1,265 @@
+/**
+ * @file IntegrationKernel.cpp
+ * @brief This file contains definitions for the IntegrationKernel class.
+ *
+ * The SIMD implementations are compiled with per-function target attributes, so the rest of the
+ * engine does not need to be built with -msse2/-mavx2, and are only ever called after the running
+ * CPU has been checked for support.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-25
+ */
+
+#include "IntegrationKernel.hpp"
+#include "SimdLanes.hpp"
+#include <stdexcept>
+
+using GolfEngine::IntegrationKernel;
+using GolfEngine::Scalar;
+
+void IntegrationKernel::integrateScalar(const GolfEngine::IntegrationBatch &batch, double dt_s, double friction)
+{
+    const Scalar dt = (Scalar)dt_s;
+    const Scalar fr = (Scalar)friction;
+    for (std::size_t i = 0; i < batch.count; i++)
+    {
+        // Acceleration feeds velocity. Anything with a magnitude under 1 snaps to zero,
+        // exactly as Entity::setVelocity and Entity::setAcceleration do.
+        Scalar dax = batch.acc_x[i] * dt;
+        Scalar day = batch.acc_y[i] * dt;
+        Scalar nvx = batch.vel_x[i] + dax;
+        Scalar nvy = batch.vel_y[i] + day;
+        if ((nvx * nvx) + (nvy * nvy) < 1)
+        {
+            nvx = 0;
+            nvy = 0;
+        }
+        Scalar nax = batch.acc_x[i] - dax;
+        Scalar nay = batch.acc_y[i] - day;
+        if ((nax * nax) + (nay * nay) < 1)
+        {
+            nax = 0;
+            nay = 0;
+        }
+        batch.acc_x[i] = nax;
+        batch.acc_y[i] = nay;
+
+        // Velocity feeds position.
+        Scalar dvx = nvx * dt;
+        Scalar dvy = nvy * dt;
+        batch.pos_x[i] += dvx;
+        batch.pos_y[i] += dvy;
+        nvx -= dvx;
+        nvy -= dvy;
+        if ((nvx * nvx) + (nvy * nvy) < 1)
+        {
+            nvx = 0;
+            nvy = 0;
+        }
+
+        // Friction.
+        nvx *= fr;
+        nvy *= fr;
+        if ((nvx * nvx) + (nvy * nvy) < 1)
+        {
+            nvx = 0;
+            nvy = 0;
+        }
+        batch.vel_x[i] = nvx;
+        batch.vel_y[i] = nvy;
+    }
+}
+
+/**
+ * @brief Integrate whatever is left over after the last full SIMD lane group.
+ */
+static inline void integrateTail(const GolfEngine::IntegrationBatch &batch, std::size_t start, double dt_s, double friction)
+{
+    if (start >= batch.count)
+    {
+        return;
+    }
+    GolfEngine::IntegrationBatch tail;
+    tail.pos_x = batch.pos_x + start;
+    tail.pos_y = batch.pos_y + start;
+    tail.vel_x = batch.vel_x + start;
+    tail.vel_y = batch.vel_y + start;
+    tail.acc_x = batch.acc_x + start;
+    tail.acc_y = batch.acc_y + start;
+    tail.count = batch.count - start;
+    IntegrationKernel::integrateScalar(tail, dt_s, friction);
+}
+
+#ifdef GOLFENGINE_X86_SIMD
+
+__attribute__((target("sse2"))) static void integrateSSE2(const GolfEngine::IntegrationBatch &batch, double dt_s, double friction)
+{
+    typedef GolfEngine::SSE2Lanes Lanes;
+    const Lanes dt = GOLFENGINE_SSE2(set1)((Scalar)dt_s);
+    const Lanes fr = GOLFENGINE_SSE2(set1)((Scalar)friction);
+    const Lanes one = GOLFENGINE_SSE2(set1)(1);
+
+    std::size_t i = 0;
+    for (; i + GolfEngine::SSE2_WIDTH <= batch.count; i += GolfEngine::SSE2_WIDTH)
+    {
+        Lanes ax = GOLFENGINE_SSE2(loadu)(batch.acc_x + i);
+        Lanes ay = GOLFENGINE_SSE2(loadu)(batch.acc_y + i);
+        Lanes vx = GOLFENGINE_SSE2(loadu)(batch.vel_x + i);
+        Lanes vy = GOLFENGINE_SSE2(loadu)(batch.vel_y + i);
+        Lanes px = GOLFENGINE_SSE2(loadu)(batch.pos_x + i);
+        Lanes py = GOLFENGINE_SSE2(loadu)(batch.pos_y + i);
+
+        // Lanes with a magnitude under 1 are masked to zero. "Not less than" keeps NaNs, as the scalar path does.
+        Lanes dax = GOLFENGINE_SSE2(mul)(ax, dt);
+        Lanes day = GOLFENGINE_SSE2(mul)(ay, dt);
+        vx = GOLFENGINE_SSE2(add)(vx, dax);
+        vy = GOLFENGINE_SSE2(add)(vy, day);
+        Lanes keep = GOLFENGINE_SSE2(cmpnlt)(GOLFENGINE_SSE2(add)(GOLFENGINE_SSE2(mul)(vx, vx), GOLFENGINE_SSE2(mul)(vy, vy)), one);
+        vx = GOLFENGINE_SSE2(and)(vx, keep);
+        vy = GOLFENGINE_SSE2(and)(vy, keep);
+
+        ax = GOLFENGINE_SSE2(sub)(ax, dax);
+        ay = GOLFENGINE_SSE2(sub)(ay, day);
+        keep = GOLFENGINE_SSE2(cmpnlt)(GOLFENGINE_SSE2(add)(GOLFENGINE_SSE2(mul)(ax, ax), GOLFENGINE_SSE2(mul)(ay, ay)), one);
+        GOLFENGINE_SSE2(storeu)(batch.acc_x + i, GOLFENGINE_SSE2(and)(ax, keep));
+        GOLFENGINE_SSE2(storeu)(batch.acc_y + i, GOLFENGINE_SSE2(and)(ay, keep));
+
+        Lanes dvx = GOLFENGINE_SSE2(mul)(vx, dt);
+        Lanes dvy = GOLFENGINE_SSE2(mul)(vy, dt);
+        GOLFENGINE_SSE2(storeu)(batch.pos_x + i, GOLFENGINE_SSE2(add)(px, dvx));
+        GOLFENGINE_SSE2(storeu)(batch.pos_y + i, GOLFENGINE_SSE2(add)(py, dvy));
+        vx = GOLFENGINE_SSE2(sub)(vx, dvx);
+        vy = GOLFENGINE_SSE2(sub)(vy, dvy);
+        keep = GOLFENGINE_SSE2(cmpnlt)(GOLFENGINE_SSE2(add)(GOLFENGINE_SSE2(mul)(vx, vx), GOLFENGINE_SSE2(mul)(vy, vy)), one);
+        vx = GOLFENGINE_SSE2(and)(vx, keep);
+        vy = GOLFENGINE_SSE2(and)(vy, keep);
+
+        vx = GOLFENGINE_SSE2(mul)(vx, fr);
+        vy = GOLFENGINE_SSE2(mul)(vy, fr);
+        keep = GOLFENGINE_SSE2(cmpnlt)(GOLFENGINE_SSE2(add)(GOLFENGINE_SSE2(mul)(vx, vx), GOLFENGINE_SSE2(mul)(vy, vy)), one);
+        GOLFENGINE_SSE2(storeu)(batch.vel_x + i, GOLFENGINE_SSE2(and)(vx, keep));
+        GOLFENGINE_SSE2(storeu)(batch.vel_y + i, GOLFENGINE_SSE2(and)(vy, keep));
+    }
+    integrateTail(batch, i, dt_s, friction);
+}
+
+__attribute__((target("avx2"))) static void integrateAVX2(const GolfEngine::IntegrationBatch &batch, double dt_s, double friction)
+{
+    typedef GolfEngine::AVX2Lanes Lanes;
+    const Lanes dt = GOLFENGINE_AVX2(set1)((Scalar)dt_s);
+    const Lanes fr = GOLFENGINE_AVX2(set1)((Scalar)friction);
+    const Lanes one = GOLFENGINE_AVX2(set1)(1);
+
+    std::size_t i = 0;
+    for (; i + GolfEngine::AVX2_WIDTH <= batch.count; i += GolfEngine::AVX2_WIDTH)
+    {
+        Lanes ax = GOLFENGINE_AVX2(loadu)(batch.acc_x + i);
+        Lanes ay = GOLFENGINE_AVX2(loadu)(batch.acc_y + i);
+        Lanes vx = GOLFENGINE_AVX2(loadu)(batch.vel_x + i);
+        Lanes vy = GOLFENGINE_AVX2(loadu)(batch.vel_y + i);
+        Lanes px = GOLFENGINE_AVX2(loadu)(batch.pos_x + i);
+        Lanes py = GOLFENGINE_AVX2(loadu)(batch.pos_y + i);
+
+        Lanes dax = GOLFENGINE_AVX2(mul)(ax, dt);
+        Lanes day = GOLFENGINE_AVX2(mul)(ay, dt);
+        vx = GOLFENGINE_AVX2(add)(vx, dax);
+        vy = GOLFENGINE_AVX2(add)(vy, day);
+        Lanes keep = GOLFENGINE_AVX2(cmp)(GOLFENGINE_AVX2(add)(GOLFENGINE_AVX2(mul)(vx, vx), GOLFENGINE_AVX2(mul)(vy, vy)), one, _CMP_NLT_UQ);
+        vx = GOLFENGINE_AVX2(and)(vx, keep);
+        vy = GOLFENGINE_AVX2(and)(vy, keep);
+
+        ax = GOLFENGINE_AVX2(sub)(ax, dax);
+        ay = GOLFENGINE_AVX2(sub)(ay, day);
+        keep = GOLFENGINE_AVX2(cmp)(GOLFENGINE_AVX2(add)(GOLFENGINE_AVX2(mul)(ax, ax), GOLFENGINE_AVX2(mul)(ay, ay)), one, _CMP_NLT_UQ);
+        GOLFENGINE_AVX2(storeu)(batch.acc_x + i, GOLFENGINE_AVX2(and)(ax, keep));
+        GOLFENGINE_AVX2(storeu)(batch.acc_y + i, GOLFENGINE_AVX2(and)(ay, keep));
+
+        Lanes dvx = GOLFENGINE_AVX2(mul)(vx, dt);
+        Lanes dvy = GOLFENGINE_AVX2(mul)(vy, dt);
+        GOLFENGINE_AVX2(storeu)(batch.pos_x + i, GOLFENGINE_AVX2(add)(px, dvx));
+        GOLFENGINE_AVX2(storeu)(batch.pos_y + i, GOLFENGINE_AVX2(add)(py, dvy));
+        vx = GOLFENGINE_AVX2(sub)(vx, dvx);
+        vy = GOLFENGINE_AVX2(sub)(vy, dvy);
+        keep = GOLFENGINE_AVX2(cmp)(GOLFENGINE_AVX2(add)(GOLFENGINE_AVX2(mul)(vx, vx), GOLFENGINE_AVX2(mul)(vy, vy)), one, _CMP_NLT_UQ);
+        vx = GOLFENGINE_AVX2(and)(vx, keep);
+        vy = GOLFENGINE_AVX2(and)(vy, keep);
+
+        vx = GOLFENGINE_AVX2(mul)(vx, fr);
+        vy = GOLFENGINE_AVX2(mul)(vy, fr);
+        keep = GOLFENGINE_AVX2(cmp)(GOLFENGINE_AVX2(add)(GOLFENGINE_AVX2(mul)(vx, vx), GOLFENGINE_AVX2(mul)(vy, vy)), one, _CMP_NLT_UQ);
+        GOLFENGINE_AVX2(storeu)(batch.vel_x + i, GOLFENGINE_AVX2(and)(vx, keep));
+        GOLFENGINE_AVX2(storeu)(batch.vel_y + i, GOLFENGINE_AVX2(and)(vy, keep));
+    }
+    integrateTail(batch, i, dt_s, friction);
+}
+
+#endif
+
+bool IntegrationKernel::isSupported(Implementation implementation)
+{
+    switch (implementation)
+    {
+    case IntegrationKernel::SCALAR:
+        return true;
+#ifdef GOLFENGINE_X86_SIMD
+    case IntegrationKernel::SSE2:
+        return __builtin_cpu_supports("sse2");
+    case IntegrationKernel::AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+IntegrationKernel::Implementation IntegrationKernel::detect()
+{
+    if (IntegrationKernel::isSupported(IntegrationKernel::AVX2))
+    {
+        return IntegrationKernel::AVX2;
+    }
+    if (IntegrationKernel::isSupported(IntegrationKernel::SSE2))
+    {
+        return IntegrationKernel::SSE2;
+    }
+    return IntegrationKernel::SCALAR;
+}
+
+IntegrationKernel::KernelFunction IntegrationKernel::getKernel(Implementation implementation)
+{
+    if (!IntegrationKernel::isSupported(implementation))
+    {
+        throw std::invalid_argument("Integration kernel implementation is not supported on this CPU.");
+    }
+    switch (implementation)
+    {
+#ifdef GOLFENGINE_X86_SIMD
+    case IntegrationKernel::SSE2:
+        return &integrateSSE2;
+    case IntegrationKernel::AVX2:
+        return &integrateAVX2;
+#endif
+    default:
+        return &IntegrationKernel::integrateScalar;
+    }
+}
+
+IntegrationKernel::Active IntegrationKernel::resolveKernel()
+{
+    Active resolved;
+    resolved.implementation = IntegrationKernel::detect();
+    resolved.kernel = IntegrationKernel::getKernel(resolved.implementation);
+    return resolved;
+}
+
+IntegrationKernel::Implementation IntegrationKernel::getImplementation()
+{
+    return IntegrationKernel::active().implementation;
+}
+
+void IntegrationKernel::setImplementation(Implementation implementation)
+{
+    Active &current = IntegrationKernel::active();
+    current.kernel = IntegrationKernel::getKernel(implementation);
+    current.implementation = implementation;
+}
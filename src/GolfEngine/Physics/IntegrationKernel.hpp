@@ -0,0 +1,129 @@
+/**
+ * @file IntegrationKernel.hpp
+ * @brief This file contains declerations for the IntegrationKernel class.
+ *
+ * The IntegrationKernel integrates acceleration, velocity and friction for a whole batch of
+ * bodies stored as structure-of-arrays of GolfEngine::Scalar. It has a scalar implementation, plus
+ * SSE2 and AVX2 implementations on x86 that are picked at runtime based on what the CPU supports.
+ * With float scalars, each SIMD register holds twice as many bodies as with doubles.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-25
+ */
+
+#ifndef INTEGRATIONKERNEL_H
+#define INTEGRATIONKERNEL_H
+
+#include "../Geometry/Vector2.hpp"
+#include <cstddef>
+
+namespace GolfEngine
+{
+    /**
+     * @brief A batch of bodies to integrate. Every array must hold at least count elements.
+     */
+    struct IntegrationBatch
+    {
+        GolfEngine::Scalar *pos_x;
+        GolfEngine::Scalar *pos_y;
+        GolfEngine::Scalar *vel_x;
+        GolfEngine::Scalar *vel_y;
+        GolfEngine::Scalar *acc_x;
+        GolfEngine::Scalar *acc_y;
+        std::size_t count;
+    };
+
+    class IntegrationKernel
+    {
+    public:
+        enum Implementation
+        {
+            SCALAR,
+            SSE2,
+            AVX2
+        };
+
+        typedef void (*KernelFunction)(const GolfEngine::IntegrationBatch &batch, double dt_s, double friction);
+
+        /**
+         * @brief Integrate a batch of bodies with the active implementation.
+         *
+         * For every body, this is equivalent to \ref GolfEngine::Entity::applyAcceleration "applyAcceleration",
+         * \ref GolfEngine::Entity::applyVelocity "applyVelocity" and then scaling velocity by the friction factor,
+         * including the rule that any velocity or acceleration with a magnitude under 1 snaps to zero.
+         * Arithmetic is done in GolfEngine::Scalar, the same way by every implementation.
+         *
+         * @param batch Bodies to integrate.
+         * @param dt_s Time, in seconds, to factor in.
+         * @param friction Factor to scale velocity by after integration.
+         */
+        static inline void integrate(const GolfEngine::IntegrationBatch &batch, double dt_s, double friction)
+        {
+            IntegrationKernel::active().kernel(batch, dt_s, friction);
+        }
+
+        /**
+         * @brief Find the fastest implementation the running CPU supports.
+         *
+         * @returns The best supported implementation.
+         */
+        static Implementation detect();
+
+        /**
+         * @brief Check whether the running CPU supports an implementation.
+         *
+         * @param implementation Implementation to check.
+         * @returns True if it can be used, false otherwise.
+         */
+        static bool isSupported(Implementation implementation);
+
+        /**
+         * @brief Get the implementation \ref integrate "integrate()" currently uses.
+         *
+         * @returns The active implementation.
+         */
+        static Implementation getImplementation();
+
+        /**
+         * @brief Force a specific implementation, e.g. for testing or benchmarking.
+         *
+         * @param implementation Implementation to use.
+         * @throws std::invalid_argument If the running CPU does not support the implementation.
+         * @note Not safe to call while other threads are integrating.
+         */
+        static void setImplementation(Implementation implementation);
+
+        /**
+         * @brief Get the kernel function for an implementation.
+         *
+         * @param implementation Implementation to get.
+         * @returns The kernel function.
+         * @throws std::invalid_argument If the running CPU does not support the implementation.
+         */
+        static KernelFunction getKernel(Implementation implementation);
+
+        static void integrateScalar(const GolfEngine::IntegrationBatch &batch, double dt_s, double friction);
+
+    private:
+        struct Active
+        {
+            Implementation implementation;
+            KernelFunction kernel;
+        };
+
+        /**
+         * @brief Get the implementation in use, picking the best one on first use.
+         *
+         * A function-local static is initialised exactly once, even if several threads get here at once.
+         */
+        static inline Active &active()
+        {
+            static Active current = IntegrationKernel::resolveKernel();
+            return current;
+        }
+
+        static Active resolveKernel();
+    };
+}
+
+#endif
@@ -0,0 +1,228 @@
+/**
+ * @file Narrowphase.cpp
+ * @brief This file contains definitions for the Narrowphase class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#include "Narrowphase.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using GolfEngine::Narrowphase;
+using GolfEngine::SeparatingAxisCache;
+
+void SeparatingAxisCache::prune()
+{
+    // Pairs that weren't tested this check have moved apart (or been removed), so forget them.
+    for (auto it = this->entries.begin(); it != this->entries.end();)
+    {
+        if (it->second.check != this->check)
+        {
+            it = this->entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    this->check++;
+}
+
+/**
+ * @brief Find the average of a polygon's vertices. Only used to orient normals, so it need not be the true centroid.
+ */
+static GolfEngine::Vector2 vertexCenter(const GolfEngine::Vector2 *vertices, std::size_t count)
+{
+    double x = 0, y = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        x += vertices[i].x;
+        y += vertices[i].y;
+    }
+    return GolfEngine::Vector2(x / count, y / count);
+}
+
+/**
+ * @brief Project a polygon onto an axis.
+ */
+static void project(const GolfEngine::Vector2 *vertices, std::size_t count, const GolfEngine::Vector2 &axis, double &min, double &max)
+{
+    min = max = vertices[0] * axis;
+    for (std::size_t i = 1; i < count; i++)
+    {
+        double d = vertices[i] * axis;
+        min = std::min(min, d);
+        max = std::max(max, d);
+    }
+}
+
+/**
+ * @brief Get the unit normal of a polygon's edge. Which side it faces depends on the polygon's winding.
+ */
+static GolfEngine::Vector2 edgeNormal(const GolfEngine::Vector2 *vertices, std::size_t count, std::size_t edge)
+{
+    GolfEngine::Vector2 along = vertices[(edge + 1) % count] - vertices[edge];
+    double length = along.magnitude();
+    if (length == 0)
+    {
+        return GolfEngine::Vector2::zero;
+    }
+    return GolfEngine::Vector2(-along.y / length, along.x / length);
+}
+
+/**
+ * @brief Find how much two polygons overlap along one of their edge normals.
+ *
+ * @returns The overlap. Negative if the axis separates them. Degenerate edges never separate anything.
+ */
+static double axisOverlap(const GolfEngine::Vector2 *a, std::size_t count_a, const GolfEngine::Vector2 *b, std::size_t count_b, const GolfEngine::Vector2 &axis)
+{
+    if (axis.x == 0 && axis.y == 0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    double min_a, max_a, min_b, max_b;
+    project(a, count_a, axis, min_a, max_a);
+    project(b, count_b, axis, min_b, max_b);
+    return std::min(max_a, max_b) - std::max(min_a, min_b);
+}
+
+bool Narrowphase::circleCircle(const GolfEngine::Vector2 &a, double radius_a, const GolfEngine::Vector2 &b, double radius_b, GolfEngine::Contact &contact)
+{
+    double reach = radius_a + radius_b;
+    GolfEngine::Vector2 offset = b - a;
+    double distance_sqr = offset.magnitudeSqr();
+    if (distance_sqr > reach * reach)
+    {
+        return false;
+    }
+    double distance = std::sqrt(distance_sqr);
+    contact.normal = (distance > 0) ? GolfEngine::Vector2(offset.x / distance, offset.y / distance) : GolfEngine::Vector2(1, 0);
+    contact.depth = reach - distance;
+    return true;
+}
+
+bool Narrowphase::polygonCircle(const GolfEngine::Vector2 *vertices, std::size_t count, const GolfEngine::Vector2 &center, double radius, GolfEngine::Contact &contact)
+{
+    if (count == 0)
+    {
+        return false;
+    }
+    // Find the closest point on the polygon's outline, and whether the center is inside of it.
+    // The center is inside of a convex polygon if it is on the same side of every edge.
+    double closest_sqr = std::numeric_limits<double>::infinity();
+    GolfEngine::Vector2 closest;
+    std::size_t closest_edge = 0;
+    bool left = false, right = false;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const GolfEngine::Vector2 &p = vertices[i];
+        GolfEngine::Vector2 along = vertices[(i + 1) % count] - p;
+        GolfEngine::Vector2 to_center = center - p;
+        double cross = (along.x * to_center.y) - (along.y * to_center.x);
+        left = left || cross > 0;
+        right = right || cross < 0;
+
+        double length_sqr = along.magnitudeSqr();
+        double t = (length_sqr > 0) ? std::max(0.0, std::min(1.0, (to_center * along) / length_sqr)) : 0;
+        GolfEngine::Vector2 point = p + (along * t);
+        double distance_sqr = center.distanceSqr(point);
+        if (distance_sqr < closest_sqr)
+        {
+            closest_sqr = distance_sqr;
+            closest = point;
+            closest_edge = i;
+        }
+    }
+    bool inside = !(left && right);
+    double distance = std::sqrt(closest_sqr);
+    if (!inside && distance > radius)
+    {
+        return false;
+    }
+
+    if (distance > 0)
+    {
+        GolfEngine::Vector2 outward = (center - closest) / distance;
+        // A center inside of the polygon has to be pushed back out through the closest point.
+        contact.normal = inside ? (outward * -1) : outward;
+    }
+    else
+    {
+        // The center is right on the outline. Push it out through the edge it is on.
+        contact.normal = edgeNormal(vertices, count, closest_edge);
+        if ((contact.normal * (center - vertexCenter(vertices, count))) < 0)
+        {
+            contact.normal = contact.normal * -1;
+        }
+    }
+    contact.depth = inside ? (radius + distance) : (radius - distance);
+    return true;
+}
+
+bool Narrowphase::polygonPolygon(const GolfEngine::Vector2 *a, std::size_t count_a, const GolfEngine::Vector2 *b, std::size_t count_b, GolfEngine::Contact &contact, GolfEngine::SeparatingAxis &cache)
+{
+    if (count_a == 0 || count_b == 0)
+    {
+        return false;
+    }
+    // Warm start: the axis that split the pair last time will usually still split it.
+    if (cache.owner == GolfEngine::SeparatingAxis::FIRST && cache.edge < count_a)
+    {
+        if (axisOverlap(a, count_a, b, count_b, edgeNormal(a, count_a, cache.edge)) < 0)
+        {
+            return false;
+        }
+    }
+    else if (cache.owner == GolfEngine::SeparatingAxis::SECOND && cache.edge < count_b)
+    {
+        if (axisOverlap(a, count_a, b, count_b, edgeNormal(b, count_b, cache.edge)) < 0)
+        {
+            return false;
+        }
+    }
+
+    double least = std::numeric_limits<double>::infinity();
+    GolfEngine::SeparatingAxis best;
+    GolfEngine::Vector2 best_axis;
+    const GolfEngine::Vector2 *polygons[2] = {a, b};
+    std::size_t counts[2] = {count_a, count_b};
+    for (unsigned int owner = 0; owner < 2; owner++)
+    {
+        for (std::size_t edge = 0; edge < counts[owner]; edge++)
+        {
+            GolfEngine::Vector2 axis = edgeNormal(polygons[owner], counts[owner], edge);
+            double overlap = axisOverlap(a, count_a, b, count_b, axis);
+            if (overlap < 0)
+            {
+                cache.owner = owner + 1;
+                cache.edge = edge;
+                return false;
+            }
+            if (overlap < least)
+            {
+                least = overlap;
+                best.owner = owner + 1;
+                best.edge = edge;
+                best_axis = axis;
+            }
+        }
+    }
+    if (best.owner == GolfEngine::SeparatingAxis::NONE)
+    {
+        // Every edge is degenerate.
+        return false;
+    }
+    cache = best;
+    // Point the normal from the first polygon towards the second.
+    if ((best_axis * (vertexCenter(b, count_b) - vertexCenter(a, count_a))) < 0)
+    {
+        best_axis = best_axis * -1;
+    }
+    contact.normal = best_axis;
+    contact.depth = least;
+    return true;
+}
@@ -0,0 +1,169 @@
+/**
+ * @file Narrowphase.hpp
+ * @brief This file contains declerations for the Narrowphase class.
+ *
+ * The narrowphase takes a pair of shapes whose bounds overlap and works out whether they actually
+ * touch, and if so, which way and how far to push them apart. Polygons are tested with the
+ * separating axis theorem, so they are treated as convex.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#ifndef NARROWPHASE_H
+#define NARROWPHASE_H
+
+#include "../Geometry/Vector2.hpp"
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+namespace GolfEngine
+{
+    /**
+     * @brief How two touching shapes overlap.
+     */
+    struct Contact
+    {
+        /**
+         * @brief Unit normal pointing from the first shape towards the second.
+         */
+        GolfEngine::Vector2 normal;
+        /**
+         * @brief How far the second shape would have to move along the normal to stop overlapping. Touching shapes have a depth of 0.
+         */
+        double depth;
+
+        Contact() : normal(GolfEngine::Vector2::zero), depth(0){};
+    };
+
+    /**
+     * @brief The last axis found between a pair of polygons, kept between frames to warm start the next test.
+     */
+    struct SeparatingAxis
+    {
+        /**
+         * @brief No axis has been found yet.
+         */
+        static const unsigned int NONE = 0;
+        /**
+         * @brief The axis is the normal of one of the first polygon's edges.
+         */
+        static const unsigned int FIRST = 1;
+        /**
+         * @brief The axis is the normal of one of the second polygon's edges.
+         */
+        static const unsigned int SECOND = 2;
+
+        unsigned int owner;
+        std::size_t edge;
+
+        SeparatingAxis() : owner(SeparatingAxis::NONE), edge(0){};
+    };
+
+    /**
+     * @brief Separating axes for pairs of bodies, kept from one collision check to the next.
+     */
+    class SeparatingAxisCache
+    {
+    public:
+        SeparatingAxisCache() : check(0){};
+
+        /**
+         * @brief Get the axis for a pair of bodies, creating an empty one if there isn't one yet.
+         *
+         * The pair is marked as used in the current check.
+         *
+         * @param first Address identifying the first body. Must be lower than second.
+         * @param second Address identifying the second body.
+         * @returns The pair's axis.
+         */
+        inline GolfEngine::SeparatingAxis &get(const void *first, const void *second)
+        {
+            Entry &entry = this->entries[Key(first, second)];
+            entry.check = this->check;
+            return entry.axis;
+        }
+
+        /**
+         * @brief End the current check, forgetting every pair that wasn't used in it.
+         */
+        void prune();
+
+        /**
+         * @brief Get the amount of pairs with an axis.
+         */
+        inline std::size_t size() const
+        {
+            return this->entries.size();
+        }
+
+    private:
+        typedef std::pair<const void *, const void *> Key;
+        struct KeyHash
+        {
+            inline std::size_t operator()(const Key &key) const
+            {
+                std::hash<const void *> hash;
+                return hash(key.first) ^ (hash(key.second) * 31);
+            }
+        };
+        struct Entry
+        {
+            GolfEngine::SeparatingAxis axis;
+            // Check the pair was last used in.
+            unsigned long check;
+
+            Entry() : check(0){};
+        };
+
+        std::unordered_map<Key, Entry, KeyHash> entries;
+        unsigned long check;
+    };
+
+    class Narrowphase
+    {
+    public:
+        /**
+         * @brief Find the contact between two circles.
+         *
+         * @param a Center of the first circle.
+         * @param radius_a Radius of the first circle.
+         * @param b Center of the second circle.
+         * @param radius_b Radius of the second circle.
+         * @param contact Filled in if the circles touch. Circles sharing a center are pushed apart along +x.
+         * @returns True if the circles touch, false otherwise.
+         */
+        static bool circleCircle(const GolfEngine::Vector2 &a, double radius_a, const GolfEngine::Vector2 &b, double radius_b, GolfEngine::Contact &contact);
+
+        /**
+         * @brief Find the contact between a convex polygon and a circle.
+         *
+         * @param vertices The polygon's vertices, in order.
+         * @param count Amount of vertices.
+         * @param center Center of the circle.
+         * @param radius Radius of the circle.
+         * @param contact Filled in if they touch, with the normal pointing from the polygon towards the circle.
+         * @returns True if they touch, false otherwise.
+         */
+        static bool polygonCircle(const GolfEngine::Vector2 *vertices, std::size_t count, const GolfEngine::Vector2 &center, double radius, GolfEngine::Contact &contact);
+
+        /**
+         * @brief Find the contact between two convex polygons.
+         *
+         * The axis in cache is tried first. Pairs that stay apart are usually still split by it, and are rejected after a single projection.
+         *
+         * @param a The first polygon's vertices, in order.
+         * @param count_a Amount of vertices in the first polygon.
+         * @param b The second polygon's vertices, in order.
+         * @param count_b Amount of vertices in the second polygon.
+         * @param contact Filled in if they touch, with the normal pointing from the first polygon towards the second.
+         * @param cache The axis from the last test of this pair. Updated with the separating axis, or the axis of least overlap.
+         * @returns True if they touch, false otherwise.
+         */
+        static bool polygonPolygon(const GolfEngine::Vector2 *a, std::size_t count_a, const GolfEngine::Vector2 *b, std::size_t count_b, GolfEngine::Contact &contact, GolfEngine::SeparatingAxis &cache);
+    };
+}
+
+#endif
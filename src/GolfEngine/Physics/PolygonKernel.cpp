@@ -0,0 +1,249 @@
+/**
+ * @file PolygonKernel.cpp
+ * @brief This file contains definitions for the PolygonKernel class.
+ *
+ * Like the integration kernel, the SIMD implementations use per-function target attributes.
+ * They do the same arithmetic as the scalar implementation, in the same order, so every lane
+ * rounds exactly as the scalar path would.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-28
+ */
+
+#include "PolygonKernel.hpp"
+#include "SimdLanes.hpp"
+
+using GolfEngine::PolygonKernel;
+using GolfEngine::IntegrationKernel;
+using GolfEngine::Scalar;
+
+void PolygonKernel::containsPointsScalar(const GolfEngine::EdgeList &edges, const Scalar *x, const Scalar *y, std::size_t count, unsigned char *inside)
+{
+    for (std::size_t p = 0; p < count; p++)
+    {
+        bool collision = false;
+        for (std::size_t i = 0; i < edges.count; i++)
+        {
+            // Check if the point is between the two points in the y axis.
+            if ((edges.a_y[i] > y[p]) != (edges.b_y[i] > y[p]))
+            {
+                // Use the Jordan Curve Theorem
+                Scalar winding_number = (edges.b_x[i] - edges.a_x[i]) * (y[p] - edges.a_y[i]) / (edges.b_y[i] - edges.a_y[i]) + edges.a_x[i];
+                if (x[p] < winding_number)
+                {
+                    collision = !collision;
+                }
+            }
+        }
+        inside[p] = collision;
+    }
+}
+
+void PolygonKernel::crossesSegmentsScalar(const GolfEngine::EdgeList &edges, const GolfEngine::SegmentBatch &segments, unsigned char *crossed)
+{
+    for (std::size_t s = 0; s < segments.count; s++)
+    {
+        Scalar odx = segments.b_x[s] - segments.a_x[s];
+        Scalar ody = segments.b_y[s] - segments.a_y[s];
+        bool hit = false;
+        for (std::size_t i = 0; i < edges.count && !hit; i++)
+        {
+            Scalar edx = edges.b_x[i] - edges.a_x[i];
+            Scalar edy = edges.b_y[i] - edges.a_y[i];
+            Scalar offset_x = edges.a_x[i] - segments.a_x[s];
+            Scalar offset_y = edges.a_y[i] - segments.a_y[s];
+            Scalar denominator = (edx * ody) - (edy * odx);
+            Scalar numerator1 = (offset_y * odx) - (offset_x * ody);
+            Scalar numerator2 = (offset_y * edx) - (offset_x * edy);
+            if (denominator == 0)
+            {
+                hit = (numerator1 == 0) && (numerator2 == 0);
+                continue;
+            }
+            Scalar r = numerator1 / denominator;
+            Scalar t = numerator2 / denominator;
+            hit = (r >= 0 && r <= 1) && (t >= 0 && t <= 1);
+        }
+        crossed[s] = hit;
+    }
+}
+
+/**
+ * @brief Offset a segment batch, for handing the leftovers after the last full lane group to the scalar path.
+ */
+static inline GolfEngine::SegmentBatch segmentTail(const GolfEngine::SegmentBatch &segments, std::size_t start)
+{
+    GolfEngine::SegmentBatch tail;
+    tail.a_x = segments.a_x + start;
+    tail.a_y = segments.a_y + start;
+    tail.b_x = segments.b_x + start;
+    tail.b_y = segments.b_y + start;
+    tail.count = segments.count - start;
+    return tail;
+}
+
+/**
+ * @brief Spread a lane mask out into one flag per lane.
+ */
+static inline void unpackMask(int mask, std::size_t width, unsigned char *flags)
+{
+    for (std::size_t lane = 0; lane < width; lane++)
+    {
+        flags[lane] = (mask >> lane) & 1;
+    }
+}
+
+#ifdef GOLFENGINE_X86_SIMD
+
+__attribute__((target("sse2"))) static void containsPointsSSE2(const GolfEngine::EdgeList &edges, const Scalar *x, const Scalar *y, std::size_t count, unsigned char *inside)
+{
+    typedef GolfEngine::SSE2Lanes Lanes;
+    std::size_t p = 0;
+    for (; p + GolfEngine::SSE2_WIDTH <= count; p += GolfEngine::SSE2_WIDTH)
+    {
+        Lanes px = GOLFENGINE_SSE2(loadu)(x + p);
+        Lanes py = GOLFENGINE_SSE2(loadu)(y + p);
+        Lanes collision = GOLFENGINE_SSE2(setzero)();
+        for (std::size_t i = 0; i < edges.count; i++)
+        {
+            Lanes ax = GOLFENGINE_SSE2(set1)(edges.a_x[i]);
+            Lanes ay = GOLFENGINE_SSE2(set1)(edges.a_y[i]);
+            Lanes between = GOLFENGINE_SSE2(xor)(GOLFENGINE_SSE2(cmpgt)(ay, py), GOLFENGINE_SSE2(cmpgt)(GOLFENGINE_SSE2(set1)(edges.b_y[i]), py));
+            // Lanes that aren't between the edge's ends may divide by zero here, but are masked off.
+            Lanes winding_number = GOLFENGINE_SSE2(add)(GOLFENGINE_SSE2(div)(GOLFENGINE_SSE2(mul)(GOLFENGINE_SSE2(set1)(edges.b_x[i] - edges.a_x[i]), GOLFENGINE_SSE2(sub)(py, ay)), GOLFENGINE_SSE2(set1)(edges.b_y[i] - edges.a_y[i])), ax);
+            collision = GOLFENGINE_SSE2(xor)(collision, GOLFENGINE_SSE2(and)(between, GOLFENGINE_SSE2(cmplt)(px, winding_number)));
+        }
+        unpackMask(GOLFENGINE_SSE2(movemask)(collision), GolfEngine::SSE2_WIDTH, inside + p);
+    }
+    PolygonKernel::containsPointsScalar(edges, x + p, y + p, count - p, inside + p);
+}
+
+__attribute__((target("sse2"))) static void crossesSegmentsSSE2(const GolfEngine::EdgeList &edges, const GolfEngine::SegmentBatch &segments, unsigned char *crossed)
+{
+    typedef GolfEngine::SSE2Lanes Lanes;
+    const Lanes zero = GOLFENGINE_SSE2(setzero)();
+    const Lanes one = GOLFENGINE_SSE2(set1)(1);
+    std::size_t s = 0;
+    for (; s + GolfEngine::SSE2_WIDTH <= segments.count; s += GolfEngine::SSE2_WIDTH)
+    {
+        Lanes sx = GOLFENGINE_SSE2(loadu)(segments.a_x + s);
+        Lanes sy = GOLFENGINE_SSE2(loadu)(segments.a_y + s);
+        Lanes odx = GOLFENGINE_SSE2(sub)(GOLFENGINE_SSE2(loadu)(segments.b_x + s), sx);
+        Lanes ody = GOLFENGINE_SSE2(sub)(GOLFENGINE_SSE2(loadu)(segments.b_y + s), sy);
+        Lanes hit = GOLFENGINE_SSE2(setzero)();
+        for (std::size_t i = 0; i < edges.count; i++)
+        {
+            Lanes edx = GOLFENGINE_SSE2(set1)(edges.b_x[i] - edges.a_x[i]);
+            Lanes edy = GOLFENGINE_SSE2(set1)(edges.b_y[i] - edges.a_y[i]);
+            Lanes offset_x = GOLFENGINE_SSE2(sub)(GOLFENGINE_SSE2(set1)(edges.a_x[i]), sx);
+            Lanes offset_y = GOLFENGINE_SSE2(sub)(GOLFENGINE_SSE2(set1)(edges.a_y[i]), sy);
+            Lanes denominator = GOLFENGINE_SSE2(sub)(GOLFENGINE_SSE2(mul)(edx, ody), GOLFENGINE_SSE2(mul)(edy, odx));
+            Lanes numerator1 = GOLFENGINE_SSE2(sub)(GOLFENGINE_SSE2(mul)(offset_y, odx), GOLFENGINE_SSE2(mul)(offset_x, ody));
+            Lanes numerator2 = GOLFENGINE_SSE2(sub)(GOLFENGINE_SSE2(mul)(offset_y, edx), GOLFENGINE_SSE2(mul)(offset_x, edy));
+
+            Lanes parallel = GOLFENGINE_SSE2(cmpeq)(denominator, zero);
+            Lanes collinear = GOLFENGINE_SSE2(and)(GOLFENGINE_SSE2(cmpeq)(numerator1, zero), GOLFENGINE_SSE2(cmpeq)(numerator2, zero));
+            Lanes r = GOLFENGINE_SSE2(div)(numerator1, denominator);
+            Lanes t = GOLFENGINE_SSE2(div)(numerator2, denominator);
+            Lanes within = GOLFENGINE_SSE2(and)(GOLFENGINE_SSE2(and)(GOLFENGINE_SSE2(cmpge)(r, zero), GOLFENGINE_SSE2(cmple)(r, one)), GOLFENGINE_SSE2(and)(GOLFENGINE_SSE2(cmpge)(t, zero), GOLFENGINE_SSE2(cmple)(t, one)));
+            hit = GOLFENGINE_SSE2(or)(hit, GOLFENGINE_SSE2(or)(GOLFENGINE_SSE2(and)(parallel, collinear), GOLFENGINE_SSE2(andnot)(parallel, within)));
+        }
+        unpackMask(GOLFENGINE_SSE2(movemask)(hit), GolfEngine::SSE2_WIDTH, crossed + s);
+    }
+    PolygonKernel::crossesSegmentsScalar(edges, segmentTail(segments, s), crossed + s);
+}
+
+__attribute__((target("avx2"))) static void containsPointsAVX2(const GolfEngine::EdgeList &edges, const Scalar *x, const Scalar *y, std::size_t count, unsigned char *inside)
+{
+    typedef GolfEngine::AVX2Lanes Lanes;
+    std::size_t p = 0;
+    for (; p + GolfEngine::AVX2_WIDTH <= count; p += GolfEngine::AVX2_WIDTH)
+    {
+        Lanes px = GOLFENGINE_AVX2(loadu)(x + p);
+        Lanes py = GOLFENGINE_AVX2(loadu)(y + p);
+        Lanes collision = GOLFENGINE_AVX2(setzero)();
+        for (std::size_t i = 0; i < edges.count; i++)
+        {
+            Lanes ax = GOLFENGINE_AVX2(set1)(edges.a_x[i]);
+            Lanes ay = GOLFENGINE_AVX2(set1)(edges.a_y[i]);
+            Lanes between = GOLFENGINE_AVX2(xor)(GOLFENGINE_AVX2(cmp)(ay, py, _CMP_GT_OQ), GOLFENGINE_AVX2(cmp)(GOLFENGINE_AVX2(set1)(edges.b_y[i]), py, _CMP_GT_OQ));
+            Lanes winding_number = GOLFENGINE_AVX2(add)(GOLFENGINE_AVX2(div)(GOLFENGINE_AVX2(mul)(GOLFENGINE_AVX2(set1)(edges.b_x[i] - edges.a_x[i]), GOLFENGINE_AVX2(sub)(py, ay)), GOLFENGINE_AVX2(set1)(edges.b_y[i] - edges.a_y[i])), ax);
+            collision = GOLFENGINE_AVX2(xor)(collision, GOLFENGINE_AVX2(and)(between, GOLFENGINE_AVX2(cmp)(px, winding_number, _CMP_LT_OQ)));
+        }
+        unpackMask(GOLFENGINE_AVX2(movemask)(collision), GolfEngine::AVX2_WIDTH, inside + p);
+    }
+    PolygonKernel::containsPointsScalar(edges, x + p, y + p, count - p, inside + p);
+}
+
+__attribute__((target("avx2"))) static void crossesSegmentsAVX2(const GolfEngine::EdgeList &edges, const GolfEngine::SegmentBatch &segments, unsigned char *crossed)
+{
+    typedef GolfEngine::AVX2Lanes Lanes;
+    const Lanes zero = GOLFENGINE_AVX2(setzero)();
+    const Lanes one = GOLFENGINE_AVX2(set1)(1);
+    std::size_t s = 0;
+    for (; s + GolfEngine::AVX2_WIDTH <= segments.count; s += GolfEngine::AVX2_WIDTH)
+    {
+        Lanes sx = GOLFENGINE_AVX2(loadu)(segments.a_x + s);
+        Lanes sy = GOLFENGINE_AVX2(loadu)(segments.a_y + s);
+        Lanes odx = GOLFENGINE_AVX2(sub)(GOLFENGINE_AVX2(loadu)(segments.b_x + s), sx);
+        Lanes ody = GOLFENGINE_AVX2(sub)(GOLFENGINE_AVX2(loadu)(segments.b_y + s), sy);
+        Lanes hit = GOLFENGINE_AVX2(setzero)();
+        for (std::size_t i = 0; i < edges.count; i++)
+        {
+            Lanes edx = GOLFENGINE_AVX2(set1)(edges.b_x[i] - edges.a_x[i]);
+            Lanes edy = GOLFENGINE_AVX2(set1)(edges.b_y[i] - edges.a_y[i]);
+            Lanes offset_x = GOLFENGINE_AVX2(sub)(GOLFENGINE_AVX2(set1)(edges.a_x[i]), sx);
+            Lanes offset_y = GOLFENGINE_AVX2(sub)(GOLFENGINE_AVX2(set1)(edges.a_y[i]), sy);
+            Lanes denominator = GOLFENGINE_AVX2(sub)(GOLFENGINE_AVX2(mul)(edx, ody), GOLFENGINE_AVX2(mul)(edy, odx));
+            Lanes numerator1 = GOLFENGINE_AVX2(sub)(GOLFENGINE_AVX2(mul)(offset_y, odx), GOLFENGINE_AVX2(mul)(offset_x, ody));
+            Lanes numerator2 = GOLFENGINE_AVX2(sub)(GOLFENGINE_AVX2(mul)(offset_y, edx), GOLFENGINE_AVX2(mul)(offset_x, edy));
+
+            Lanes parallel = GOLFENGINE_AVX2(cmp)(denominator, zero, _CMP_EQ_OQ);
+            Lanes collinear = GOLFENGINE_AVX2(and)(GOLFENGINE_AVX2(cmp)(numerator1, zero, _CMP_EQ_OQ), GOLFENGINE_AVX2(cmp)(numerator2, zero, _CMP_EQ_OQ));
+            Lanes r = GOLFENGINE_AVX2(div)(numerator1, denominator);
+            Lanes t = GOLFENGINE_AVX2(div)(numerator2, denominator);
+            Lanes within = GOLFENGINE_AVX2(and)(GOLFENGINE_AVX2(and)(GOLFENGINE_AVX2(cmp)(r, zero, _CMP_GE_OQ), GOLFENGINE_AVX2(cmp)(r, one, _CMP_LE_OQ)), GOLFENGINE_AVX2(and)(GOLFENGINE_AVX2(cmp)(t, zero, _CMP_GE_OQ), GOLFENGINE_AVX2(cmp)(t, one, _CMP_LE_OQ)));
+            hit = GOLFENGINE_AVX2(or)(hit, GOLFENGINE_AVX2(or)(GOLFENGINE_AVX2(and)(parallel, collinear), GOLFENGINE_AVX2(andnot)(parallel, within)));
+        }
+        unpackMask(GOLFENGINE_AVX2(movemask)(hit), GolfEngine::AVX2_WIDTH, crossed + s);
+    }
+    PolygonKernel::crossesSegmentsScalar(edges, segmentTail(segments, s), crossed + s);
+}
+
+#endif
+
+PolygonKernel::Active PolygonKernel::getKernels(IntegrationKernel::Implementation implementation)
+{
+    // Checks support, and throws if the CPU can't run it.
+    IntegrationKernel::getKernel(implementation);
+    Active kernels;
+    kernels.implementation = implementation;
+    switch (implementation)
+    {
+#ifdef GOLFENGINE_X86_SIMD
+    case IntegrationKernel::SSE2:
+        kernels.contains = &containsPointsSSE2;
+        kernels.crosses = &crossesSegmentsSSE2;
+        break;
+    case IntegrationKernel::AVX2:
+        kernels.contains = &containsPointsAVX2;
+        kernels.crosses = &crossesSegmentsAVX2;
+        break;
+#endif
+    default:
+        kernels.contains = &PolygonKernel::containsPointsScalar;
+        kernels.crosses = &PolygonKernel::crossesSegmentsScalar;
+        break;
+    }
+    return kernels;
+}
+
+IntegrationKernel::Implementation PolygonKernel::getImplementation()
+{
+    return PolygonKernel::active().implementation;
+}
+
+void PolygonKernel::setImplementation(IntegrationKernel::Implementation implementation)
+{
+    PolygonKernel::active() = PolygonKernel::getKernels(implementation);
+}
@@ -0,0 +1,122 @@
+/**
+ * @file PolygonKernel.hpp
+ * @brief This file contains declerations for the PolygonKernel class.
+ *
+ * The PolygonKernel tests whole batches of points or segments against one polygon's edges,
+ * stored as structure-of-arrays of GolfEngine::Scalar. Queries are spread across SIMD lanes, with the same runtime
+ * choice of scalar, SSE2 or AVX2 implementation as the \ref GolfEngine::IntegrationKernel.
+ * Every implementation gives exactly the same answers.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-28
+ */
+
+#ifndef POLYGONKERNEL_H
+#define POLYGONKERNEL_H
+
+#include "IntegrationKernel.hpp"
+#include <cstddef>
+
+namespace GolfEngine
+{
+    /**
+     * @brief The edges of a polygon. Edge i runs from (a_x[i], a_y[i]) to (b_x[i], b_y[i]).
+     */
+    struct EdgeList
+    {
+        const GolfEngine::Scalar *a_x;
+        const GolfEngine::Scalar *a_y;
+        const GolfEngine::Scalar *b_x;
+        const GolfEngine::Scalar *b_y;
+        std::size_t count;
+    };
+
+    /**
+     * @brief A batch of segments. Segment i runs from (a_x[i], a_y[i]) to (b_x[i], b_y[i]).
+     */
+    struct SegmentBatch
+    {
+        const GolfEngine::Scalar *a_x;
+        const GolfEngine::Scalar *a_y;
+        const GolfEngine::Scalar *b_x;
+        const GolfEngine::Scalar *b_y;
+        std::size_t count;
+    };
+
+    class PolygonKernel
+    {
+    public:
+        typedef void (*ContainsFunction)(const GolfEngine::EdgeList &edges, const GolfEngine::Scalar *x, const GolfEngine::Scalar *y, std::size_t count, unsigned char *inside);
+        typedef void (*CrossesFunction)(const GolfEngine::EdgeList &edges, const GolfEngine::SegmentBatch &segments, unsigned char *crossed);
+
+        /**
+         * @brief Check which points are inside of a polygon, using the even-odd rule.
+         *
+         * @param edges Edges of the polygon.
+         * @param x X coordinates of the points.
+         * @param y Y coordinates of the points.
+         * @param count Amount of points.
+         * @param inside Set to 1 for every point inside of the polygon, 0 otherwise.
+         */
+        static inline void containsPoints(const GolfEngine::EdgeList &edges, const GolfEngine::Scalar *x, const GolfEngine::Scalar *y, std::size_t count, unsigned char *inside)
+        {
+            PolygonKernel::active().contains(edges, x, y, count, inside);
+        }
+
+        /**
+         * @brief Check which segments cross any edge of a polygon.
+         *
+         * Each edge and segment pair is tested exactly as \ref GolfEngine::Line::intersects(const Line&) const "Line::intersects" does.
+         *
+         * @param edges Edges of the polygon.
+         * @param segments Segments to check.
+         * @param crossed Set to 1 for every segment crossing an edge, 0 otherwise.
+         */
+        static inline void crossesSegments(const GolfEngine::EdgeList &edges, const GolfEngine::SegmentBatch &segments, unsigned char *crossed)
+        {
+            PolygonKernel::active().crosses(edges, segments, crossed);
+        }
+
+        /**
+         * @brief Get the implementation currently in use.
+         *
+         * @returns The active implementation.
+         */
+        static GolfEngine::IntegrationKernel::Implementation getImplementation();
+
+        /**
+         * @brief Force a specific implementation, e.g. for testing or benchmarking.
+         *
+         * @param implementation Implementation to use.
+         * @throws std::invalid_argument If the running CPU does not support the implementation.
+         * @note Not safe to call while other threads are using the kernel.
+         */
+        static void setImplementation(GolfEngine::IntegrationKernel::Implementation implementation);
+
+        static void containsPointsScalar(const GolfEngine::EdgeList &edges, const GolfEngine::Scalar *x, const GolfEngine::Scalar *y, std::size_t count, unsigned char *inside);
+        static void crossesSegmentsScalar(const GolfEngine::EdgeList &edges, const GolfEngine::SegmentBatch &segments, unsigned char *crossed);
+
+    private:
+        struct Active
+        {
+            GolfEngine::IntegrationKernel::Implementation implementation;
+            ContainsFunction contains;
+            CrossesFunction crosses;
+        };
+
+        /**
+         * @brief Get the implementation in use, picking the best one on first use.
+         *
+         * Resolved the same way as \ref GolfEngine::IntegrationKernel "IntegrationKernel", through a function-local static.
+         */
+        static inline Active &active()
+        {
+            static Active current = PolygonKernel::getKernels(GolfEngine::IntegrationKernel::detect());
+            return current;
+        }
+
+        static Active getKernels(GolfEngine::IntegrationKernel::Implementation implementation);
+    };
+}
+
+#endif
@@ -0,0 +1,53 @@
+/**
+ * @file SimdLanes.hpp
+ * @brief This file contains the SIMD lane definitions shared by the physics kernels.
+ *
+ * The kernels work on arrays of GolfEngine::Scalar, so the x86 intrinsics they use depend on it:
+ * the packed single precision (_ps) family when Scalar is float, and the packed double precision
+ * (_pd) family when GOLFENGINE_DOUBLE_PRECISION is defined. GOLFENGINE_SSE2(op) and
+ * GOLFENGINE_AVX2(op) name the intrinsic for op in the right family, e.g. GOLFENGINE_SSE2(add) is
+ * _mm_add_ps or _mm_add_pd, and SSE2Lanes / AVX2Lanes are the matching register types.
+ *
+ * Only included by kernel translation units, which compile these with per-function target attributes.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#ifndef SIMDLANES_H
+#define SIMDLANES_H
+
+#include "../Geometry/Vector2.hpp"
+#include <cstddef>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GOLFENGINE_X86_SIMD
+#include <immintrin.h>
+
+namespace GolfEngine
+{
+#ifdef GOLFENGINE_DOUBLE_PRECISION
+    typedef __m128d SSE2Lanes;
+    typedef __m256d AVX2Lanes;
+#define GOLFENGINE_SSE2(op) _mm_##op##_pd
+#define GOLFENGINE_AVX2(op) _mm256_##op##_pd
+#else
+    typedef __m128 SSE2Lanes;
+    typedef __m256 AVX2Lanes;
+#define GOLFENGINE_SSE2(op) _mm_##op##_ps
+#define GOLFENGINE_AVX2(op) _mm256_##op##_ps
+#endif
+
+    /**
+     * @brief Amount of scalars in an SSE2 register.
+     */
+    static const std::size_t SSE2_WIDTH = sizeof(GolfEngine::SSE2Lanes) / sizeof(GolfEngine::Scalar);
+    /**
+     * @brief Amount of scalars in an AVX2 register.
+     */
+    static const std::size_t AVX2_WIDTH = sizeof(GolfEngine::AVX2Lanes) / sizeof(GolfEngine::Scalar);
+}
+
+#endif
+
+#endif
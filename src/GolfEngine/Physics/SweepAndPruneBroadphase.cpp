@@ -0,0 +1,64 @@
+/**
+ * @file SweepAndPruneBroadphase.cpp
+ * @brief This file contains definitions for the SweepAndPruneBroadphase class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-26
+ */
+
+#include "SweepAndPruneBroadphase.hpp"
+#include <algorithm>
+
+using GolfEngine::SweepAndPruneBroadphase;
+
+void SweepAndPruneBroadphase::findPairs(const GolfEngine::AABB::AABBList &bounds, GolfEngine::CandidatePair::CandidatePairList &pairs)
+{
+    unsigned int count = bounds.size();
+    if (this->order.size() != count)
+    {
+        // The bodies changed, so last frame's order is meaningless. Sort from scratch.
+        this->order.resize(count);
+        for (unsigned int i = 0; i < count; i++)
+        {
+            this->order[i] = i;
+        }
+        std::sort(this->order.begin(), this->order.end(), [&bounds](unsigned int a, unsigned int b)
+                  { return bounds[a].min_x < bounds[b].min_x; });
+    }
+    else
+    {
+        // Insertion sort is close to linear on last frame's, nearly sorted, order.
+        for (unsigned int i = 1; i < count; i++)
+        {
+            unsigned int body = this->order[i];
+            GolfEngine::Scalar key = bounds[body].min_x;
+            unsigned int j = i;
+            while (j > 0 && bounds[this->order[j - 1]].min_x > key)
+            {
+                this->order[j] = this->order[j - 1];
+                j--;
+            }
+            this->order[j] = body;
+        }
+    }
+
+    for (unsigned int a = 0; a < count; a++)
+    {
+        const GolfEngine::AABB &box = bounds[this->order[a]];
+        for (unsigned int b = a + 1; b < count; b++)
+        {
+            const GolfEngine::AABB &other = bounds[this->order[b]];
+            if (other.min_x > box.max_x)
+            {
+                // Everything after this starts further right, so nothing else can overlap.
+                break;
+            }
+            if (box.min_y <= other.max_y && other.min_y <= box.max_y)
+            {
+                unsigned int i = std::min(this->order[a], this->order[b]);
+                unsigned int j = std::max(this->order[a], this->order[b]);
+                pairs.push_back(GolfEngine::CandidatePair(i, j));
+            }
+        }
+    }
+}
@@ -0,0 +1,41 @@
+/**
+ * @file SweepAndPruneBroadphase.hpp
+ * @brief This file contains declerations for the SweepAndPruneBroadphase class.
+ *
+ * Sweep and prune sorts bodies along the x axis and sweeps across them, only testing bodies
+ * whose x extents overlap. The sorted order is kept between frames, and since bodies move
+ * little from one frame to the next, re-sorting it is close to linear.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-26
+ */
+
+#ifndef SWEEPANDPRUNEBROADPHASE_H
+#define SWEEPANDPRUNEBROADPHASE_H
+
+#include "Broadphase.hpp"
+#include <vector>
+
+namespace GolfEngine
+{
+    class SweepAndPruneBroadphase : public GolfEngine::Broadphase
+    {
+    public:
+        SweepAndPruneBroadphase() {}
+
+        void findPairs(const GolfEngine::AABB::AABBList &bounds, GolfEngine::CandidatePair::CandidatePairList &pairs);
+
+        inline GolfEngine::BroadphaseStrategy getStrategy() const
+        {
+            return GolfEngine::BroadphaseStrategy::SWEEP_AND_PRUNE;
+        }
+
+    private:
+        /**
+         * @brief Body indices, sorted by the left edge of their bounds as of the last frame.
+         */
+        std::vector<unsigned int> order;
+    };
+}
+
+#endif
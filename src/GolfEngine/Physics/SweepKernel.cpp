@@ -0,0 +1,293 @@
+/**
+ * @file SweepKernel.cpp
+ * @brief This file contains definitions for the SweepKernel class.
+ *
+ * Like the other kernels, the SIMD implementations use per-function target attributes, and do the
+ * same arithmetic as the scalar implementation, in the same order. Branches in the scalar path
+ * become masks, so every lane rounds exactly as the scalar path would.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#include "SweepKernel.hpp"
+#include "SimdLanes.hpp"
+#include <cmath>
+
+using GolfEngine::SweepKernel;
+using GolfEngine::IntegrationKernel;
+using GolfEngine::Scalar;
+
+/**
+ * @brief Time reported for segments the circle never touches.
+ */
+static const Scalar NO_IMPACT = 2;
+
+/**
+ * @brief Sweep a circle against a single point (a segment's endpoint).
+ *
+ * @param offset_x X offset of the circle's center from the point.
+ * @param offset_y Y offset of the circle's center from the point.
+ * @param motion_sqr Squared length of the circle's motion.
+ */
+static inline Scalar sweepPointScalar(Scalar offset_x, Scalar offset_y, Scalar motion_x, Scalar motion_y, Scalar motion_sqr, Scalar radius_sqr)
+{
+    // Solve |offset + motion * t| = radius for the smallest t.
+    Scalar b = (offset_x * motion_x) + (offset_y * motion_y);
+    Scalar c = ((offset_x * offset_x) + (offset_y * offset_y)) - radius_sqr;
+    if (motion_sqr == 0 || b >= 0)
+    {
+        // Not moving, or moving away.
+        return NO_IMPACT;
+    }
+    Scalar discriminant = (b * b) - (motion_sqr * c);
+    if (discriminant < 0)
+    {
+        return NO_IMPACT;
+    }
+    return (c <= 0) ? 0 : (-b - std::sqrt(discriminant)) / motion_sqr;
+}
+
+void SweepKernel::sweepSegmentsScalar(const GolfEngine::SweptCircle &circle, const GolfEngine::SegmentBatch &segments, Scalar *times)
+{
+    const Scalar cx = circle.center_x, cy = circle.center_y;
+    const Scalar mx = circle.motion_x, my = circle.motion_y;
+    const Scalar radius = circle.radius;
+    const Scalar motion_sqr = (mx * mx) + (my * my);
+    const Scalar radius_sqr = radius * radius;
+    for (std::size_t s = 0; s < segments.count; s++)
+    {
+        Scalar ax = segments.a_x[s], ay = segments.a_y[s];
+        Scalar bx = segments.b_x[s], by = segments.b_y[s];
+        Scalar time = NO_IMPACT;
+
+        // First, the segment's face. Orient the normal towards where the circle starts.
+        Scalar dx = bx - ax;
+        Scalar dy = by - ay;
+        Scalar length_sqr = (dx * dx) + (dy * dy);
+        if (length_sqr != 0)
+        {
+            Scalar length = std::sqrt(length_sqr);
+            Scalar nx = -dy / length;
+            Scalar ny = dx / length;
+            Scalar distance = ((cx - ax) * nx) + ((cy - ay) * ny);
+            if (distance < 0)
+            {
+                nx = -nx;
+                ny = -ny;
+                distance = -distance;
+            }
+            Scalar approach = (mx * nx) + (my * ny);
+            if (approach < 0)
+            {
+                Scalar t = (distance <= radius) ? 0 : (radius - distance) / approach;
+                // Only counts if the touching point is on the segment itself.
+                Scalar moved_x = cx + (mx * t);
+                Scalar moved_y = cy + (my * t);
+                Scalar depth = ((moved_x - ax) * nx) + ((moved_y - ay) * ny);
+                Scalar contact_x = moved_x - (nx * depth);
+                Scalar contact_y = moved_y - (ny * depth);
+                Scalar along = (((contact_x - ax) * dx) + ((contact_y - ay) * dy)) / length_sqr;
+                if (along >= 0 && along <= 1)
+                {
+                    time = t;
+                }
+            }
+        }
+
+        // Then, the rounded ends.
+        Scalar end = sweepPointScalar(cx - ax, cy - ay, mx, my, motion_sqr, radius_sqr);
+        time = (time < end) ? time : end;
+        end = sweepPointScalar(cx - bx, cy - by, mx, my, motion_sqr, radius_sqr);
+        time = (time < end) ? time : end;
+        times[s] = time;
+    }
+}
+
+/**
+ * @brief Offset a segment batch, for handing the leftovers after the last full lane group to the scalar path.
+ */
+static inline GolfEngine::SegmentBatch segmentTail(const GolfEngine::SegmentBatch &segments, std::size_t start)
+{
+    GolfEngine::SegmentBatch tail;
+    tail.a_x = segments.a_x + start;
+    tail.a_y = segments.a_y + start;
+    tail.b_x = segments.b_x + start;
+    tail.b_y = segments.b_y + start;
+    tail.count = segments.count - start;
+    return tail;
+}
+
+#ifdef GOLFENGINE_X86_SIMD
+
+/**
+ * @brief SSE2 version of sweepPointScalar, for a lane of points.
+ */
+__attribute__((target("sse2"))) static inline GolfEngine::SSE2Lanes sweepPointSSE2(GolfEngine::SSE2Lanes offset_x, GolfEngine::SSE2Lanes offset_y, GolfEngine::SSE2Lanes motion_x, GolfEngine::SSE2Lanes motion_y, GolfEngine::SSE2Lanes motion_sqr, GolfEngine::SSE2Lanes radius_sqr)
+{
+    typedef GolfEngine::SSE2Lanes Lanes;
+    const Lanes zero = GOLFENGINE_SSE2(setzero)();
+    const Lanes sign = GOLFENGINE_SSE2(set1)((Scalar)-0.0);
+    Lanes b = GOLFENGINE_SSE2(add)(GOLFENGINE_SSE2(mul)(offset_x, motion_x), GOLFENGINE_SSE2(mul)(offset_y, motion_y));
+    Lanes c = GOLFENGINE_SSE2(sub)(GOLFENGINE_SSE2(add)(GOLFENGINE_SSE2(mul)(offset_x, offset_x), GOLFENGINE_SSE2(mul)(offset_y, offset_y)), radius_sqr);
+    Lanes discriminant = GOLFENGINE_SSE2(sub)(GOLFENGINE_SSE2(mul)(b, b), GOLFENGINE_SSE2(mul)(motion_sqr, c));
+    Lanes valid = GOLFENGINE_SSE2(and)(GOLFENGINE_SSE2(and)(GOLFENGINE_SSE2(cmpneq)(motion_sqr, zero), GOLFENGINE_SSE2(cmpnge)(b, zero)), GOLFENGINE_SSE2(cmpnlt)(discriminant, zero));
+    // Lanes that miss may take the square root of a negative number here, but are masked off.
+    Lanes t = GOLFENGINE_SSE2(div)(GOLFENGINE_SSE2(sub)(GOLFENGINE_SSE2(xor)(b, sign), GOLFENGINE_SSE2(sqrt)(discriminant)), motion_sqr);
+    t = GOLFENGINE_SSE2(andnot)(GOLFENGINE_SSE2(cmple)(c, zero), t);
+    return GOLFENGINE_SSE2(or)(GOLFENGINE_SSE2(and)(valid, t), GOLFENGINE_SSE2(andnot)(valid, GOLFENGINE_SSE2(set1)(NO_IMPACT)));
+}
+
+__attribute__((target("sse2"))) static void sweepSegmentsSSE2(const GolfEngine::SweptCircle &circle, const GolfEngine::SegmentBatch &segments, Scalar *times)
+{
+    typedef GolfEngine::SSE2Lanes Lanes;
+    const Lanes zero = GOLFENGINE_SSE2(setzero)();
+    const Lanes one = GOLFENGINE_SSE2(set1)(1);
+    const Lanes sign = GOLFENGINE_SSE2(set1)((Scalar)-0.0);
+    const Lanes cx = GOLFENGINE_SSE2(set1)(circle.center_x);
+    const Lanes cy = GOLFENGINE_SSE2(set1)(circle.center_y);
+    const Lanes mx = GOLFENGINE_SSE2(set1)(circle.motion_x);
+    const Lanes my = GOLFENGINE_SSE2(set1)(circle.motion_y);
+    const Lanes radius = GOLFENGINE_SSE2(set1)(circle.radius);
+    const Lanes motion_sqr = GOLFENGINE_SSE2(set1)((circle.motion_x * circle.motion_x) + (circle.motion_y * circle.motion_y));
+    const Lanes radius_sqr = GOLFENGINE_SSE2(set1)(circle.radius * circle.radius);
+    std::size_t s = 0;
+    for (; s + GolfEngine::SSE2_WIDTH <= segments.count; s += GolfEngine::SSE2_WIDTH)
+    {
+        Lanes ax = GOLFENGINE_SSE2(loadu)(segments.a_x + s);
+        Lanes ay = GOLFENGINE_SSE2(loadu)(segments.a_y + s);
+        Lanes bx = GOLFENGINE_SSE2(loadu)(segments.b_x + s);
+        Lanes by = GOLFENGINE_SSE2(loadu)(segments.b_y + s);
+
+        Lanes dx = GOLFENGINE_SSE2(sub)(bx, ax);
+        Lanes dy = GOLFENGINE_SSE2(sub)(by, ay);
+        Lanes length_sqr = GOLFENGINE_SSE2(add)(GOLFENGINE_SSE2(mul)(dx, dx), GOLFENGINE_SSE2(mul)(dy, dy));
+        Lanes length = GOLFENGINE_SSE2(sqrt)(length_sqr);
+        Lanes nx = GOLFENGINE_SSE2(div)(GOLFENGINE_SSE2(xor)(dy, sign), length);
+        Lanes ny = GOLFENGINE_SSE2(div)(dx, length);
+        Lanes distance = GOLFENGINE_SSE2(add)(GOLFENGINE_SSE2(mul)(GOLFENGINE_SSE2(sub)(cx, ax), nx), GOLFENGINE_SSE2(mul)(GOLFENGINE_SSE2(sub)(cy, ay), ny));
+        Lanes flip = GOLFENGINE_SSE2(and)(GOLFENGINE_SSE2(cmplt)(distance, zero), sign);
+        nx = GOLFENGINE_SSE2(xor)(nx, flip);
+        ny = GOLFENGINE_SSE2(xor)(ny, flip);
+        distance = GOLFENGINE_SSE2(xor)(distance, flip);
+        Lanes approach = GOLFENGINE_SSE2(add)(GOLFENGINE_SSE2(mul)(mx, nx), GOLFENGINE_SSE2(mul)(my, ny));
+        Lanes t = GOLFENGINE_SSE2(div)(GOLFENGINE_SSE2(sub)(radius, distance), approach);
+        t = GOLFENGINE_SSE2(andnot)(GOLFENGINE_SSE2(cmple)(distance, radius), t);
+        Lanes moved_x = GOLFENGINE_SSE2(add)(cx, GOLFENGINE_SSE2(mul)(mx, t));
+        Lanes moved_y = GOLFENGINE_SSE2(add)(cy, GOLFENGINE_SSE2(mul)(my, t));
+        Lanes depth = GOLFENGINE_SSE2(add)(GOLFENGINE_SSE2(mul)(GOLFENGINE_SSE2(sub)(moved_x, ax), nx), GOLFENGINE_SSE2(mul)(GOLFENGINE_SSE2(sub)(moved_y, ay), ny));
+        Lanes contact_x = GOLFENGINE_SSE2(sub)(moved_x, GOLFENGINE_SSE2(mul)(nx, depth));
+        Lanes contact_y = GOLFENGINE_SSE2(sub)(moved_y, GOLFENGINE_SSE2(mul)(ny, depth));
+        Lanes along = GOLFENGINE_SSE2(div)(GOLFENGINE_SSE2(add)(GOLFENGINE_SSE2(mul)(GOLFENGINE_SSE2(sub)(contact_x, ax), dx), GOLFENGINE_SSE2(mul)(GOLFENGINE_SSE2(sub)(contact_y, ay), dy)), length_sqr);
+        Lanes face = GOLFENGINE_SSE2(and)(GOLFENGINE_SSE2(and)(GOLFENGINE_SSE2(cmpneq)(length_sqr, zero), GOLFENGINE_SSE2(cmplt)(approach, zero)), GOLFENGINE_SSE2(and)(GOLFENGINE_SSE2(cmpge)(along, zero), GOLFENGINE_SSE2(cmple)(along, one)));
+        Lanes time = GOLFENGINE_SSE2(or)(GOLFENGINE_SSE2(and)(face, t), GOLFENGINE_SSE2(andnot)(face, GOLFENGINE_SSE2(set1)(NO_IMPACT)));
+
+        time = GOLFENGINE_SSE2(min)(time, sweepPointSSE2(GOLFENGINE_SSE2(sub)(cx, ax), GOLFENGINE_SSE2(sub)(cy, ay), mx, my, motion_sqr, radius_sqr));
+        time = GOLFENGINE_SSE2(min)(time, sweepPointSSE2(GOLFENGINE_SSE2(sub)(cx, bx), GOLFENGINE_SSE2(sub)(cy, by), mx, my, motion_sqr, radius_sqr));
+        GOLFENGINE_SSE2(storeu)(times + s, time);
+    }
+    SweepKernel::sweepSegmentsScalar(circle, segmentTail(segments, s), times + s);
+}
+
+/**
+ * @brief AVX2 version of sweepPointScalar, for a lane of points.
+ */
+__attribute__((target("avx2"))) static inline GolfEngine::AVX2Lanes sweepPointAVX2(GolfEngine::AVX2Lanes offset_x, GolfEngine::AVX2Lanes offset_y, GolfEngine::AVX2Lanes motion_x, GolfEngine::AVX2Lanes motion_y, GolfEngine::AVX2Lanes motion_sqr, GolfEngine::AVX2Lanes radius_sqr)
+{
+    typedef GolfEngine::AVX2Lanes Lanes;
+    const Lanes zero = GOLFENGINE_AVX2(setzero)();
+    const Lanes sign = GOLFENGINE_AVX2(set1)((Scalar)-0.0);
+    Lanes b = GOLFENGINE_AVX2(add)(GOLFENGINE_AVX2(mul)(offset_x, motion_x), GOLFENGINE_AVX2(mul)(offset_y, motion_y));
+    Lanes c = GOLFENGINE_AVX2(sub)(GOLFENGINE_AVX2(add)(GOLFENGINE_AVX2(mul)(offset_x, offset_x), GOLFENGINE_AVX2(mul)(offset_y, offset_y)), radius_sqr);
+    Lanes discriminant = GOLFENGINE_AVX2(sub)(GOLFENGINE_AVX2(mul)(b, b), GOLFENGINE_AVX2(mul)(motion_sqr, c));
+    Lanes valid = GOLFENGINE_AVX2(and)(GOLFENGINE_AVX2(and)(GOLFENGINE_AVX2(cmp)(motion_sqr, zero, _CMP_NEQ_UQ), GOLFENGINE_AVX2(cmp)(b, zero, _CMP_NGE_UQ)), GOLFENGINE_AVX2(cmp)(discriminant, zero, _CMP_NLT_UQ));
+    Lanes t = GOLFENGINE_AVX2(div)(GOLFENGINE_AVX2(sub)(GOLFENGINE_AVX2(xor)(b, sign), GOLFENGINE_AVX2(sqrt)(discriminant)), motion_sqr);
+    t = GOLFENGINE_AVX2(andnot)(GOLFENGINE_AVX2(cmp)(c, zero, _CMP_LE_OQ), t);
+    return GOLFENGINE_AVX2(or)(GOLFENGINE_AVX2(and)(valid, t), GOLFENGINE_AVX2(andnot)(valid, GOLFENGINE_AVX2(set1)(NO_IMPACT)));
+}
+
+__attribute__((target("avx2"))) static void sweepSegmentsAVX2(const GolfEngine::SweptCircle &circle, const GolfEngine::SegmentBatch &segments, Scalar *times)
+{
+    typedef GolfEngine::AVX2Lanes Lanes;
+    const Lanes zero = GOLFENGINE_AVX2(setzero)();
+    const Lanes one = GOLFENGINE_AVX2(set1)(1);
+    const Lanes sign = GOLFENGINE_AVX2(set1)((Scalar)-0.0);
+    const Lanes cx = GOLFENGINE_AVX2(set1)(circle.center_x);
+    const Lanes cy = GOLFENGINE_AVX2(set1)(circle.center_y);
+    const Lanes mx = GOLFENGINE_AVX2(set1)(circle.motion_x);
+    const Lanes my = GOLFENGINE_AVX2(set1)(circle.motion_y);
+    const Lanes radius = GOLFENGINE_AVX2(set1)(circle.radius);
+    const Lanes motion_sqr = GOLFENGINE_AVX2(set1)((circle.motion_x * circle.motion_x) + (circle.motion_y * circle.motion_y));
+    const Lanes radius_sqr = GOLFENGINE_AVX2(set1)(circle.radius * circle.radius);
+    std::size_t s = 0;
+    for (; s + GolfEngine::AVX2_WIDTH <= segments.count; s += GolfEngine::AVX2_WIDTH)
+    {
+        Lanes ax = GOLFENGINE_AVX2(loadu)(segments.a_x + s);
+        Lanes ay = GOLFENGINE_AVX2(loadu)(segments.a_y + s);
+        Lanes bx = GOLFENGINE_AVX2(loadu)(segments.b_x + s);
+        Lanes by = GOLFENGINE_AVX2(loadu)(segments.b_y + s);
+
+        Lanes dx = GOLFENGINE_AVX2(sub)(bx, ax);
+        Lanes dy = GOLFENGINE_AVX2(sub)(by, ay);
+        Lanes length_sqr = GOLFENGINE_AVX2(add)(GOLFENGINE_AVX2(mul)(dx, dx), GOLFENGINE_AVX2(mul)(dy, dy));
+        Lanes length = GOLFENGINE_AVX2(sqrt)(length_sqr);
+        Lanes nx = GOLFENGINE_AVX2(div)(GOLFENGINE_AVX2(xor)(dy, sign), length);
+        Lanes ny = GOLFENGINE_AVX2(div)(dx, length);
+        Lanes distance = GOLFENGINE_AVX2(add)(GOLFENGINE_AVX2(mul)(GOLFENGINE_AVX2(sub)(cx, ax), nx), GOLFENGINE_AVX2(mul)(GOLFENGINE_AVX2(sub)(cy, ay), ny));
+        Lanes flip = GOLFENGINE_AVX2(and)(GOLFENGINE_AVX2(cmp)(distance, zero, _CMP_LT_OQ), sign);
+        nx = GOLFENGINE_AVX2(xor)(nx, flip);
+        ny = GOLFENGINE_AVX2(xor)(ny, flip);
+        distance = GOLFENGINE_AVX2(xor)(distance, flip);
+        Lanes approach = GOLFENGINE_AVX2(add)(GOLFENGINE_AVX2(mul)(mx, nx), GOLFENGINE_AVX2(mul)(my, ny));
+        Lanes t = GOLFENGINE_AVX2(div)(GOLFENGINE_AVX2(sub)(radius, distance), approach);
+        t = GOLFENGINE_AVX2(andnot)(GOLFENGINE_AVX2(cmp)(distance, radius, _CMP_LE_OQ), t);
+        Lanes moved_x = GOLFENGINE_AVX2(add)(cx, GOLFENGINE_AVX2(mul)(mx, t));
+        Lanes moved_y = GOLFENGINE_AVX2(add)(cy, GOLFENGINE_AVX2(mul)(my, t));
+        Lanes depth = GOLFENGINE_AVX2(add)(GOLFENGINE_AVX2(mul)(GOLFENGINE_AVX2(sub)(moved_x, ax), nx), GOLFENGINE_AVX2(mul)(GOLFENGINE_AVX2(sub)(moved_y, ay), ny));
+        Lanes contact_x = GOLFENGINE_AVX2(sub)(moved_x, GOLFENGINE_AVX2(mul)(nx, depth));
+        Lanes contact_y = GOLFENGINE_AVX2(sub)(moved_y, GOLFENGINE_AVX2(mul)(ny, depth));
+        Lanes along = GOLFENGINE_AVX2(div)(GOLFENGINE_AVX2(add)(GOLFENGINE_AVX2(mul)(GOLFENGINE_AVX2(sub)(contact_x, ax), dx), GOLFENGINE_AVX2(mul)(GOLFENGINE_AVX2(sub)(contact_y, ay), dy)), length_sqr);
+        Lanes face = GOLFENGINE_AVX2(and)(GOLFENGINE_AVX2(and)(GOLFENGINE_AVX2(cmp)(length_sqr, zero, _CMP_NEQ_UQ), GOLFENGINE_AVX2(cmp)(approach, zero, _CMP_LT_OQ)), GOLFENGINE_AVX2(and)(GOLFENGINE_AVX2(cmp)(along, zero, _CMP_GE_OQ), GOLFENGINE_AVX2(cmp)(along, one, _CMP_LE_OQ)));
+        Lanes time = GOLFENGINE_AVX2(or)(GOLFENGINE_AVX2(and)(face, t), GOLFENGINE_AVX2(andnot)(face, GOLFENGINE_AVX2(set1)(NO_IMPACT)));
+
+        time = GOLFENGINE_AVX2(min)(time, sweepPointAVX2(GOLFENGINE_AVX2(sub)(cx, ax), GOLFENGINE_AVX2(sub)(cy, ay), mx, my, motion_sqr, radius_sqr));
+        time = GOLFENGINE_AVX2(min)(time, sweepPointAVX2(GOLFENGINE_AVX2(sub)(cx, bx), GOLFENGINE_AVX2(sub)(cy, by), mx, my, motion_sqr, radius_sqr));
+        GOLFENGINE_AVX2(storeu)(times + s, time);
+    }
+    SweepKernel::sweepSegmentsScalar(circle, segmentTail(segments, s), times + s);
+}
+
+#endif
+
+SweepKernel::Active SweepKernel::getKernels(IntegrationKernel::Implementation implementation)
+{
+    // Checks support, and throws if the CPU can't run it.
+    IntegrationKernel::getKernel(implementation);
+    Active kernels;
+    kernels.implementation = implementation;
+    switch (implementation)
+    {
+#ifdef GOLFENGINE_X86_SIMD
+    case IntegrationKernel::SSE2:
+        kernels.sweep = &sweepSegmentsSSE2;
+        break;
+    case IntegrationKernel::AVX2:
+        kernels.sweep = &sweepSegmentsAVX2;
+        break;
+#endif
+    default:
+        kernels.sweep = &SweepKernel::sweepSegmentsScalar;
+        break;
+    }
+    return kernels;
+}
+
+IntegrationKernel::Implementation SweepKernel::getImplementation()
+{
+    return SweepKernel::active().implementation;
+}
+
+void SweepKernel::setImplementation(IntegrationKernel::Implementation implementation)
+{
+    SweepKernel::active() = SweepKernel::getKernels(implementation);
+}
@@ -0,0 +1,94 @@
+/**
+ * @file SweepKernel.hpp
+ * @brief This file contains declerations for the SweepKernel class.
+ *
+ * The SweepKernel sweeps one circle against a whole batch of wall segments, stored as
+ * structure-of-arrays of GolfEngine::Scalar, and finds when it first touches each of them.
+ * Segments are spread across SIMD lanes, with the same runtime choice of scalar, SSE2 or AVX2
+ * implementation as the \ref GolfEngine::IntegrationKernel. Every implementation gives exactly the same answers.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#ifndef SWEEPKERNEL_H
+#define SWEEPKERNEL_H
+
+#include "PolygonKernel.hpp"
+#include <cstddef>
+
+namespace GolfEngine
+{
+    /**
+     * @brief A circle moving in a straight line.
+     */
+    struct SweptCircle
+    {
+        GolfEngine::Scalar center_x;
+        GolfEngine::Scalar center_y;
+        GolfEngine::Scalar motion_x;
+        GolfEngine::Scalar motion_y;
+        GolfEngine::Scalar radius;
+    };
+
+    class SweepKernel
+    {
+    public:
+        typedef void (*SweepFunction)(const GolfEngine::SweptCircle &circle, const GolfEngine::SegmentBatch &segments, GolfEngine::Scalar *times);
+
+        /**
+         * @brief Find when a circle first touches each segment of a batch.
+         *
+         * Each segment is swept the same way as \ref GolfEngine::ContinuousCollision::sweepCircle "ContinuousCollision::sweepCircle",
+         * face first and then its rounded ends, but in GolfEngine::Scalar.
+         *
+         * @param circle Circle to sweep, in the same space as the segments.
+         * @param segments Segments to sweep against.
+         * @param times Set to each segment's time of impact, as a fraction of the motion, or to something greater than 1 if the circle never touches it.
+         */
+        static inline void sweepSegments(const GolfEngine::SweptCircle &circle, const GolfEngine::SegmentBatch &segments, GolfEngine::Scalar *times)
+        {
+            SweepKernel::active().sweep(circle, segments, times);
+        }
+
+        /**
+         * @brief Get the implementation currently in use.
+         *
+         * @returns The active implementation.
+         */
+        static GolfEngine::IntegrationKernel::Implementation getImplementation();
+
+        /**
+         * @brief Force a specific implementation, e.g. for testing or benchmarking.
+         *
+         * @param implementation Implementation to use.
+         * @throws std::invalid_argument If the running CPU does not support the implementation.
+         * @note Not safe to call while other threads are using the kernel.
+         */
+        static void setImplementation(GolfEngine::IntegrationKernel::Implementation implementation);
+
+        static void sweepSegmentsScalar(const GolfEngine::SweptCircle &circle, const GolfEngine::SegmentBatch &segments, GolfEngine::Scalar *times);
+
+    private:
+        struct Active
+        {
+            GolfEngine::IntegrationKernel::Implementation implementation;
+            SweepFunction sweep;
+        };
+
+        /**
+         * @brief Get the implementation in use, picking the best one on first use.
+         *
+         * Resolved the same way as \ref GolfEngine::IntegrationKernel "IntegrationKernel", through a function-local static.
+         */
+        static inline Active &active()
+        {
+            static Active current = SweepKernel::getKernels(GolfEngine::IntegrationKernel::detect());
+            return current;
+        }
+
+        static Active getKernels(GolfEngine::IntegrationKernel::Implementation implementation);
+    };
+}
+
+#endif
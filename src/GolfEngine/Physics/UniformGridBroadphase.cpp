@@ -0,0 +1,109 @@
+/**
+ * @file UniformGridBroadphase.cpp
+ * @brief This file contains definitions for the UniformGridBroadphase class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-26
+ */
+
+#include "UniformGridBroadphase.hpp"
+#include <algorithm>
+#include <cmath>
+
+using GolfEngine::UniformGridBroadphase;
+
+void UniformGridBroadphase::findPairs(const GolfEngine::AABB::AABBList &bounds, GolfEngine::CandidatePair::CandidatePairList &pairs)
+{
+    if (bounds.size() < 2)
+    {
+        return;
+    }
+
+    // Fit the grid around everything.
+    GolfEngine::Scalar world_min_x = bounds[0].min_x, world_min_y = bounds[0].min_y;
+    GolfEngine::Scalar world_max_x = bounds[0].max_x, world_max_y = bounds[0].max_y;
+    for (const GolfEngine::AABB &box : bounds)
+    {
+        world_min_x = std::min(world_min_x, box.min_x);
+        world_min_y = std::min(world_min_y, box.min_y);
+        world_max_x = std::max(world_max_x, box.max_x);
+        world_max_y = std::max(world_max_y, box.max_y);
+    }
+    double size = this->cell_size;
+    double max_cells = UniformGridBroadphase::MAX_CELLS_PER_AXIS - 1;
+    size = std::max(size, (world_max_x - world_min_x) / max_cells);
+    size = std::max(size, (world_max_y - world_min_y) / max_cells);
+    unsigned int columns = (unsigned int)((world_max_x - world_min_x) / size) + 1;
+    unsigned int rows = (unsigned int)((world_max_y - world_min_y) / size) + 1;
+
+    // Counting sort every body into each cell its bounds touch, so that
+    // each cell's bodies sit contiguously and in ascending order.
+    this->cell_start.assign((columns * rows) + 1, 0);
+    for (const GolfEngine::AABB &box : bounds)
+    {
+        unsigned int x0 = (unsigned int)((box.min_x - world_min_x) / size);
+        unsigned int x1 = (unsigned int)((box.max_x - world_min_x) / size);
+        unsigned int y0 = (unsigned int)((box.min_y - world_min_y) / size);
+        unsigned int y1 = (unsigned int)((box.max_y - world_min_y) / size);
+        for (unsigned int y = y0; y <= y1; y++)
+        {
+            for (unsigned int x = x0; x <= x1; x++)
+            {
+                this->cell_start[(y * columns) + x + 1]++;
+            }
+        }
+    }
+    for (unsigned int c = 1; c < this->cell_start.size(); c++)
+    {
+        this->cell_start[c] += this->cell_start[c - 1];
+    }
+    this->cell_entries.resize(this->cell_start.back());
+    std::vector<unsigned int> &cursor = this->cell_start;
+    for (unsigned int i = 0; i < bounds.size(); i++)
+    {
+        const GolfEngine::AABB &box = bounds[i];
+        unsigned int x0 = (unsigned int)((box.min_x - world_min_x) / size);
+        unsigned int x1 = (unsigned int)((box.max_x - world_min_x) / size);
+        unsigned int y0 = (unsigned int)((box.min_y - world_min_y) / size);
+        unsigned int y1 = (unsigned int)((box.max_y - world_min_y) / size);
+        for (unsigned int y = y0; y <= y1; y++)
+        {
+            for (unsigned int x = x0; x <= x1; x++)
+            {
+                this->cell_entries[cursor[(y * columns) + x]++] = i;
+            }
+        }
+    }
+    // Filling advanced every cell's start to the next cell's start, so shift it back.
+    for (unsigned int c = this->cell_start.size() - 1; c > 0; c--)
+    {
+        this->cell_start[c] = this->cell_start[c - 1];
+    }
+    this->cell_start[0] = 0;
+
+    for (unsigned int cell = 0; cell < columns * rows; cell++)
+    {
+        unsigned int begin = this->cell_start[cell];
+        unsigned int end = this->cell_start[cell + 1];
+        for (unsigned int p = begin; p < end; p++)
+        {
+            unsigned int i = this->cell_entries[p];
+            for (unsigned int q = p + 1; q < end; q++)
+            {
+                unsigned int j = this->cell_entries[q];
+                if (!bounds[i].overlaps(bounds[j]))
+                {
+                    continue;
+                }
+                // A pair can share several cells. Only report it from the cell holding the
+                // top-left corner of the overlap, so it is reported exactly once.
+                unsigned int owner_x = (unsigned int)((std::max(bounds[i].min_x, bounds[j].min_x) - world_min_x) / size);
+                unsigned int owner_y = (unsigned int)((std::max(bounds[i].min_y, bounds[j].min_y) - world_min_y) / size);
+                if ((owner_y * columns) + owner_x == cell)
+                {
+                    pairs.push_back(GolfEngine::CandidatePair(i, j));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/**
+ * @file UniformGridBroadphase.hpp
+ * @brief This file contains declerations for the UniformGridBroadphase class.
+ *
+ * The uniform grid bins every body's bounds into fixed-size cells, and only tests bodies
+ * that share a cell against each other. It works best when bodies are of similar size
+ * and the cell size is close to that size.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-26
+ */
+
+#ifndef UNIFORMGRIDBROADPHASE_H
+#define UNIFORMGRIDBROADPHASE_H
+
+#include "Broadphase.hpp"
+#include <stdexcept>
+#include <vector>
+
+namespace GolfEngine
+{
+    class UniformGridBroadphase : public GolfEngine::Broadphase
+    {
+    public:
+        /**
+         * @brief Default cell size in pixel units - a quarter of a tile.
+         */
+        static const unsigned int DEFAULT_CELL_SIZE = 16;
+
+        /**
+         * @brief The grid never grows past this many cells along an axis. Cells grow instead.
+         */
+        static const unsigned int MAX_CELLS_PER_AXIS = 1024;
+
+        UniformGridBroadphase() : cell_size(UniformGridBroadphase::DEFAULT_CELL_SIZE) {}
+        UniformGridBroadphase(double cell_size)
+        {
+            if (cell_size <= 0)
+            {
+                throw std::domain_error("Grid cell size must be greater than 0.");
+            }
+            this->cell_size = cell_size;
+        }
+
+        void findPairs(const GolfEngine::AABB::AABBList &bounds, GolfEngine::CandidatePair::CandidatePairList &pairs);
+
+        inline GolfEngine::BroadphaseStrategy getStrategy() const
+        {
+            return GolfEngine::BroadphaseStrategy::UNIFORM_GRID;
+        }
+
+        /**
+         * @brief Get the grid's cell size.
+         *
+         * @returns The cell size in pixel units.
+         */
+        inline double getCellSize() const
+        {
+            return this->cell_size;
+        }
+
+    private:
+        double cell_size;
+
+        // Scratch space, kept between frames to avoid reallocating it.
+        std::vector<unsigned int> cell_start;
+        std::vector<unsigned int> cell_entries;
+    };
+}
+
+#endif
@@ -0,0 +1,160 @@
+/**
+ * @file WallGrid.cpp
+ * @brief This file contains definitions for the WallGrid class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-28
+ */
+
+#include "WallGrid.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+using GolfEngine::WallGrid;
+using GolfEngine::Scalar;
+
+/**
+ * @brief Amount of entries swept per kernel call. Sized to keep the times on the stack.
+ */
+static const std::size_t SWEEP_CHUNK = 64;
+
+/**
+ * @brief Find the normal a swept circle hits a segment with, pointing back towards the circle.
+ *
+ * The kernel only reports times, so the one segment that was hit first is swept again in full to
+ * find which part of it was touched. If rounding makes that sweep just miss, the normal points
+ * from the closest point on the segment instead.
+ */
+static GolfEngine::Vector2 impactNormal(const GolfEngine::Vector2 &center, const GolfEngine::Vector2 &motion, double radius, double time, const GolfEngine::Line &wall)
+{
+    GolfEngine::SweepHit hit;
+    if (GolfEngine::ContinuousCollision::sweepCircle(center, motion, radius, wall, hit))
+    {
+        return hit.normal;
+    }
+    GolfEngine::Vector2 moved = center + (motion * time);
+    GolfEngine::Vector2 direction = wall.b - wall.a;
+    Scalar length_sqr = direction * direction;
+    Scalar along = (length_sqr == 0) ? 0 : ((moved - wall.a) * direction) / length_sqr;
+    along = std::min<Scalar>(std::max<Scalar>(along, 0), 1);
+    GolfEngine::Vector2 normal = moved - (wall.a + (direction * along));
+    Scalar length = normal.magnitude();
+    return (length == 0) ? GolfEngine::Vector2::zero : normal / length;
+}
+
+WallGrid::WallGrid(GolfEngine::Scalar extent, unsigned int cells_per_side) : extent(extent), cells_per_side(cells_per_side), wall_count(0)
+{
+    if (!(extent > 0) || cells_per_side == 0)
+    {
+        throw std::domain_error("Wall grid extent and cell count must be greater than 0.");
+    }
+    this->cell_size = extent / cells_per_side;
+    this->cell_start.assign((cells_per_side * cells_per_side) + 1, 0);
+}
+
+void WallGrid::build(const GolfEngine::Line::LineList &walls)
+{
+    unsigned int cells = this->cells_per_side * this->cells_per_side;
+    this->wall_count = walls.size();
+    this->cell_start.assign(cells + 1, 0);
+
+    // Count entries per cell, then lay them out with a prefix sum.
+    for (const GolfEngine::Line &wall : walls)
+    {
+        unsigned int x0 = this->toCell(std::min(wall.a.x, wall.b.x)), x1 = this->toCell(std::max(wall.a.x, wall.b.x));
+        unsigned int y0 = this->toCell(std::min(wall.a.y, wall.b.y)), y1 = this->toCell(std::max(wall.a.y, wall.b.y));
+        for (unsigned int y = y0; y <= y1; y++)
+        {
+            for (unsigned int x = x0; x <= x1; x++)
+            {
+                this->cell_start[(y * this->cells_per_side) + x + 1]++;
+            }
+        }
+    }
+    for (unsigned int c = 1; c <= cells; c++)
+    {
+        this->cell_start[c] += this->cell_start[c - 1];
+    }
+    std::size_t entries = this->cell_start[cells];
+    this->a_x.resize(entries);
+    this->a_y.resize(entries);
+    this->b_x.resize(entries);
+    this->b_y.resize(entries);
+
+    std::vector<unsigned int> cursor(this->cell_start.begin(), this->cell_start.end() - 1);
+    for (const GolfEngine::Line &wall : walls)
+    {
+        unsigned int x0 = this->toCell(std::min(wall.a.x, wall.b.x)), x1 = this->toCell(std::max(wall.a.x, wall.b.x));
+        unsigned int y0 = this->toCell(std::min(wall.a.y, wall.b.y)), y1 = this->toCell(std::max(wall.a.y, wall.b.y));
+        for (unsigned int y = y0; y <= y1; y++)
+        {
+            for (unsigned int x = x0; x <= x1; x++)
+            {
+                unsigned int entry = cursor[(y * this->cells_per_side) + x]++;
+                this->a_x[entry] = wall.a.x;
+                this->a_y[entry] = wall.a.y;
+                this->b_x[entry] = wall.b.x;
+                this->b_y[entry] = wall.b.y;
+            }
+        }
+    }
+}
+
+bool WallGrid::sweep(const GolfEngine::Vector2 &center, const GolfEngine::Vector2 &motion, double radius, GolfEngine::SweepHit &hit) const
+{
+    if (this->wall_count == 0)
+    {
+        return false;
+    }
+    // Bounds of everything the circle passes over.
+    GolfEngine::Vector2 end = center + motion;
+    Scalar reach = Scalar(radius);
+    Scalar min_x = std::min(center.x, end.x) - reach, max_x = std::max(center.x, end.x) + reach;
+    Scalar min_y = std::min(center.y, end.y) - reach, max_y = std::max(center.y, end.y) + reach;
+    unsigned int x0 = this->toCell(min_x), x1 = this->toCell(max_x);
+    unsigned int y0 = this->toCell(min_y), y1 = this->toCell(max_y);
+
+    GolfEngine::SweptCircle circle;
+    circle.center_x = center.x;
+    circle.center_y = center.y;
+    circle.motion_x = motion.x;
+    circle.motion_y = motion.y;
+    circle.radius = radius;
+    Scalar times[SWEEP_CHUNK];
+    Scalar best_time = 0;
+    std::size_t best = 0;
+    bool found = false;
+    for (unsigned int y = y0; y <= y1; y++)
+    {
+        // Cells x0..x1 of a row are packed back to back, so they are swept as one range.
+        // A wall shared by several of them is swept more than once, which finds the same time each time.
+        std::size_t first = this->cell_start[(y * this->cells_per_side) + x0];
+        std::size_t last = this->cell_start[(y * this->cells_per_side) + x1 + 1];
+        for (std::size_t start = first; start < last; start += SWEEP_CHUNK)
+        {
+            GolfEngine::SegmentBatch segments;
+            segments.a_x = this->a_x.data() + start;
+            segments.a_y = this->a_y.data() + start;
+            segments.b_x = this->b_x.data() + start;
+            segments.b_y = this->b_y.data() + start;
+            segments.count = std::min(SWEEP_CHUNK, last - start);
+            GolfEngine::SweepKernel::sweepSegments(circle, segments, times);
+            for (std::size_t i = 0; i < segments.count; i++)
+            {
+                if (times[i] < hit.time && (!found || times[i] < best_time))
+                {
+                    best_time = times[i];
+                    best = start + i;
+                    found = true;
+                }
+            }
+        }
+    }
+    if (found)
+    {
+        hit.time = best_time;
+        GolfEngine::Line wall(GolfEngine::Vector2(this->a_x[best], this->a_y[best]), GolfEngine::Vector2(this->b_x[best], this->b_y[best]));
+        hit.normal = impactNormal(center, motion, radius, best_time, wall);
+    }
+    return found;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file WallGrid.hpp
+ * @brief This file contains declerations for the WallGrid class.
+ *
+ * A WallGrid bins static wall segments into a small uniform grid, so a swept circle is only
+ * tested against the walls in the cells its sweep passes over. Segments are packed per cell as
+ * structure-of-arrays of GolfEngine::Scalar, so the walls of a cell sit contiguously in memory, and
+ * the cells along a row of the sweep are handed to the \ref GolfEngine::SweepKernel in batches.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-28
+ */
+
+#ifndef WALLGRID_H
+#define WALLGRID_H
+
+#include "../Geometry/Line.hpp"
+#include "ContinuousCollision.hpp"
+#include "SweepKernel.hpp"
+#include <vector>
+
+namespace GolfEngine
+{
+    class WallGrid
+    {
+    public:
+        /**
+         * @brief Default amount of cells along each side of the grid.
+         */
+        static const unsigned int DEFAULT_CELLS_PER_SIDE = 8;
+
+        /**
+         * @param extent Side length of the square area, starting at (0, 0), the grid covers.
+         * @param cells_per_side Amount of cells along each side.
+         * @throws std::domain_error If the extent or cell count is not greater than 0.
+         */
+        WallGrid(GolfEngine::Scalar extent, unsigned int cells_per_side);
+
+        /**
+         * @brief Rebuild the grid around a set of walls.
+         *
+         * Walls may stick out of the grid's area. They are binned into the nearest edge cells.
+         *
+         * @param walls Walls to bin.
+         */
+        void build(const GolfEngine::Line::LineList &walls);
+
+        /**
+         * @brief Sweep a circle against every wall its sweep could touch.
+         *
+         * Walls are swept in GolfEngine::Scalar, so the time of impact can differ from
+         * \ref GolfEngine::ContinuousCollision::sweepCircle "ContinuousCollision::sweepCircle" by rounding.
+         *
+         * @param center Center of the circle at the start of the motion.
+         * @param motion Displacement of the circle over the motion.
+         * @param radius Radius of the circle.
+         * @param hit Filled in with the earliest impact, if it is earlier than hit.time.
+         * @returns True if the circle hits a wall before hit.time, false otherwise.
+         */
+        bool sweep(const GolfEngine::Vector2 &center, const GolfEngine::Vector2 &motion, double radius, GolfEngine::SweepHit &hit) const;
+
+        /**
+         * @brief Get the amount of walls in the grid.
+         *
+         * @returns Wall count.
+         */
+        inline std::size_t size() const
+        {
+            return this->wall_count;
+        }
+
+    private:
+        GolfEngine::Scalar extent;
+        GolfEngine::Scalar cell_size;
+        unsigned int cells_per_side;
+        std::size_t wall_count;
+
+        // Offset of each cell's first entry. Cell c's entries are [cell_start[c], cell_start[c + 1]).
+        std::vector<unsigned int> cell_start;
+
+        // Entries, packed by cell. A wall spanning several cells has an entry in each of them.
+        std::vector<GolfEngine::Scalar> a_x;
+        std::vector<GolfEngine::Scalar> a_y;
+        std::vector<GolfEngine::Scalar> b_x;
+        std::vector<GolfEngine::Scalar> b_y;
+
+        /**
+         * @brief Convert a coordinate into a cell column/row, clamped to the grid.
+         */
+        inline unsigned int toCell(GolfEngine::Scalar coordinate) const
+        {
+            if (!(coordinate > 0))
+            {
+                return 0;
+            }
+            unsigned int cell = (unsigned int)(coordinate / this->cell_size);
+            return (cell >= this->cells_per_side) ? this->cells_per_side - 1 : cell;
+        }
+    };
+}
+
+#endif
@@ -14,7 +14,6 @@
 
 #include "../Geometry/Vector2.hpp"
 #include "RenderableVisitor.hpp"
-#include <SFML/Graphics.hpp>
 #include "../Geometry/Constants.hpp"
 
 namespace GolfEngine
@@ -42,9 +41,11 @@ namespace GolfEngine
         /**
          * @brief Set the object's origin
          *
+         * Virtual, so that subclasses keeping their origin elsewhere (like \ref GolfEngine::Entity "entities") can't be bypassed.
+         *
          * @param origin New origin of object.
          */
-        inline void setOrigin(const GolfEngine::Vector2 origin)
+        virtual void setOrigin(const GolfEngine::Vector2 origin)
         {
             this->origin = origin;
         }
@@ -68,7 +69,7 @@ namespace GolfEngine
          *
          * @return object's origin.
          */
-        inline GolfEngine::Vector2 getOrigin() const
+        virtual GolfEngine::Vector2 getOrigin() const
         {
             return this->origin;
         }
@@ -115,7 +116,7 @@ namespace GolfEngine
          */
         inline GolfEngine::Vector2 localToWorld(GolfEngine::Vector2 local) const
         {
-            return this->origin + local;
+            return this->getOrigin() + local;
         }
 
         /**
@@ -126,7 +127,7 @@ namespace GolfEngine
          */
         inline GolfEngine::Vector2 worldToLocal(GolfEngine::Vector2 world) const
         {
-            return world - this->origin;
+            return world - this->getOrigin();
         }
 
     private:
@@ -10,7 +10,15 @@
 #define RENDERABLE_VISITOR_H
 
 #include "../Geometry/Vector2.hpp"
+#ifdef GOLFENGINE_HEADLESS
+// Headless builds never draw, so they only need the window type's name.
+namespace sf
+{
+    class RenderWindow;
+}
+#else
 #include <SFML/Graphics.hpp>
+#endif
 
 namespace GolfEngine
 {
@@ -8,20 +8,13 @@
 
 #include "Window.hpp"
 #include "../Geometry/Vector2.hpp"
+#include "../Simulation/FixedTimestep.hpp"
 #include <chrono>
+#include <thread>
 #include <stdexcept>
 #include <iostream>
-#include<unistd.h>
 
 using GolfEngine::Window;
-using namespace std::chrono;
-
-unsigned long long getTimestamp()
-{
-    return duration_cast<milliseconds>(
-               system_clock::now().time_since_epoch())
-        .count();
-}
 
 void Window::beginDisplay()
 {
@@ -32,11 +25,13 @@ void Window::beginDisplay()
     GolfEngine::Vector2 screen_size(this->getWidth(), this->getHeight());
     GolfEngine::RenderableVisitor visitor(this->getDisplay(), screen_size);
 
-    unsigned long long now;
-    unsigned long long last_update = getTimestamp();
+    GolfEngine::FixedTimestep timestep;
+    double dt_s = timestep.getStepSeconds();
 
     while (this->render_window->isOpen())
     {
+        GolfEngine::FixedTimestep::Clock::time_point frame_start = GolfEngine::FixedTimestep::Clock::now();
+
         sf::Event event;
         while (this->render_window->pollEvent(event))
         {
@@ -76,18 +71,16 @@ void Window::beginDisplay()
         }
         this->render_window->clear(this->bgcolor);
 
-        // My formatter turned this into poetry.
-        now = getTimestamp();
-
-        unsigned long long time_diff = now - last_update;
-
-        this->active_level->frameUpdate(time_diff);
-
-        last_update = now;
+        // Run however many fixed physics steps fit into the time that has passed.
+        unsigned int steps = timestep.advance();
+        for (unsigned int i = 0; i < steps; i++)
+        {
+            this->active_level->frameUpdate(dt_s);
+        }
 
         this->active_level->visit(&visitor);
 
         this->render_window->display();
-        usleep(33333);
+        std::this_thread::sleep_until(timestep.nextFrame(frame_start));
     }
 }
\ No newline at end of file
@@ -0,0 +1,192 @@
+/**
+ * @file DifficultyEstimator.cpp
+ * @brief This file contains definitions for the DifficultyEstimator class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#include "DifficultyEstimator.hpp"
+#include "Simulation.hpp"
+#include "../GameManagement/Entities/Golfball.hpp"
+#include "../GameManagement/TileGeometry.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using GolfEngine::DifficultyEstimator;
+
+constexpr double DifficultyEstimator::DEFAULT_CELL_SIZE;
+
+/**
+ * @brief Advance a SplitMix64 generator. Used over the standard generators so the shots are the same everywhere.
+ */
+static std::uint64_t nextRandom(std::uint64_t &state)
+{
+    state += 0x9E3779B97F4A7C15ULL;
+    std::uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Draw a uniform value in [0, 1).
+ */
+static double nextUnit(std::uint64_t &state)
+{
+    return (nextRandom(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+DifficultyEstimator::DifficultyEstimator(const LevelFactory &factory, unsigned int worker_count) : pool(worker_count), worlds(factory, pool.size()), tallies(pool.size()), shots_per_tee(DifficultyEstimator::DEFAULT_SHOTS_PER_TEE), max_frames(DifficultyEstimator::DEFAULT_MAX_FRAMES), cell_size(DifficultyEstimator::DEFAULT_CELL_SIZE)
+{
+}
+
+void DifficultyEstimator::setShotsPerTee(unsigned long shots)
+{
+    if (shots == 0)
+    {
+        throw std::invalid_argument("Each tee needs at least one shot.");
+    }
+    this->shots_per_tee = shots;
+}
+
+void DifficultyEstimator::setCellSize(double cell_size)
+{
+    if (!(cell_size > 0))
+    {
+        throw std::domain_error("Cell size must be greater than 0.");
+    }
+    this->cell_size = cell_size;
+}
+
+void DifficultyEstimator::fire(unsigned int worker, std::size_t tee, const GolfEngine::Vector2 &position, unsigned long first, unsigned long count, std::uint64_t seed, const GolfEngine::HeatMap &grid)
+{
+    Tally &tally = this->tallies[worker];
+    const double tau = 6.283185307179586;
+
+    // Each task gets its own stream, picked by what it fires rather than where it runs.
+    std::uint64_t state = seed;
+    state = nextRandom(state) ^ (std::uint64_t)tee;
+    state = nextRandom(state) ^ (std::uint64_t)first;
+    for (unsigned long i = 0; i < count; i++)
+    {
+        double angle = nextUnit(state) * tau;
+        double power = (1 - nextUnit(state)) * GolfEngine::Level::MAX_SWING_FORCE;
+        GolfEngine::Simulation &simulation = this->worlds.reset(worker);
+        GolfEngine::Level *level = simulation.getActiveLevel();
+        level->placeBall(position);
+        GolfEngine::ShotResult result = simulation.simulateShot(GolfEngine::Vector2(std::cos(angle) * power, std::sin(angle) * power), this->max_frames);
+        if (result.reached_goal)
+        {
+            tally.holed[tee]++;
+            continue;
+        }
+        const GolfEngine::Entity::EntityList &balls = level->findEntitiesWithTag(GolfEngine::Tags::GOLFBALL);
+        if (balls.empty())
+        {
+            throw std::runtime_error("Cannot estimate a level without a golfball.");
+        }
+        GolfEngine::Golfball *ball = (GolfEngine::Golfball *)(balls.front());
+        if (ball->getState() != GolfEngine::GolfballStates::STILL)
+        {
+            continue;
+        }
+        tally.settled[tee]++;
+        std::size_t cell = grid.cellAt(ball->getPosition());
+        if (cell < grid.counts.size())
+        {
+            tally.rest_cells.push_back(cell);
+        }
+    }
+}
+
+GolfEngine::DifficultyReport DifficultyEstimator::estimate(const std::vector<GolfEngine::Vector2> &tees, std::uint64_t seed)
+{
+    GolfEngine::DifficultyReport report;
+    report.simulations = 0;
+    report.mean_success_rate = 0;
+    report.success_histogram.assign(DifficultyEstimator::HISTOGRAM_BUCKETS, 0);
+
+    // The grid covers the whole map, measured on the prototype, which is never stepped.
+    double side = this->worlds.getPrototype()->getTilemap()->getSideLength() * (double)GolfEngine::TileGeometry::TILE_SIZE;
+    GolfEngine::HeatMap &grid = report.rest_map;
+    grid.cell_size = this->cell_size;
+    grid.columns = (unsigned int)std::ceil(side / this->cell_size);
+    grid.rows = grid.columns;
+    grid.counts.assign((std::size_t)grid.columns * grid.rows, 0);
+
+    for (Tally &tally : this->tallies)
+    {
+        tally.rest_cells.clear();
+        tally.holed.assign(tees.size(), 0);
+        tally.settled.assign(tees.size(), 0);
+    }
+
+    for (std::size_t t = 0; t < tees.size(); t++)
+    {
+        for (unsigned long first = 0; first < this->shots_per_tee; first += DifficultyEstimator::SHOTS_PER_TASK)
+        {
+            unsigned long count = this->shots_per_tee - first;
+            if (count > DifficultyEstimator::SHOTS_PER_TASK)
+            {
+                count = DifficultyEstimator::SHOTS_PER_TASK;
+            }
+            GolfEngine::Vector2 position = tees[t];
+            this->pool.submit([this, t, position, first, count, seed, &grid](unsigned int worker)
+                              { this->fire(worker, t, position, first, count, seed, grid); });
+        }
+    }
+    this->pool.wait();
+
+    for (Tally &tally : this->tallies)
+    {
+        this->pool.submit([&tally](unsigned int)
+                          { std::sort(tally.rest_cells.begin(), tally.rest_cells.end()); });
+    }
+    this->pool.wait();
+
+    // Sum the tallies, a separate range of cells per task, so no two tasks write the same cell.
+    std::size_t cells = grid.counts.size();
+    std::size_t cells_per_task = std::max<std::size_t>(1024, (cells + this->pool.size() - 1) / this->pool.size());
+    for (std::size_t begin = 0; begin < cells; begin += cells_per_task)
+    {
+        std::size_t end = std::min(cells, begin + cells_per_task);
+        this->pool.submit([this, begin, end, &grid](unsigned int)
+                          {
+            for (const Tally &tally : this->tallies)
+            {
+                std::vector<std::size_t>::const_iterator cell = std::lower_bound(tally.rest_cells.begin(), tally.rest_cells.end(), begin);
+                for (; cell != tally.rest_cells.end() && *cell < end; cell++)
+                {
+                    grid.counts[*cell]++;
+                }
+            } });
+    }
+    this->pool.wait();
+
+    for (std::size_t t = 0; t < tees.size(); t++)
+    {
+        GolfEngine::TeeDifficulty tee;
+        tee.position = tees[t];
+        tee.shots = this->shots_per_tee;
+        tee.holed = 0;
+        tee.settled = 0;
+        for (const Tally &tally : this->tallies)
+        {
+            tee.holed += tally.holed[t];
+            tee.settled += tally.settled[t];
+        }
+        tee.success_rate = (double)tee.holed / tee.shots;
+        unsigned int bucket = std::min(DifficultyEstimator::HISTOGRAM_BUCKETS - 1, (unsigned int)(tee.success_rate * DifficultyEstimator::HISTOGRAM_BUCKETS));
+        report.success_histogram[bucket]++;
+        report.mean_success_rate += tee.success_rate;
+        report.simulations += tee.shots;
+        report.tees.push_back(tee);
+    }
+    if (!tees.empty())
+    {
+        report.mean_success_rate /= tees.size();
+    }
+    return report;
+}
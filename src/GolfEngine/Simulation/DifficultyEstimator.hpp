@@ -0,0 +1,224 @@
+/**
+ * @file DifficultyEstimator.hpp
+ * @brief This file contains declerations for the DifficultyEstimator class.
+ *
+ * A DifficultyEstimator measures how hard a level is by brute force. It fires a large amount of
+ * random shots from each tee position, spread over a WorkStealingPool with a fresh copy of the
+ * level for every shot, and reports how often each tee's shots reach the goal along with a heat map of where
+ * the missed shots came to rest.
+ *
+ * Every worker tallies into its own counts, so the workers never write to shared memory while
+ * shooting. Rather than a heat map each, which on a large course would cost every worker as much as
+ * the whole map, workers only list the cells their missed shots came to rest in. Once every shot is
+ * done, the lists are sorted and summed into the one heat map, with each task summing a separate
+ * range of cells.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#ifndef DIFFICULTYESTIMATOR_H
+#define DIFFICULTYESTIMATOR_H
+
+#include "WorkStealingPool.hpp"
+#include "WorkerWorlds.hpp"
+#include "../GameManagement/Levels/Level.hpp"
+#include "../Geometry/Vector2.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace GolfEngine
+{
+    /**
+     * @brief Counts over a grid of square cells covering a level, from the origin.
+     */
+    struct HeatMap
+    {
+        /**
+         * @brief Side length of a cell, in world units.
+         */
+        double cell_size;
+        unsigned int columns;
+        unsigned int rows;
+        /**
+         * @brief Count of each cell, in row order.
+         */
+        std::vector<unsigned long> counts;
+
+        inline unsigned long at(unsigned int column, unsigned int row) const
+        {
+            return this->counts[column + (row * this->columns)];
+        }
+
+        /**
+         * @brief Find the cell a position falls in.
+         *
+         * @returns Index of the cell, or counts.size() if the position is outside of the grid.
+         */
+        inline std::size_t cellAt(const GolfEngine::Vector2 &position) const
+        {
+            double x = position.x / this->cell_size;
+            double y = position.y / this->cell_size;
+            // Written so that NaN positions fail the check too.
+            if (!(x >= 0 && y >= 0 && x < this->columns && y < this->rows))
+            {
+                return this->counts.size();
+            }
+            return (std::size_t)x + ((std::size_t)y * this->columns);
+        }
+    };
+
+    /**
+     * @brief How the shots from a single tee went.
+     */
+    struct TeeDifficulty
+    {
+        GolfEngine::Vector2 position;
+        unsigned long shots;
+        /**
+         * @brief Shots that reached the goal.
+         */
+        unsigned long holed;
+        /**
+         * @brief Shots that missed and came to rest before the frame limit.
+         */
+        unsigned long settled;
+        /**
+         * @brief Fraction of the shots that reached the goal.
+         */
+        double success_rate;
+    };
+
+    /**
+     * @brief The outcome of a difficulty estimate.
+     */
+    struct DifficultyReport
+    {
+        /**
+         * @brief Results per tee, in the order the tees were given.
+         */
+        std::vector<GolfEngine::TeeDifficulty> tees;
+        /**
+         * @brief Amount of tees per success rate bucket. Bucket i holds rates in [i / n, (i + 1) / n), and the last also holds 1.
+         */
+        std::vector<unsigned long> success_histogram;
+        /**
+         * @brief Success rate averaged over every tee.
+         */
+        double mean_success_rate;
+        /**
+         * @brief Where every shot that missed came to rest.
+         */
+        GolfEngine::HeatMap rest_map;
+        /**
+         * @brief Amount of shots simulated.
+         */
+        unsigned long simulations;
+    };
+
+    class DifficultyEstimator
+    {
+    public:
+        /**
+         * @brief Makes a new, uninitialized, copy of the level to estimate. Called once per shot, plus once for a prototype.
+         */
+        typedef GolfEngine::WorkerWorlds::LevelFactory LevelFactory;
+
+        /**
+         * @brief Default amount of random shots fired from each tee.
+         */
+        static const unsigned long DEFAULT_SHOTS_PER_TEE = 1000;
+        /**
+         * @brief Amount of shots a single task fires. Small enough to balance, large enough that queueing is noise.
+         */
+        static const unsigned long SHOTS_PER_TASK = 32;
+        /**
+         * @brief Default maximum amount of physics steps a single shot may take.
+         */
+        static const unsigned long DEFAULT_MAX_FRAMES = 4000;
+        /**
+         * @brief Amount of buckets in the success rate histogram.
+         */
+        static const unsigned int HISTOGRAM_BUCKETS = 10;
+        /**
+         * @brief Default side length of a heat map cell, in world units.
+         */
+        static constexpr double DEFAULT_CELL_SIZE = 4;
+
+        /**
+         * @param factory Makes copies of the level to estimate. The estimator owns, and deletes, what it makes.
+         * @param worker_count Amount of worker threads. 0 uses one per hardware thread.
+         */
+        DifficultyEstimator(const LevelFactory &factory, unsigned int worker_count = 0);
+
+        /**
+         * @brief Fire random shots from every tee, and tally how they went.
+         *
+         * Shot directions are uniform, and shot strengths uniform up to the level's maximum swing force.
+         * The shots are drawn from a seeded generator per task, so the report only depends on the seed,
+         * not on the amount of workers or how they were scheduled.
+         *
+         * @param tees Positions to fire from.
+         * @param seed Seed for the random shots.
+         * @returns The tallies.
+         */
+        GolfEngine::DifficultyReport estimate(const std::vector<GolfEngine::Vector2> &tees, std::uint64_t seed = 0);
+
+        /**
+         * @brief Set the amount of random shots fired from each tee.
+         *
+         * @throws std::invalid_argument If shots is zero.
+         */
+        void setShotsPerTee(unsigned long shots);
+
+        /**
+         * @brief Set the side length of a heat map cell.
+         *
+         * @throws std::domain_error If the size is not greater than 0.
+         */
+        void setCellSize(double cell_size);
+
+        /**
+         * @brief Set the most physics steps a single shot may take.
+         */
+        inline void setMaxFrames(unsigned long max_frames)
+        {
+            this->max_frames = max_frames;
+        }
+
+        inline unsigned int getWorkerCount() const
+        {
+            return this->pool.size();
+        }
+
+    private:
+        /**
+         * @brief What a single worker has counted. Only ever written by its own worker.
+         */
+        struct Tally
+        {
+            // Heat map cell of every missed shot that came to rest, sorted once shooting is done.
+            std::vector<std::size_t> rest_cells;
+            std::vector<unsigned long> holed;
+            std::vector<unsigned long> settled;
+        };
+
+        GolfEngine::WorkStealingPool pool;
+        GolfEngine::WorkerWorlds worlds;
+        std::vector<Tally> tallies;
+        unsigned long shots_per_tee;
+        unsigned long max_frames;
+        double cell_size;
+
+        /**
+         * @brief Fire a range of a tee's shots in a worker's world.
+         */
+        void fire(unsigned int worker, std::size_t tee, const GolfEngine::Vector2 &position, unsigned long first, unsigned long count, std::uint64_t seed, const GolfEngine::HeatMap &grid);
+
+        // Estimators own threads and levels, and cannot be copied.
+        DifficultyEstimator(const DifficultyEstimator &);
+        DifficultyEstimator &operator=(const DifficultyEstimator &);
+    };
+}
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * @file FixedTimestep.hpp
+ * @brief This file contains declerations for the FixedTimestep class.
+ *
+ * A FixedTimestep accumulates elapsed time on a monotonic, nanosecond resolution clock and
+ * converts it into a whole number of fixed-length physics steps. Physics therefore always
+ * advances by the same dt, no matter how long a rendered frame took.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-23
+ */
+
+#ifndef FIXEDTIMESTEP_H
+#define FIXEDTIMESTEP_H
+
+#include <chrono>
+#include <stdexcept>
+
+namespace GolfEngine
+{
+    class FixedTimestep
+    {
+    public:
+        typedef std::chrono::steady_clock Clock;
+        typedef std::chrono::nanoseconds Duration;
+
+        /**
+         * @brief Default amount of rendered frames per second.
+         */
+        static const unsigned int DEFAULT_FRAME_RATE = 30;
+
+        /**
+         * @brief Default amount of physics steps per rendered frame.
+         */
+        static const unsigned int DEFAULT_SUBSTEPS = 2;
+
+        /**
+         * @brief Default cap on the amount of physics steps run for a single frame.
+         */
+        static const unsigned int DEFAULT_MAX_STEPS = 16;
+
+        FixedTimestep() : FixedTimestep(FixedTimestep::DEFAULT_FRAME_RATE, FixedTimestep::DEFAULT_SUBSTEPS, FixedTimestep::DEFAULT_MAX_STEPS) {}
+
+        /**
+         * @param frame_rate Rendered frames per second.
+         * @param substeps Physics steps per rendered frame.
+         * @param max_steps Maximum amount of physics steps to catch up on in a single frame.
+         * @throws std::domain_error If any argument is zero.
+         */
+        FixedTimestep(unsigned int frame_rate, unsigned int substeps, unsigned int max_steps) : max_steps(max_steps), accumulator(Duration::zero())
+        {
+            if (frame_rate == 0 || substeps == 0 || max_steps == 0)
+            {
+                throw std::domain_error("Frame rate, substeps and max steps must all be greater than 0.");
+            }
+            this->frame = std::chrono::duration_cast<Duration>(std::chrono::seconds(1)) / frame_rate;
+            this->step = this->frame / substeps;
+            this->reset();
+        }
+
+        /**
+         * @brief Get the length of a single physics step.
+         *
+         * @returns Physics step length in seconds.
+         */
+        inline double getStepSeconds() const
+        {
+            return std::chrono::duration_cast<std::chrono::duration<double>>(this->step).count();
+        }
+
+        /**
+         * @brief Get the length of a single rendered frame.
+         *
+         * @returns The frame length.
+         */
+        inline Duration getFrameLength() const
+        {
+            return this->frame;
+        }
+
+        /**
+         * @brief Restart timing from now, discarding any accumulated time.
+         */
+        inline void reset()
+        {
+            this->last_update = Clock::now();
+            this->accumulator = Duration::zero();
+        }
+
+        /**
+         * @brief Consume the time elapsed since the last call.
+         *
+         * @returns The amount of physics steps that should be run. Never more than the max steps.
+         * @note If more time has built up than the max steps can cover (e.g. after a hitch), the
+         * excess is dropped instead of being carried into later frames.
+         */
+        inline unsigned int advance()
+        {
+            Clock::time_point now = Clock::now();
+            this->accumulator += std::chrono::duration_cast<Duration>(now - this->last_update);
+            this->last_update = now;
+
+            unsigned int steps = 0;
+            while (this->accumulator >= this->step && steps < this->max_steps)
+            {
+                this->accumulator -= this->step;
+                steps++;
+            }
+            if (this->accumulator >= this->step)
+            {
+                this->accumulator = this->accumulator % this->step;
+            }
+            return steps;
+        }
+
+        /**
+         * @brief Get the point in time the next rendered frame is due.
+         *
+         * @param frame_start When the current frame started.
+         * @returns The start of the next frame.
+         */
+        inline Clock::time_point nextFrame(Clock::time_point frame_start) const
+        {
+            return frame_start + this->frame;
+        }
+
+    private:
+        Duration frame;
+        Duration step;
+        unsigned int max_steps;
+        Duration accumulator;
+        Clock::time_point last_update;
+    };
+}
+
+#endif
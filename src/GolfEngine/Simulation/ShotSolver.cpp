@@ -0,0 +1,197 @@
+/**
+ * @file ShotSolver.cpp
+ * @brief This file contains definitions for the ShotSolver class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#include "ShotSolver.hpp"
+#include "../GameManagement/Entities/Entity.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using GolfEngine::ShotSolver;
+
+ShotSolver::ShotSolver(const LevelFactory &factory, unsigned int worker_count) : pool(worker_count), worlds(factory, pool.size()), angles(ShotSolver::DEFAULT_ANGLES), powers(ShotSolver::DEFAULT_POWERS), refinements(ShotSolver::DEFAULT_REFINEMENTS), keep(ShotSolver::DEFAULT_KEEP), max_frames(ShotSolver::DEFAULT_MAX_FRAMES)
+{
+}
+
+void ShotSolver::setCoarseGrid(unsigned int angles, unsigned int powers)
+{
+    if (angles == 0 || powers == 0)
+    {
+        throw std::invalid_argument("The coarse grid needs at least one angle and one power.");
+    }
+    this->angles = angles;
+    this->powers = powers;
+}
+
+/**
+ * @brief Find how close the ball is to the nearest goal.
+ */
+static double goalDistance(const GolfEngine::Entity *ball, const GolfEngine::Entity::EntityList &goals)
+{
+    double closest = std::numeric_limits<double>::infinity();
+    for (const GolfEngine::Entity *goal : goals)
+    {
+        closest = std::min(closest, (double)ball->getPosition().distance(goal->getPosition()));
+    }
+    return closest;
+}
+
+void ShotSolver::evaluate(Candidate &candidate, unsigned int worker, const GolfEngine::Vector2 &ball_position)
+{
+    GolfEngine::Simulation &simulation = this->worlds.reset(worker);
+    GolfEngine::Level *level = simulation.getActiveLevel();
+    level->placeBall(ball_position);
+    const GolfEngine::Entity::EntityList &balls = level->findEntitiesWithTag(GolfEngine::Tags::GOLFBALL);
+    if (balls.empty())
+    {
+        throw std::runtime_error("Cannot solve a level without a golfball.");
+    }
+    const GolfEngine::Entity *ball = balls.front();
+    // Copied, as the goal list may change if the ball knocks into anything.
+    GolfEngine::Entity::EntityList goals = level->findEntitiesWithTag(GolfEngine::Tags::GOAL);
+
+    candidate.frames = 0;
+    candidate.reached_goal = false;
+    candidate.closest = goalDistance(ball, goals);
+    simulation.shoot(GolfEngine::Vector2(std::cos(candidate.angle) * candidate.power, std::sin(candidate.angle) * candidate.power));
+    while (candidate.frames < this->max_frames)
+    {
+        simulation.step();
+        candidate.frames++;
+        candidate.closest = std::min(candidate.closest, goalDistance(ball, goals));
+        if (level->hasReachedGoal())
+        {
+            candidate.reached_goal = true;
+            candidate.closest = 0;
+            break;
+        }
+        if (simulation.isSettled())
+        {
+            break;
+        }
+    }
+    candidate.evaluated = true;
+}
+
+std::size_t ShotSolver::runPass(std::vector<Candidate> &candidates, const GolfEngine::Vector2 &ball_position)
+{
+    std::atomic<std::size_t> first_hit(candidates.size());
+    for (std::size_t i = 0; i < candidates.size(); i++)
+    {
+        candidates[i].evaluated = false;
+        candidates[i].reached_goal = false;
+        this->pool.submit([this, i, &candidates, &first_hit, &ball_position](unsigned int worker)
+                          {
+            // A weaker shot already made it, so this one can't be the answer.
+            if (i > first_hit.load())
+            {
+                return;
+            }
+            this->evaluate(candidates[i], worker, ball_position);
+            if (!candidates[i].reached_goal)
+            {
+                return;
+            }
+            std::size_t current = first_hit.load();
+            while (i < current && !first_hit.compare_exchange_weak(current, i))
+            {
+            } });
+    }
+    this->pool.wait();
+    return first_hit.load();
+}
+
+GolfEngine::ShotSolution ShotSolver::solve(const GolfEngine::Vector2 &ball_position, double max_force)
+{
+    if (max_force <= 0)
+    {
+        throw std::domain_error("Maximum force must be greater than 0.");
+    }
+    const double tau = 6.283185307179586;
+    double angle_step = tau / this->angles;
+    double power_step = max_force / this->powers;
+
+    // Coarse pass, weakest first.
+    std::vector<Candidate> candidates;
+    for (unsigned int p = 0; p < this->powers; p++)
+    {
+        for (unsigned int a = 0; a < this->angles; a++)
+        {
+            Candidate candidate;
+            candidate.angle = a * angle_step;
+            candidate.power = (p + 1) * power_step;
+            candidates.push_back(candidate);
+        }
+    }
+
+    GolfEngine::ShotSolution solution;
+    solution.found = false;
+    solution.frames = 0;
+    solution.closest = std::numeric_limits<double>::infinity();
+    solution.simulations = 0;
+    solution.passes = 0;
+    Candidate best;
+    best.angle = 0;
+    best.power = 0;
+    best.closest = std::numeric_limits<double>::infinity();
+    best.frames = 0;
+
+    for (unsigned int pass = 0; pass <= this->refinements && !candidates.empty(); pass++)
+    {
+        std::size_t hit = this->runPass(candidates, ball_position);
+        solution.passes++;
+        for (const Candidate &candidate : candidates)
+        {
+            solution.simulations += candidate.evaluated;
+        }
+        if (hit < candidates.size())
+        {
+            best = candidates[hit];
+            solution.found = true;
+            break;
+        }
+
+        // Nothing made it. Refine around the closest shots, at half the spacing.
+        std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate &lhs, const Candidate &rhs)
+                         { return lhs.closest < rhs.closest; });
+        if (candidates.front().closest < best.closest)
+        {
+            best = candidates.front();
+        }
+        angle_step /= 2;
+        power_step /= 2;
+        std::vector<Candidate> refined;
+        for (std::size_t k = 0; k < this->keep && k < candidates.size(); k++)
+        {
+            for (int da = -1; da <= 1; da++)
+            {
+                for (int dp = -1; dp <= 1; dp++)
+                {
+                    Candidate candidate;
+                    candidate.angle = candidates[k].angle + (da * angle_step);
+                    candidate.power = candidates[k].power + (dp * power_step);
+                    if ((da == 0 && dp == 0) || candidate.power <= 0 || candidate.power > max_force)
+                    {
+                        continue;
+                    }
+                    refined.push_back(candidate);
+                }
+            }
+        }
+        std::stable_sort(refined.begin(), refined.end(), [](const Candidate &lhs, const Candidate &rhs)
+                         { return lhs.power < rhs.power; });
+        candidates.swap(refined);
+    }
+
+    solution.force = GolfEngine::Vector2(std::cos(best.angle) * best.power, std::sin(best.angle) * best.power);
+    solution.frames = best.frames;
+    solution.closest = best.closest;
+    return solution;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file ShotSolver.hpp
+ * @brief This file contains declerations for the ShotSolver class.
+ *
+ * A ShotSolver searches the swing forces for a level, from a given ball position, for a shot that
+ * reaches the goal. Candidate shots are simulated headlessly, spread over a WorkStealingPool, with
+ * each shot run on a fresh copy of the level (see \ref GolfEngine::WorkerWorlds), so the result does
+ * not depend on the amount of workers. The search starts with a coarse polar grid of
+ * forces, then repeatedly refines around the shots that came closest to the goal, stopping as soon
+ * as a pass finds a hit.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#ifndef SHOTSOLVER_H
+#define SHOTSOLVER_H
+
+#include "Simulation.hpp"
+#include "WorkStealingPool.hpp"
+#include "WorkerWorlds.hpp"
+#include "../GameManagement/Levels/Level.hpp"
+#include "../Geometry/Vector2.hpp"
+#include <vector>
+
+namespace GolfEngine
+{
+    /**
+     * @brief The outcome of a search for a shot.
+     */
+    struct ShotSolution
+    {
+        /**
+         * @brief True if a shot reaching the goal was found.
+         */
+        bool found;
+        /**
+         * @brief The shot that reached the goal or, if none did, the shot that came closest.
+         */
+        GolfEngine::Vector2 force;
+        /**
+         * @brief Physics steps the shot took.
+         */
+        unsigned long frames;
+        /**
+         * @brief Closest the ball came to the goal during the shot.
+         */
+        double closest;
+        /**
+         * @brief Amount of shots simulated during the search.
+         */
+        unsigned long simulations;
+        /**
+         * @brief Amount of passes the search took, counting the coarse one.
+         */
+        unsigned int passes;
+    };
+
+    class ShotSolver
+    {
+    public:
+        /**
+         * @brief Makes a new, uninitialized, copy of the level to solve. Called once per shot, plus once for a prototype.
+         */
+        typedef GolfEngine::WorkerWorlds::LevelFactory LevelFactory;
+
+        /**
+         * @brief Default amount of directions in the coarse pass.
+         */
+        static const unsigned int DEFAULT_ANGLES = 32;
+        /**
+         * @brief Default amount of force magnitudes in the coarse pass.
+         */
+        static const unsigned int DEFAULT_POWERS = 16;
+        /**
+         * @brief Default amount of refining passes after the coarse pass.
+         */
+        static const unsigned int DEFAULT_REFINEMENTS = 4;
+        /**
+         * @brief Default amount of the closest shots refined around in each refining pass.
+         */
+        static const unsigned int DEFAULT_KEEP = 8;
+        /**
+         * @brief Default maximum amount of physics steps a single candidate shot may take.
+         */
+        static const unsigned long DEFAULT_MAX_FRAMES = 4000;
+
+        /**
+         * @param factory Makes copies of the level to solve. The solver owns, and deletes, what it makes.
+         * @param worker_count Amount of worker threads. 0 uses one per hardware thread.
+         */
+        ShotSolver(const LevelFactory &factory, unsigned int worker_count = 0);
+
+        /**
+         * @brief Search for a shot that reaches the goal.
+         *
+         * Candidates are ordered weakest force first, and the weakest hit of the first pass that finds
+         * any is returned, so the result doesn't depend on how the workers were scheduled.
+         *
+         * @param ball_position Where the ball is struck from.
+         * @param max_force Strongest force to try.
+         * @returns The best shot found.
+         */
+        GolfEngine::ShotSolution solve(const GolfEngine::Vector2 &ball_position, double max_force = GolfEngine::Level::MAX_SWING_FORCE);
+
+        /**
+         * @brief Set the size of the coarse pass.
+         *
+         * @param angles Amount of directions.
+         * @param powers Amount of force magnitudes.
+         * @throws std::invalid_argument If either is zero.
+         */
+        void setCoarseGrid(unsigned int angles, unsigned int powers);
+
+        /**
+         * @brief Set how the search refines after the coarse pass.
+         *
+         * @param refinements Amount of refining passes.
+         * @param keep Amount of the closest shots refined around in each pass.
+         */
+        inline void setRefinement(unsigned int refinements, unsigned int keep)
+        {
+            this->refinements = refinements;
+            this->keep = keep;
+        }
+
+        /**
+         * @brief Set the most physics steps a single candidate shot may take.
+         */
+        inline void setMaxFrames(unsigned long max_frames)
+        {
+            this->max_frames = max_frames;
+        }
+
+        inline unsigned int getWorkerCount() const
+        {
+            return this->pool.size();
+        }
+
+    private:
+        /**
+         * @brief A shot to try, in polar form, and how it went.
+         */
+        struct Candidate
+        {
+            double angle;
+            double power;
+            bool evaluated;
+            bool reached_goal;
+            unsigned long frames;
+            double closest;
+        };
+
+        GolfEngine::WorkStealingPool pool;
+        GolfEngine::WorkerWorlds worlds;
+        unsigned int angles;
+        unsigned int powers;
+        unsigned int refinements;
+        unsigned int keep;
+        unsigned long max_frames;
+
+        /**
+         * @brief Simulate every candidate across the pool.
+         *
+         * Once a candidate reaches the goal, any later (stronger) candidate still queued is skipped.
+         *
+         * @returns Index of the first candidate to reach the goal, or candidates.size() if none did.
+         */
+        std::size_t runPass(std::vector<Candidate> &candidates, const GolfEngine::Vector2 &ball_position);
+
+        /**
+         * @brief Simulate a single candidate in a worker's world.
+         */
+        void evaluate(Candidate &candidate, unsigned int worker, const GolfEngine::Vector2 &ball_position);
+
+        // Solvers own threads and levels, and cannot be copied.
+        ShotSolver(const ShotSolver &);
+        ShotSolver &operator=(const ShotSolver &);
+    };
+}
+
+#endif
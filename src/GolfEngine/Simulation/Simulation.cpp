@@ -0,0 +1,53 @@
+/**
+ * @file Simulation.cpp
+ * @brief This file contains definitions for the Simulation class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-22
+ */
+
+#include "Simulation.hpp"
+#include "../GameManagement/Entities/Golfball.hpp"
+
+using GolfEngine::Simulation;
+
+bool Simulation::isSettled() const
+{
+    this->requireLevel();
+    for (GolfEngine::Entity *golfball : this->active_level->findEntitiesWithTag(GolfEngine::Tags::GOLFBALL))
+    {
+        GolfEngine::Golfball *player = (GolfEngine::Golfball *)(golfball);
+        if (player->getState() == GolfEngine::GolfballStates::MOVING)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+GolfEngine::ShotResult Simulation::simulateShot(const GolfEngine::Vector2 &force, unsigned long max_frames)
+{
+    GolfEngine::ShotResult result;
+    result.frames = 0;
+    result.reached_goal = false;
+    result.settled = false;
+
+    this->shoot(force);
+    while (result.frames < max_frames)
+    {
+        this->step();
+        result.frames++;
+        if (this->active_level->hasReachedGoal())
+        {
+            result.reached_goal = true;
+            break;
+        }
+        if (this->isSettled())
+        {
+            break;
+        }
+    }
+    result.settled = this->isSettled();
+    result.state_hash = this->getStateHash();
+    return result;
+}
@@ -0,0 +1,217 @@
+/**
+ * @file Simulation.hpp
+ * @brief This file contains declerations for the Simulation class.
+ *
+ * The Simulation class is the headless counterpart to \ref GolfEngine::Window. It drives a
+ * Level's frame updates directly, without a display, event polling or frame pacing, so that
+ * shots can be simulated as fast as the CPU allows.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-22
+ */
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "../GameManagement/Levels/Level.hpp"
+#include "../Geometry/Vector2.hpp"
+#include "FixedTimestep.hpp"
+#include <stdexcept>
+#include <cstdint>
+
+namespace GolfEngine
+{
+    /**
+     * @brief The outcome of a single simulated shot.
+     */
+    struct ShotResult
+    {
+        /**
+         * @brief Number of physics steps that were simulated.
+         */
+        unsigned long frames;
+        /**
+         * @brief True if a golfball reached the goal.
+         */
+        bool reached_goal;
+        /**
+         * @brief True if every golfball came to rest before the frame limit.
+         */
+        bool settled;
+        /**
+         * @brief Hash of the level's physics state once the shot ended. See \ref GolfEngine::Tilemap::hashState.
+         */
+        std::uint64_t state_hash;
+    };
+
+    class Simulation
+    {
+    public:
+        /**
+         * @brief Default maximum amount of physics steps a single shot may take.
+         */
+        static const unsigned long DEFAULT_MAX_FRAMES = 40000;
+
+        /**
+         * @note By default, physics is stepped at the same fixed rate the Window uses.
+         */
+        Simulation() : active_level(nullptr), frames(0), deterministic(false)
+        {
+            this->setStepLength(FixedTimestep().getStepSeconds());
+        }
+        Simulation(double step_s) : active_level(nullptr), frames(0), deterministic(false)
+        {
+            this->setStepLength(step_s);
+        }
+
+        /**
+         * @brief Load a level.
+         *
+         * @param level Level to load.
+         */
+        inline void loadLevel(GolfEngine::Level *level)
+        {
+            this->active_level = level;
+            this->active_level->initialize();
+            this->active_level->getTilemap()->setDeterministic(this->deterministic);
+            this->frames = 0;
+        }
+
+        /**
+         * @brief Get a pointer to the active level.
+         *
+         * @return Pointer to the simulation's currently active level.
+         */
+        inline GolfEngine::Level *getActiveLevel() const
+        {
+            return this->active_level;
+        }
+
+        /**
+         * @brief Get the length of a single physics step.
+         *
+         * @returns Step length in seconds.
+         */
+        inline double getStepLength() const
+        {
+            return this->step_s;
+        }
+
+        /**
+         * @brief Set the length of a single physics step.
+         *
+         * @param step_s New step length in seconds.
+         * @throws std::domain_error If the step is not within (0, 1].
+         */
+        inline void setStepLength(double step_s)
+        {
+            if (step_s <= 0 || step_s > 1)
+            {
+                throw std::domain_error("Step length must be greater than 0 and no greater than 1 second.");
+            }
+            this->step_s = step_s;
+        }
+
+        /**
+         * @brief Get the total amount of physics steps simulated since the level was loaded.
+         *
+         * @returns Simulated step count.
+         */
+        inline unsigned long long getFrameCount() const
+        {
+            return this->frames;
+        }
+
+        /**
+         * @brief Turn deterministic mode on or off, for the active level and any loaded after it.
+         *
+         * Physics is always stepped by a fixed length here. Deterministic mode also rounds state to a
+         * fixed-point lattice every step (see \ref GolfEngine::Tilemap::setDeterministic), so that a
+         * recorded shot can be replayed from its recorded state and checked against its recorded
+         * hashes, without rendering it.
+         *
+         * @param deterministic True to turn deterministic mode on, false to turn it off.
+         */
+        inline void setDeterministic(bool deterministic)
+        {
+            this->deterministic = deterministic;
+            if (this->active_level != nullptr)
+            {
+                this->active_level->getTilemap()->setDeterministic(deterministic);
+            }
+        }
+
+        inline bool isDeterministic() const
+        {
+            return this->deterministic;
+        }
+
+        /**
+         * @brief Hash the active level's physics state. Call after each \ref step "step()" for a per-frame hash.
+         *
+         * @returns Hash of the state. See \ref GolfEngine::Tilemap::hashState.
+         * @throws std::runtime_error If no level has been loaded.
+         */
+        inline std::uint64_t getStateHash() const
+        {
+            this->requireLevel();
+            return this->active_level->getTilemap()->hashState();
+        }
+
+        /**
+         * @brief Strike every still golfball in the active level.
+         *
+         * @param force Swing force to apply.
+         * @throws std::runtime_error If no level has been loaded.
+         */
+        inline void shoot(const GolfEngine::Vector2 &force)
+        {
+            this->requireLevel();
+            this->active_level->applyPlayerForce(force);
+        }
+
+        /**
+         * @brief Advance the active level by a single physics step.
+         *
+         * @throws std::runtime_error If no level has been loaded.
+         */
+        inline void step()
+        {
+            this->requireLevel();
+            this->active_level->frameUpdate(this->step_s);
+            this->frames++;
+        }
+
+        /**
+         * @brief Check whether every golfball in the active level is at rest.
+         *
+         * @returns True if no golfball is moving, false otherwise.
+         */
+        bool isSettled() const;
+
+        /**
+         * @brief Strike the golfball and simulate until it comes to rest or reaches the goal.
+         *
+         * @param force Swing force to apply.
+         * @param max_frames Maximum amount of physics steps to simulate.
+         * @returns The outcome of the shot.
+         */
+        GolfEngine::ShotResult simulateShot(const GolfEngine::Vector2 &force, unsigned long max_frames = Simulation::DEFAULT_MAX_FRAMES);
+
+    private:
+        GolfEngine::Level *active_level;
+        double step_s;
+        unsigned long long frames;
+        bool deterministic;
+
+        inline void requireLevel() const
+        {
+            if (this->active_level == nullptr)
+            {
+                throw std::runtime_error("Cannot simulate with uninitialized level.");
+            }
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ * @file VectorEnvironment.cpp
+ * @brief This file contains definitions for the VectorEnvironment class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#include "VectorEnvironment.hpp"
+#include "../GameManagement/Entities/Entity.hpp"
+#include "../GameManagement/TileGeometry.hpp"
+#include <cmath>
+#include <stdexcept>
+
+using GolfEngine::VectorEnvironment;
+
+VectorEnvironment::VectorEnvironment(const LevelFactory &factory, unsigned int worker_count) : factory(factory), worker_count(worker_count), batch(nullptr), side(1), max_strokes(VectorEnvironment::DEFAULT_MAX_STROKES), max_frames(VectorEnvironment::DEFAULT_MAX_FRAMES)
+{
+}
+
+VectorEnvironment::~VectorEnvironment()
+{
+    delete this->batch;
+}
+
+void VectorEnvironment::setMaxStrokes(unsigned long strokes)
+{
+    if (strokes == 0)
+    {
+        throw std::invalid_argument("An episode needs at least one stroke.");
+    }
+    this->max_strokes = strokes;
+}
+
+void VectorEnvironment::reset(std::size_t count, float *observations)
+{
+    if (count == 0)
+    {
+        throw std::invalid_argument("Cannot reset an environment with no worlds.");
+    }
+    if (this->batch == nullptr || this->batch->size() != count)
+    {
+        delete this->batch;
+        this->batch = nullptr;
+        GolfEngine::WorldBatch *batch = new GolfEngine::WorldBatch(this->factory, count, this->worker_count);
+        // Episodes start where the level puts the ball.
+        GolfEngine::Level *level = batch->getLevel(0);
+        const GolfEngine::Entity::EntityList &balls = level->findEntitiesWithTag(GolfEngine::Tags::GOLFBALL);
+        const GolfEngine::Entity::EntityList &goals = level->findEntitiesWithTag(GolfEngine::Tags::GOAL);
+        if (balls.empty() || goals.empty())
+        {
+            delete batch;
+            throw std::runtime_error("Cannot train on a level without a golfball and a goal.");
+        }
+        this->tee = balls.front()->getPosition();
+        this->goal = goals.front()->getPosition();
+        this->side = level->getTilemap()->getSideLength() * (double)GolfEngine::TileGeometry::TILE_SIZE;
+        this->batch = batch;
+    }
+    this->strokes.assign(count, 0);
+    this->batch->forEachRange([this, observations](std::size_t begin, std::size_t end)
+                              {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            this->batch->placeBall(i, this->tee);
+            this->observe(i, observations + (i * VectorEnvironment::OBSERVATION_SIZE));
+        } });
+}
+
+void VectorEnvironment::step(const float *actions, float *observations, float *rewards, unsigned char *dones)
+{
+    if (this->batch == nullptr)
+    {
+        throw std::logic_error("Cannot step an environment before resetting it.");
+    }
+    this->batch->forEachRange([this, actions, observations, rewards, dones](std::size_t begin, std::size_t end)
+                              {
+        const double max_force = GolfEngine::Level::MAX_SWING_FORCE;
+        for (std::size_t i = begin; i < end; i++)
+        {
+            double force_x = actions[i * VectorEnvironment::ACTION_SIZE] * max_force;
+            double force_y = actions[(i * VectorEnvironment::ACTION_SIZE) + 1] * max_force;
+            double magnitude = std::sqrt((force_x * force_x) + (force_y * force_y));
+            if (!std::isfinite(magnitude))
+            {
+                force_x = 0;
+                force_y = 0;
+            }
+            else if (magnitude > max_force)
+            {
+                force_x *= max_force / magnitude;
+                force_y *= max_force / magnitude;
+            }
+            this->batch->shoot(i, GolfEngine::Vector2(force_x, force_y));
+            this->batch->settleWorld(i, this->max_frames);
+            this->strokes[i]++;
+
+            bool holed = this->batch->getHoled()[i];
+            if (holed)
+            {
+                rewards[i] = 1;
+            }
+            else
+            {
+                double dx = this->batch->getBallX()[i] - this->goal.x;
+                double dy = this->batch->getBallY()[i] - this->goal.y;
+                rewards[i] = (float)(-std::sqrt((dx * dx) + (dy * dy)) / this->side);
+            }
+            bool done = holed || this->strokes[i] >= this->max_strokes;
+            dones[i] = done;
+            if (done)
+            {
+                this->batch->placeBall(i, this->tee);
+                this->strokes[i] = 0;
+            }
+            this->observe(i, observations + (i * VectorEnvironment::OBSERVATION_SIZE));
+        } });
+}
+
+void VectorEnvironment::observe(std::size_t world, float *observation) const
+{
+    observation[0] = (float)(this->batch->getBallX()[world] / this->side);
+    observation[1] = (float)(this->batch->getBallY()[world] / this->side);
+    observation[2] = (float)(this->goal.x / this->side);
+    observation[3] = (float)(this->goal.y / this->side);
+    observation[4] = (float)this->strokes[world] / this->max_strokes;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file VectorEnvironment.hpp
+ * @brief This file contains declerations for the VectorEnvironment class.
+ *
+ * A VectorEnvironment presents a \ref GolfEngine::WorldBatch as a vectorized environment for training
+ * shot selection agents. Each step strikes every world's ball with its own action, simulates every
+ * world until its ball is at rest or in the goal, and writes what the agent sees and earns straight
+ * into buffers the caller owns.
+ *
+ * A world's episode ends when its ball reaches the goal or it runs out of strokes. Ended worlds are
+ * reset straight away, and the observation written for them is the first of their next episode.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#ifndef VECTORENVIRONMENT_H
+#define VECTORENVIRONMENT_H
+
+#include "WorldBatch.hpp"
+#include "../GameManagement/Levels/Level.hpp"
+#include "../Geometry/Vector2.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace GolfEngine
+{
+    class VectorEnvironment
+    {
+    public:
+        /**
+         * @brief Makes a new, uninitialized, copy of the level to train on.
+         */
+        typedef GolfEngine::WorldBatch::LevelFactory LevelFactory;
+
+        /**
+         * @brief Floats per observation: ball x, ball y, goal x, goal y, each over the map's side length, then the fraction of strokes used.
+         */
+        static const unsigned int OBSERVATION_SIZE = 5;
+        /**
+         * @brief Floats per action: swing force x and y, as fractions of \ref GolfEngine::Level::MAX_SWING_FORCE.
+         */
+        static const unsigned int ACTION_SIZE = 2;
+        /**
+         * @brief Default amount of strokes before an episode is cut off.
+         */
+        static const unsigned long DEFAULT_MAX_STROKES = 10;
+        /**
+         * @brief Default maximum amount of physics steps a single stroke may take.
+         */
+        static const unsigned long DEFAULT_MAX_FRAMES = 4000;
+
+        /**
+         * @param factory Makes copies of the level. The environment owns, and deletes, what it makes.
+         * @param worker_count Amount of worker threads. 0 uses one per hardware thread.
+         */
+        VectorEnvironment(const LevelFactory &factory, unsigned int worker_count = 0);
+        ~VectorEnvironment();
+
+        /**
+         * @brief Start a new episode in every world.
+         *
+         * The worlds are only rebuilt if the amount of them changes.
+         *
+         * @param count Amount of worlds.
+         * @param observations Filled in with every world's observation. Must hold count * OBSERVATION_SIZE floats.
+         * @throws std::invalid_argument If count is zero.
+         * @throws std::runtime_error If the level has no golfball or no goal.
+         */
+        void reset(std::size_t count, float *observations);
+
+        /**
+         * @brief Take a stroke in every world.
+         *
+         * Forces longer than the maximum swing force are scaled down to it, and forces that aren't finite are treated as no swing at all.
+         *
+         * @param actions Every world's action. Must hold size() * ACTION_SIZE floats.
+         * @param observations Filled in with every world's observation. Must hold size() * OBSERVATION_SIZE floats.
+         * @param rewards Filled in with every world's reward: 1 for reaching the goal, otherwise minus the distance to the goal over the map's side length.
+         * @param dones Set to 1 for every world whose episode ended (and has been reset), 0 otherwise. Must hold size() bytes.
+         * @throws std::logic_error If \ref reset "reset()" hasn't been called.
+         */
+        void step(const float *actions, float *observations, float *rewards, unsigned char *dones);
+
+        /**
+         * @brief Get the amount of worlds, as of the last reset.
+         */
+        inline std::size_t size() const
+        {
+            return this->batch == nullptr ? 0 : this->batch->size();
+        }
+
+        /**
+         * @brief Set the amount of strokes before an episode is cut off.
+         *
+         * @throws std::invalid_argument If strokes is zero.
+         */
+        void setMaxStrokes(unsigned long strokes);
+
+        /**
+         * @brief Set the most physics steps a single stroke may take.
+         */
+        inline void setMaxFrames(unsigned long max_frames)
+        {
+            this->max_frames = max_frames;
+        }
+
+    private:
+        LevelFactory factory;
+        unsigned int worker_count;
+        GolfEngine::WorldBatch *batch;
+        std::vector<unsigned long> strokes;
+        GolfEngine::Vector2 tee;
+        GolfEngine::Vector2 goal;
+        double side;
+        unsigned long max_strokes;
+        unsigned long max_frames;
+
+        /**
+         * @brief Write a world's observation.
+         */
+        void observe(std::size_t world, float *observation) const;
+
+        // Environments own threads and levels, and cannot be copied.
+        VectorEnvironment(const VectorEnvironment &);
+        VectorEnvironment &operator=(const VectorEnvironment &);
+    };
+}
+
+#endif
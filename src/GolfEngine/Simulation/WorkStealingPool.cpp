@@ -0,0 +1,148 @@
+/**
+ * @file WorkStealingPool.cpp
+ * @brief This file contains definitions for the WorkStealingPool class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#include "WorkStealingPool.hpp"
+
+using GolfEngine::WorkStealingPool;
+
+WorkStealingPool::WorkStealingPool(unsigned int worker_count) : next_queue(0), queued(0), unfinished(0), stopping(false)
+{
+    if (worker_count == 0)
+    {
+        worker_count = std::thread::hardware_concurrency();
+    }
+    if (worker_count == 0)
+    {
+        // The hardware thread count isn't always known.
+        worker_count = 1;
+    }
+    for (unsigned int i = 0; i < worker_count; i++)
+    {
+        this->queues.push_back(new Queue());
+    }
+    for (unsigned int i = 0; i < worker_count; i++)
+    {
+        this->workers.push_back(std::thread(&WorkStealingPool::work, this, i));
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->wake.notify_all();
+    for (std::thread &worker : this->workers)
+    {
+        worker.join();
+    }
+    for (Queue *queue : this->queues)
+    {
+        delete queue;
+    }
+}
+
+void WorkStealingPool::submit(const Task &task)
+{
+    Queue *queue = this->queues[this->next_queue];
+    this->next_queue = (this->next_queue + 1) % this->queues.size();
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->tasks.push_back(task);
+    }
+    {
+        // Counted under the pool's mutex, so a worker about to sleep can't miss it.
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->queued++;
+        this->unfinished++;
+    }
+    this->wake.notify_one();
+}
+
+void WorkStealingPool::wait()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->done.wait(lock, [this]()
+                    { return this->unfinished == 0; });
+    if (this->error)
+    {
+        std::exception_ptr error = this->error;
+        this->error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void WorkStealingPool::work(unsigned int worker)
+{
+    while (true)
+    {
+        if (this->runOne(worker))
+        {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->wake.wait(lock, [this]()
+                        { return this->stopping || this->queued > 0; });
+        if (this->stopping)
+        {
+            return;
+        }
+    }
+}
+
+bool WorkStealingPool::runOne(unsigned int worker)
+{
+    std::size_t count = this->queues.size();
+    for (std::size_t i = 0; i < count; i++)
+    {
+        Queue *queue = this->queues[(worker + i) % count];
+        Task task;
+        {
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            if (queue->tasks.empty())
+            {
+                continue;
+            }
+            // Newest first from our own queue, oldest first from anyone else's.
+            if (i == 0)
+            {
+                task = queue->tasks.back();
+                queue->tasks.pop_back();
+            }
+            else
+            {
+                task = queue->tasks.front();
+                queue->tasks.pop_front();
+            }
+        }
+        this->queued--;
+
+        std::exception_ptr error;
+        try
+        {
+            task(worker);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (error && !this->error)
+        {
+            this->error = error;
+        }
+        if (--this->unfinished == 0)
+        {
+            this->done.notify_all();
+        }
+        return true;
+    }
+    return false;
+}
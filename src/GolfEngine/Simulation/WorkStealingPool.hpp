@@ -0,0 +1,107 @@
+/**
+ * @file WorkStealingPool.hpp
+ * @brief This file contains declerations for the WorkStealingPool class.
+ *
+ * A WorkStealingPool runs tasks on a fixed set of worker threads. Each worker has its own queue,
+ * and takes its newest task first. A worker that runs out of tasks steals the oldest task from
+ * another worker's queue, so uneven tasks (e.g. shots that end after very different amounts of
+ * frames) still keep every core busy.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GolfEngine
+{
+    class WorkStealingPool
+    {
+    public:
+        /**
+         * @brief A task. Called with the index of the worker running it, e.g. to pick per-worker scratch data.
+         */
+        typedef std::function<void(unsigned int worker)> Task;
+
+        /**
+         * @param worker_count Amount of worker threads. 0 uses one per hardware thread.
+         */
+        WorkStealingPool(unsigned int worker_count = 0);
+
+        /**
+         * @brief Finish every queued task, then join every worker.
+         */
+        ~WorkStealingPool();
+
+        /**
+         * @brief Get the amount of worker threads.
+         */
+        inline unsigned int size() const
+        {
+            return (unsigned int)this->workers.size();
+        }
+
+        /**
+         * @brief Queue a task. Tasks are spread over the workers' queues in turn.
+         *
+         * @param task Task to queue.
+         */
+        void submit(const Task &task);
+
+        /**
+         * @brief Block until every queued task has finished.
+         *
+         * @throws Rethrows the first exception thrown by a task since the last wait, if any.
+         */
+        void wait();
+
+    private:
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::thread> workers;
+        std::vector<Queue *> queues;
+        unsigned int next_queue;
+
+        // Guards the counts below, and is what idle workers and waiters sleep on.
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        std::atomic<std::size_t> queued;
+        std::size_t unfinished;
+        bool stopping;
+        std::exception_ptr error;
+
+        /**
+         * @brief Body of each worker thread.
+         */
+        void work(unsigned int worker);
+
+        /**
+         * @brief Take a task from the worker's own queue, or steal one, and run it.
+         *
+         * @returns True if a task was run, false if every queue was empty.
+         */
+        bool runOne(unsigned int worker);
+
+        // Pools own threads, and cannot be copied.
+        WorkStealingPool(const WorkStealingPool &);
+        WorkStealingPool &operator=(const WorkStealingPool &);
+    };
+}
+
+#endif
@@ -0,0 +1,45 @@
+/**
+ * @file WorkerWorlds.cpp
+ * @brief This file contains definitions for the WorkerWorlds class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#include "WorkerWorlds.hpp"
+
+using GolfEngine::WorkerWorlds;
+
+WorkerWorlds::WorkerWorlds(const LevelFactory &factory, unsigned int worker_count) : factory(factory), prototype(nullptr), levels(worker_count, nullptr), simulations(worker_count, nullptr)
+{
+    this->prototype = factory();
+    this->prototype->setQuiet(true);
+    this->prototype->initialize();
+}
+
+WorkerWorlds::~WorkerWorlds()
+{
+    // Copies go before the prototype, as they borrow its geometry.
+    for (std::size_t i = 0; i < this->levels.size(); i++)
+    {
+        delete this->simulations[i];
+        delete this->levels[i];
+    }
+    delete this->prototype;
+}
+
+GolfEngine::Simulation &WorkerWorlds::reset(unsigned int worker)
+{
+    if (this->simulations[worker] == nullptr)
+    {
+        this->simulations[worker] = new GolfEngine::Simulation();
+    }
+    delete this->levels[worker];
+    this->levels[worker] = nullptr;
+    GolfEngine::Level *level = this->factory();
+    this->levels[worker] = level;
+    level->setQuiet(true);
+    this->simulations[worker]->loadLevel(level);
+    level->getTilemap()->shareGeometry(*this->prototype->getTilemap());
+    return *this->simulations[worker];
+}
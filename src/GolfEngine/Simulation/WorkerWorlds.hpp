@@ -0,0 +1,81 @@
+/**
+ * @file WorkerWorlds.hpp
+ * @brief This file contains declerations for the WorkerWorlds class.
+ *
+ * Levels keep all of their state in their own Tilemap, so the only safe way for several threads
+ * to simulate the same level is for each of them to have its own copy. WorkerWorlds keeps one
+ * copy of a level, and a Simulation driving it, per worker of a \ref GolfEngine::WorkStealingPool.
+ *
+ * A shot can leave more behind than where the ball is: scores, whether the goal was reached, which
+ * tile holds which entity and in what order, entities knocked off the map. So a worker's copy is
+ * rebuilt before every shot, and a shot's outcome never depends on which shots its worker ran
+ * before it. Every copy shares the tile geometry of a prototype copy that is never stepped, as
+ * in \ref GolfEngine::WorldBatch, so rebuilding one costs little more than its entities.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#ifndef WORKERWORLDS_H
+#define WORKERWORLDS_H
+
+#include "Simulation.hpp"
+#include "../GameManagement/Levels/Level.hpp"
+#include <functional>
+#include <vector>
+
+namespace GolfEngine
+{
+    class WorkerWorlds
+    {
+    public:
+        /**
+         * @brief Makes a new, uninitialized, copy of a level. Called once for the prototype, and once per shot.
+         */
+        typedef std::function<GolfEngine::Level *()> LevelFactory;
+
+        /**
+         * @param factory Makes copies of the level. WorkerWorlds owns, and deletes, what it makes.
+         * @param worker_count Amount of workers that will ask for a world.
+         * @throws std::logic_error If the factory doesn't make the same tiles every time.
+         */
+        WorkerWorlds(const LevelFactory &factory, unsigned int worker_count);
+        ~WorkerWorlds();
+
+        /**
+         * @brief Give a worker a fresh copy of the level, exactly as the factory makes it.
+         *
+         * Nothing guards this against other threads, so only call it from the worker itself, or while no task is running.
+         *
+         * @param worker Index of the worker.
+         * @returns The worker's simulation, with its new copy of the level loaded. Its previous copy is deleted.
+         * @throws std::logic_error If the factory doesn't make the same tiles every time.
+         */
+        GolfEngine::Simulation &reset(unsigned int worker);
+
+        /**
+         * @brief Get the copy of the level every worker's copy shares its geometry with. It is never stepped.
+         */
+        inline const GolfEngine::Level *getPrototype() const
+        {
+            return this->prototype;
+        }
+
+        inline unsigned int size() const
+        {
+            return (unsigned int)this->simulations.size();
+        }
+
+    private:
+        LevelFactory factory;
+        GolfEngine::Level *prototype;
+        std::vector<GolfEngine::Level *> levels;
+        std::vector<GolfEngine::Simulation *> simulations;
+
+        // Worlds are owned, and cannot be copied.
+        WorkerWorlds(const WorkerWorlds &);
+        WorkerWorlds &operator=(const WorkerWorlds &);
+    };
+}
+
+#endif
@@ -0,0 +1,134 @@
+/**
+ * @file WorldBatch.cpp
+ * @brief This file contains definitions for the WorldBatch class.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#include "WorldBatch.hpp"
+#include "../GameManagement/Entities/Golfball.hpp"
+#include "../GameManagement/Tile.hpp"
+#include <algorithm>
+
+using GolfEngine::WorldBatch;
+
+WorldBatch::WorldBatch(const LevelFactory &factory, std::size_t world_count, unsigned int worker_count, double step_s) : prototype(nullptr), simulations(world_count, GolfEngine::Simulation(step_s)), pool(worker_count), ball_x(world_count, 0), ball_y(world_count, 0), ball_vx(world_count, 0), ball_vy(world_count, 0), moving(world_count, 0), holed(world_count, 0)
+{
+    this->prototype = factory();
+    this->prototype->setQuiet(true);
+    this->prototype->initialize();
+    for (std::size_t i = 0; i < world_count; i++)
+    {
+        GolfEngine::Level *level = factory();
+        this->levels.push_back(level);
+        level->setQuiet(true);
+        this->simulations[i].loadLevel(level);
+        level->getTilemap()->shareGeometry(*this->prototype->getTilemap());
+        this->gather(i);
+    }
+}
+
+WorldBatch::~WorldBatch()
+{
+    // Worlds go before the prototype, as they borrow its geometry.
+    for (GolfEngine::Level *level : this->levels)
+    {
+        delete level;
+    }
+    delete this->prototype;
+}
+
+void WorldBatch::placeBall(std::size_t world, const GolfEngine::Vector2 &position)
+{
+    this->levels[world]->placeBall(position);
+    this->gather(world);
+}
+
+void WorldBatch::shoot(std::size_t world, const GolfEngine::Vector2 &force)
+{
+    this->simulations[world].shoot(force);
+    this->gather(world);
+}
+
+void WorldBatch::step(unsigned long ticks)
+{
+    this->forEachRange([this, ticks](std::size_t begin, std::size_t end)
+                       {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            for (unsigned long tick = 0; tick < ticks; tick++)
+            {
+                this->simulations[i].step();
+            }
+            this->gather(i);
+        } });
+}
+
+void WorldBatch::settle(unsigned long max_frames)
+{
+    this->forEachRange([this, max_frames](std::size_t begin, std::size_t end)
+                       {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            this->settleWorld(i, max_frames);
+        } });
+}
+
+void WorldBatch::settleWorld(std::size_t world, unsigned long max_frames)
+{
+    GolfEngine::Simulation &simulation = this->simulations[world];
+    for (unsigned long frame = 0; frame < max_frames && !this->levels[world]->hasReachedGoal() && !simulation.isSettled(); frame++)
+    {
+        simulation.step();
+    }
+    this->gather(world);
+}
+
+unsigned long long WorldBatch::getFrameCount() const
+{
+    unsigned long long frames = 0;
+    for (const GolfEngine::Simulation &simulation : this->simulations)
+    {
+        frames += simulation.getFrameCount();
+    }
+    return frames;
+}
+
+void WorldBatch::forEachRange(const std::function<void(std::size_t begin, std::size_t end)> &fn)
+{
+    std::size_t count = this->levels.size();
+    std::size_t ranges = (std::size_t)this->pool.size() * WorldBatch::RANGES_PER_WORKER;
+    std::size_t per_range = (count + ranges - 1) / ranges;
+    if (per_range == 0)
+    {
+        return;
+    }
+    for (std::size_t begin = 0; begin < count; begin += per_range)
+    {
+        std::size_t end = std::min(count, begin + per_range);
+        this->pool.submit([&fn, begin, end](unsigned int)
+                          { fn(begin, end); });
+    }
+    this->pool.wait();
+}
+
+void WorldBatch::gather(std::size_t world)
+{
+    GolfEngine::Level *level = this->levels[world];
+    const GolfEngine::Entity::EntityList &balls = level->findEntitiesWithTag(GolfEngine::Tags::GOLFBALL);
+    this->holed[world] = level->hasReachedGoal();
+    if (balls.empty())
+    {
+        this->moving[world] = 0;
+        return;
+    }
+    GolfEngine::Golfball *ball = (GolfEngine::Golfball *)(balls.front());
+    GolfEngine::Vector2 position = ball->getPosition();
+    GolfEngine::Vector2 velocity = ball->getVelocity();
+    this->ball_x[world] = position.x;
+    this->ball_y[world] = position.y;
+    this->ball_vx[world] = velocity.x;
+    this->ball_vy[world] = velocity.y;
+    this->moving[world] = ball->getState() == GolfEngine::GolfballStates::MOVING;
+}
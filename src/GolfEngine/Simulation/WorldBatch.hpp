@@ -0,0 +1,187 @@
+/**
+ * @file WorldBatch.hpp
+ * @brief This file contains declerations for the WorldBatch class.
+ *
+ * A WorldBatch holds many independent copies of a level, and steps all of them together across a
+ * WorkStealingPool. Each task steps a contiguous range of worlds, so no two tasks ever touch the
+ * same world.
+ *
+ * Every copy shares a single copy of the level's tile geometry, kept by a prototype copy that is
+ * never stepped, so a world costs little more than its entities. Each world's live physics state
+ * stays in its own level's entity stores. What callers read back (where its ball is, whether it is
+ * moving or has reached the goal) is copied out of each world after it steps, into structure-of-arrays
+ * buffers indexed by world. The buffers are only a mirror: nothing is stepped in them directly.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#ifndef WORLDBATCH_H
+#define WORLDBATCH_H
+
+#include "Simulation.hpp"
+#include "WorkStealingPool.hpp"
+#include "WorkerWorlds.hpp"
+#include "FixedTimestep.hpp"
+#include "../GameManagement/Levels/Level.hpp"
+#include "../Geometry/Vector2.hpp"
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace GolfEngine
+{
+    class WorldBatch
+    {
+    public:
+        /**
+         * @brief Makes a new, uninitialized, copy of the level. Called once per world, plus once for the prototype.
+         */
+        typedef GolfEngine::WorkerWorlds::LevelFactory LevelFactory;
+
+        /**
+         * @brief Amount of ranges of worlds handed to each worker per step. More balances better, fewer queues less.
+         */
+        static const unsigned int RANGES_PER_WORKER = 4;
+
+        /**
+         * @param factory Makes copies of the level. The batch owns, and deletes, what it makes.
+         * @param world_count Amount of worlds.
+         * @param worker_count Amount of worker threads. 0 uses one per hardware thread.
+         * @param step_s Length of a single physics step, in seconds. Defaults to the rate the Window uses.
+         * @throws std::logic_error If the factory doesn't make the same tiles every time.
+         */
+        WorldBatch(const LevelFactory &factory, std::size_t world_count, unsigned int worker_count = 0, double step_s = GolfEngine::FixedTimestep().getStepSeconds());
+        ~WorldBatch();
+
+        inline std::size_t size() const
+        {
+            return this->levels.size();
+        }
+
+        inline unsigned int getWorkerCount() const
+        {
+            return this->pool.size();
+        }
+
+        /**
+         * @brief Get a world's level, e.g. to read more state than the batch gathers.
+         *
+         * The level must not be touched while a step is running.
+         */
+        inline GolfEngine::Level *getLevel(std::size_t world) const
+        {
+            return this->levels[world];
+        }
+
+        /**
+         * @brief Put a world's ball at a position, at rest. See \ref GolfEngine::Level::placeBall.
+         *
+         * Like \ref shoot, this only touches that world.
+         */
+        void placeBall(std::size_t world, const GolfEngine::Vector2 &position);
+
+        /**
+         * @brief Strike a world's still golfball.
+         */
+        void shoot(std::size_t world, const GolfEngine::Vector2 &force);
+
+        /**
+         * @brief Advance every world by the same amount of physics steps.
+         *
+         * @param ticks Amount of steps.
+         */
+        void step(unsigned long ticks = 1);
+
+        /**
+         * @brief Step each world until its ball comes to rest or reaches the goal.
+         *
+         * Worlds that are already at rest are not stepped. Each world stops on its own, so quick shots
+         * don't wait on slow ones.
+         *
+         * @param max_frames Most steps a single world may take.
+         */
+        void settle(unsigned long max_frames = GolfEngine::Simulation::DEFAULT_MAX_FRAMES);
+
+        /**
+         * @brief Step a single world until its ball comes to rest or reaches the goal.
+         *
+         * Only touches that world, so different worlds may be settled from different threads, e.g. from \ref forEachRange.
+         *
+         * @param world World to settle.
+         * @param max_frames Most steps the world may take.
+         */
+        void settleWorld(std::size_t world, unsigned long max_frames = GolfEngine::Simulation::DEFAULT_MAX_FRAMES);
+
+        /**
+         * @brief Run a function over every world, split into contiguous ranges across the pool, and wait for it.
+         *
+         * The function may call \ref placeBall, \ref shoot and \ref settleWorld for the worlds in its range.
+         *
+         * @param fn Called once per range, with the first world in it and one past the last.
+         */
+        void forEachRange(const std::function<void(std::size_t begin, std::size_t end)> &fn);
+
+        /**
+         * @brief Get the total amount of physics steps taken, summed over every world.
+         */
+        unsigned long long getFrameCount() const;
+
+        // Gathered state, indexed by world. A read-only copy of each world's ball, refreshed after every call that changes a world.
+
+        inline const double *getBallX() const
+        {
+            return this->ball_x.data();
+        }
+        inline const double *getBallY() const
+        {
+            return this->ball_y.data();
+        }
+        inline const double *getBallVelocityX() const
+        {
+            return this->ball_vx.data();
+        }
+        inline const double *getBallVelocityY() const
+        {
+            return this->ball_vy.data();
+        }
+        /**
+         * @brief 1 for every world with a moving golfball, 0 otherwise.
+         */
+        inline const unsigned char *getMoving() const
+        {
+            return this->moving.data();
+        }
+        /**
+         * @brief 1 for every world whose golfball has reached the goal, 0 otherwise.
+         */
+        inline const unsigned char *getHoled() const
+        {
+            return this->holed.data();
+        }
+
+    private:
+        GolfEngine::Level *prototype;
+        std::vector<GolfEngine::Level *> levels;
+        std::vector<GolfEngine::Simulation> simulations;
+        GolfEngine::WorkStealingPool pool;
+
+        std::vector<double> ball_x;
+        std::vector<double> ball_y;
+        std::vector<double> ball_vx;
+        std::vector<double> ball_vy;
+        std::vector<unsigned char> moving;
+        std::vector<unsigned char> holed;
+
+        /**
+         * @brief Copy a world's state into the gathered buffers.
+         */
+        void gather(std::size_t world);
+
+        // Batches own threads and levels, and cannot be copied.
+        WorldBatch(const WorldBatch &);
+        WorldBatch &operator=(const WorldBatch &);
+    };
+}
+
+#endif
@@ -10,8 +10,40 @@
 #include "GolfEngine/Geometry/Vector2.hpp"
 #include "GolfEngine/Geometry/Shapes/Quadrilateral.hpp"
 #include "GolfEngine/Geometry/Line.hpp"
+#include "GolfEngine/Physics/IntegrationKernel.hpp"
+#include "GolfEngine/Physics/Broadphase.hpp"
+#include "GolfEngine/Physics/ContinuousCollision.hpp"
+#include "GolfEngine/Physics/WallGrid.hpp"
+#include "GolfEngine/Physics/HoleMask.hpp"
+#include "GolfEngine/Physics/PolygonKernel.hpp"
+#include "GolfEngine/Physics/SweepKernel.hpp"
+#include "GolfEngine/Physics/Narrowphase.hpp"
+#include "GolfEngine/GameManagement/CollisionDispatch.hpp"
+#include "GolfEngine/GameManagement/TrajectoryPredictor.hpp"
+#include "GolfEngine/GameManagement/Levels/LevelA.hpp"
+#include "GolfEngine/Simulation/WorkStealingPool.hpp"
+#include "GolfEngine/Simulation/ShotSolver.hpp"
+#include "GolfEngine/Simulation/DifficultyEstimator.hpp"
+#include "GolfEngine/Simulation/WorldBatch.hpp"
+#include "GolfEngine/Simulation/VectorEnvironment.hpp"
+#include "GolfEngine/GameManagement/Entities/PolygonEntity.hpp"
+#include "GolfEngine/GameManagement/Entities/Golfball.hpp"
+#include "GolfEngine/GameManagement/Entities/Goal.hpp"
+#include "GolfEngine/GameManagement/Tilemap.hpp"
+#include "GolfEngine/GameManagement/Tiles/FullTile.hpp"
+#include "GolfEngine/GameManagement/FrameArena.hpp"
+#include "golfengine.h"
+#include <cstdint>
 #include <iostream>
 #include <cassert>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <unordered_map>
+#include <sstream>
+#include <string>
 
 #define ABS(n) ((n < 0) ? (-n) : n )
 #define MAX_CLOSENESS 0.01
@@ -42,6 +74,24 @@ void vectorTests(){
     assert((b-b) == a);
     assert(g.normalized() == h);
     assert((b/2) == d);
+    // Normalizing keeps the direction, including its sign.
+    GolfEngine::Vector2 n = GolfEngine::Vector2(-3, 4).normalized();
+    assert(IS_APPROXIMATELY(n.x, -0.6) && IS_APPROXIMATELY(n.y, 0.8));
+    assert(IS_APPROXIMATELY(n.magnitude(), 1));
+    // Arithmetic can be done at compile time, in either precision.
+    static_assert(GolfEngine::Vector2(1, 2) + GolfEngine::Vector2(3, 4) == GolfEngine::Vector2(4, 6), "Vector2 arithmetic should be constexpr.");
+    static_assert(GolfEngine::Vector2d(3, 4).magnitudeSqr() == 25, "Vector2d arithmetic should be constexpr.");
+    static_assert(sizeof(GolfEngine::Vector2f) == 2 * sizeof(float), "Vector2f should be two packed floats.");
+    GolfEngine::Vector2d wide(e);
+    assert(wide.distance(GolfEngine::Vector2d::zero) == 5.0);
+    // Fixed-point vectors give exact, integer results.
+    static_assert(GolfEngine::Vector2x(3, 4).magnitudeSqr() == 25, "Vector2x arithmetic should be constexpr.");
+    static_assert(GolfEngine::Fixed(0.5) * GolfEngine::Fixed(-3) == GolfEngine::Fixed(-1.5), "Fixed multiplication should be exact.");
+    GolfEngine::Vector2x fixed(e);
+    assert(fixed.magnitude() == 5);
+    GolfEngine::Vector2x fixed_n = GolfEngine::Vector2x(-3, 4).normalized();
+    assert(std::abs((fixed_n.x - GolfEngine::Fixed(-0.6)).getRaw()) <= 1 && std::abs((fixed_n.y - GolfEngine::Fixed(0.8)).getRaw()) <= 1);
+    assert(GolfEngine::Vector2d(fixed) == GolfEngine::Vector2d(3, 4));
 }
 
 void quadTests(){
@@ -52,6 +102,1399 @@ void quadTests(){
     assert(IS_APPROXIMATELY(line.length(), 1.0));
 }
 
+void polygonTests(){
+    // Grow well past the inline buffer.
+    GolfEngine::Polygon circleish(3);
+    const unsigned int sides = 40;
+    for(unsigned int i = 0; i < sides; i++){
+        double angle = (GolfEngine::tau * i) / sides;
+        circleish.addPoint(GolfEngine::Vector2(10 * std::cos(angle), 10 * std::sin(angle)));
+    }
+    assert(circleish.getVertexCount() == sides);
+    assert(circleish.getMaxVertices() >= sides);
+    assert(IS_APPROXIMATELY(circleish.getPoint(sides - 1).x, 10 * std::cos(GolfEngine::tau * (sides - 1) / sides)));
+
+    // Copies are independent of each other, and survive being stored by value.
+    GolfEngine::Polygon copy = circleish;
+    copy.setPoint(0, GolfEngine::Vector2(20, 0));
+    assert(circleish.getPoint(0) != copy.getPoint(0));
+    assert(circleish != copy);
+    GolfEngine::Polygon::PolygonList list;
+    for(int i = 0; i < 10; i++){
+        list.push_back(circleish);
+    }
+    GolfEngine::Polygon moved = std::move(list.back());
+    assert(moved == circleish);
+    assert(list.back().getVertexCount() == 0);
+    list.back() = copy;
+    assert(list.back() == copy);
+
+    // Derived data is cached, and updated when a point changes.
+    GolfEngine::Quadrilateral quad(GolfEngine::Vector2(0, 0), GolfEngine::Vector2(2, 0), GolfEngine::Vector2(2, 2), GolfEngine::Vector2(0, 2));
+    assert(IS_APPROXIMATELY(std::abs(quad.getArea()), 4.0));
+    assert(IS_APPROXIMATELY(quad.getCentroid().x, 1.0) && IS_APPROXIMATELY(quad.getCentroid().y, 1.0));
+    quad.setPoint(2, GolfEngine::Vector2(4, 2));
+    quad.setPoint(1, GolfEngine::Vector2(4, 0));
+    assert(IS_APPROXIMATELY(std::abs(quad.getArea()), 8.0));
+    assert(IS_APPROXIMATELY(quad.getPerimeter(), 12.0));
+    assert(IS_APPROXIMATELY(quad.getCentroid().x, 2.0));
+
+    // Setting the point one past the last vertex is rejected, rather than writing past the vertices.
+    bool threw = false;
+    try{
+        quad.setPoint(quad.getVertexCount(), GolfEngine::Vector2(0, 0));
+    }catch(const std::length_error&){
+        threw = true;
+    }
+    assert(threw);
+    assert(quad.getVertexCount() == 4);
+
+    // World data follows the origin.
+    GolfEngine::AABB bounds = quad.getBounds();
+    assert(bounds.min_x == 0 && bounds.max_x == 4 && bounds.max_y == 2);
+    assert(quad.contains(GolfEngine::Vector2(3, 1)));
+    quad.setOrigin(GolfEngine::Vector2(10, 10));
+    bounds = quad.getBounds();
+    assert(bounds.min_x == 10 && bounds.max_y == 12);
+    assert(quad.getWorldVertices()[2] == GolfEngine::Vector2(14, 12));
+    assert(!quad.contains(GolfEngine::Vector2(3, 1)));
+    assert(quad.contains(GolfEngine::Vector2(13, 11)));
+}
+
+void integrationTests(){
+    const std::size_t count = 37; // Not a multiple of any lane width, so the tails get covered too.
+    const double dt_s = 1.0 / 60.0;
+    const double friction = 1.0 - (0.8 * dt_s);
+    std::vector<double> initial(count * 6);
+    std::srand(437);
+    for(std::size_t i = 0; i < initial.size(); i++){
+        // Mix in plenty of values small enough to hit the snap to zero rule.
+        double scale = (i % 3 == 0) ? 1.0 : 5000.0;
+        initial[i] = ((std::rand() / (double)RAND_MAX) * 2.0 - 1.0) * scale;
+    }
+
+    // The reference is the per-entity path through Entity's own methods.
+    std::vector<GolfEngine::Golfball*> balls;
+    for(std::size_t i = 0; i < count; i++){
+        GolfEngine::Golfball* ball = new GolfEngine::Golfball(GolfEngine::Vector2(initial[i], initial[count + i]));
+        ball->setVelocity(GolfEngine::Vector2(initial[(2 * count) + i], initial[(3 * count) + i]));
+        ball->setAcceleration(GolfEngine::Vector2(initial[(4 * count) + i], initial[(5 * count) + i]));
+        balls.push_back(ball);
+    }
+
+    const GolfEngine::IntegrationKernel::Implementation implementations[] = {
+        GolfEngine::IntegrationKernel::SCALAR,
+        GolfEngine::IntegrationKernel::SSE2,
+        GolfEngine::IntegrationKernel::AVX2
+    };
+    for(GolfEngine::IntegrationKernel::Implementation implementation : implementations){
+        if(!GolfEngine::IntegrationKernel::isSupported(implementation)) continue;
+        GolfEngine::IntegrationKernel::setImplementation(implementation);
+
+        std::vector<GolfEngine::Scalar> data(count * 6);
+        for(std::size_t i = 0; i < count; i++){
+            // Load through the entities, so both paths start from identically snapped values.
+            data[i] = balls[i]->getPosition().x;
+            data[count + i] = balls[i]->getPosition().y;
+            data[(2 * count) + i] = balls[i]->getVelocity().x;
+            data[(3 * count) + i] = balls[i]->getVelocity().y;
+            data[(4 * count) + i] = balls[i]->getAcceleration().x;
+            data[(5 * count) + i] = balls[i]->getAcceleration().y;
+        }
+        GolfEngine::IntegrationBatch batch;
+        batch.pos_x = &data[0];
+        batch.pos_y = &data[count];
+        batch.vel_x = &data[2 * count];
+        batch.vel_y = &data[3 * count];
+        batch.acc_x = &data[4 * count];
+        batch.acc_y = &data[5 * count];
+        batch.count = count;
+        GolfEngine::IntegrationKernel::integrate(batch, dt_s, friction);
+
+        for(std::size_t i = 0; i < count; i++){
+            GolfEngine::Golfball reference(balls[i]->getPosition());
+            reference.setVelocity(balls[i]->getVelocity());
+            reference.setAcceleration(balls[i]->getAcceleration());
+            reference.applyAcceleration(dt_s);
+            reference.applyVelocity(dt_s);
+            reference.setVelocity(reference.getVelocity() * friction);
+
+            assert(IS_APPROXIMATELY(batch.pos_x[i], reference.getPosition().x));
+            assert(IS_APPROXIMATELY(batch.pos_y[i], reference.getPosition().y));
+            assert(IS_APPROXIMATELY(batch.vel_x[i], reference.getVelocity().x));
+            assert(IS_APPROXIMATELY(batch.vel_y[i], reference.getVelocity().y));
+            assert(IS_APPROXIMATELY(batch.acc_x[i], reference.getAcceleration().x));
+            assert(IS_APPROXIMATELY(batch.acc_y[i], reference.getAcceleration().y));
+        }
+    }
+    GolfEngine::IntegrationKernel::setImplementation(GolfEngine::IntegrationKernel::detect());
+
+    for(GolfEngine::Golfball* ball : balls){
+        delete ball;
+    }
+}
+
+bool comparePairs(const GolfEngine::CandidatePair& lhs, const GolfEngine::CandidatePair& rhs){
+    return lhs.a < rhs.a || (lhs.a == rhs.a && lhs.b < rhs.b);
+}
+
+void broadphaseTests(){
+    const std::size_t count = 300;
+    std::srand(515);
+    GolfEngine::AABB::AABBList bounds;
+    for(std::size_t i = 0; i < count; i++){
+        double x = (std::rand() / (double)RAND_MAX) * 1000.0;
+        double y = (std::rand() / (double)RAND_MAX) * 1000.0;
+        // Mostly ball sized, with a few boxes big enough to span many grid cells.
+        double half = (i % 25 == 0) ? 150.0 : 2.0 + ((std::rand() / (double)RAND_MAX) * 10.0);
+        bounds.push_back(GolfEngine::AABB(x - half, y - half, x + half, y + half));
+    }
+
+    const GolfEngine::BroadphaseStrategy strategies[] = {
+        GolfEngine::BroadphaseStrategy::UNIFORM_GRID,
+        GolfEngine::BroadphaseStrategy::SWEEP_AND_PRUNE
+    };
+    for(GolfEngine::BroadphaseStrategy strategy : strategies){
+        GolfEngine::Broadphase* broadphase = GolfEngine::Broadphase::create(strategy);
+        assert(broadphase->getStrategy() == strategy);
+        GolfEngine::AABB::AABBList moved = bounds;
+        // Run a few frames, so sweep and prune gets to reuse its order.
+        for(int frame = 0; frame < 3; frame++){
+            GolfEngine::CandidatePair::CandidatePairList expected, found;
+            GolfEngine::BruteForceBroadphase().findPairs(moved, expected);
+            broadphase->findPairs(moved, found);
+            std::sort(found.begin(), found.end(), comparePairs);
+            assert(found.size() == expected.size());
+            for(std::size_t i = 0; i < found.size(); i++){
+                assert(found[i].a < found[i].b);
+                assert(found[i].a == expected[i].a && found[i].b == expected[i].b);
+            }
+            for(GolfEngine::AABB& box : moved){
+                double shift = ((std::rand() / (double)RAND_MAX) * 2.0 - 1.0) * 5.0;
+                box.min_x += shift;
+                box.max_x += shift;
+            }
+        }
+        delete broadphase;
+    }
+}
+
+void tilemapTests(){
+    const double size = GolfEngine::TileGeometry::TILE_SIZE;
+    // One dense map and one big enough to be chunked.
+    const unsigned int side_lengths[] = {8, 1024};
+    for(unsigned int side_length : side_lengths){
+        GolfEngine::Tilemap* map = new GolfEngine::Tilemap(side_length);
+        std::vector<GolfEngine::Tile*> tiles;
+        // Add out of order, and across a chunk boundary.
+        const unsigned int coordinates[][2] = {{3, 2}, {2, 2}, {2, 1}, {3, 3}, {0, 0}, {7, 7}};
+        for(const unsigned int* c : coordinates){
+            GolfEngine::Tile* tile = new GolfEngine::FullTile(GolfEngine::Vector2(c[0] * size, c[1] * size));
+            assert(map->addTile(tile));
+            tiles.push_back(tile);
+        }
+        assert(!map->addTile(tiles[0]));
+
+        assert(map->getTile(3, 2) == tiles[0]);
+        assert(map->getTile(1, 1) == nullptr);
+        assert(map->getTile(side_length, 0) == nullptr);
+        assert(map->findTile(GolfEngine::Vector2((2 * size) + 5, size + 5)) == tiles[2]);
+        assert(map->getTileIndex(GolfEngine::Vector2((2 * size) + 5, size + 5)) == (int)(2 + side_length));
+        assert(map->getTileIndex(GolfEngine::Vector2(-1, 0)) == -1);
+        assert(map->getTileIndex(GolfEngine::Vector2(0, side_length * size)) == -1);
+        assert(map->getTileIndex(GolfEngine::Vector2(std::nan(""), 0)) == -1);
+        GolfEngine::Tile* outside = new GolfEngine::FullTile(GolfEngine::Vector2(side_length * size, 0));
+        assert(!map->addTile(outside));
+        delete outside;
+
+        assert(tiles[1]->getNeighbour(GolfEngine::TileDirection::EAST) == tiles[0]);
+        assert(tiles[0]->getNeighbour(GolfEngine::TileDirection::WEST) == tiles[1]);
+        assert(tiles[1]->getNeighbour(GolfEngine::TileDirection::NORTH) == tiles[2]);
+        assert(tiles[2]->getNeighbour(GolfEngine::TileDirection::SOUTH) == tiles[1]);
+        assert(tiles[0]->getNeighbour(GolfEngine::TileDirection::SOUTH) == tiles[3]);
+        assert(tiles[4]->getNeighbour(GolfEngine::TileDirection::NORTH) == nullptr);
+        assert(tiles[4]->getNeighbour(GolfEngine::TileDirection::WEST) == nullptr);
+
+        // Entity views skip empty tiles and walk everything else in tile order.
+        assert(map->getAllEntities().empty());
+        GolfEngine::Golfball* first = new GolfEngine::Golfball(GolfEngine::Vector2((2 * size) + 1, size + 1));
+        GolfEngine::Golfball* second = new GolfEngine::Golfball(GolfEngine::Vector2((3 * size) + 1, (3 * size) + 1));
+        GolfEngine::Golfball* third = new GolfEngine::Golfball(GolfEngine::Vector2((3 * size) + 2, (3 * size) + 2));
+        tiles[3]->addEntity(second);
+        tiles[3]->addEntity(third);
+        tiles[2]->addEntity(first);
+        std::vector<GolfEngine::Entity*> walked;
+        for(GolfEngine::Entity* ent : map->getAllEntities()){
+            walked.push_back(ent);
+        }
+        assert(walked.size() == 3 && walked[0] == first && walked[1] == second && walked[2] == third);
+        std::size_t visited = 0;
+        map->forEachEntity([&](GolfEngine::Entity* ent){ assert(ent == walked[visited]); visited++; });
+        assert(visited == 3);
+        visited = 0;
+        map->forEachEntityWithTag(GolfEngine::Tags::GOLFBALL, [&](GolfEngine::Entity*){ visited++; });
+        assert(visited == 3);
+        delete first;
+        delete second;
+        delete third;
+
+        const std::vector<GolfEngine::Tile*>& ordered = map->getTiles();
+        assert(ordered.size() == tiles.size());
+        for(std::size_t i = 1; i < ordered.size(); i++){
+            assert(ordered[i - 1]->getMapIndex() < ordered[i]->getMapIndex());
+        }
+
+        // The map has to go first, since it unhooks itself from its tiles.
+        delete map;
+        for(GolfEngine::Tile* tile : tiles){
+            delete tile;
+        }
+    }
+
+    // Entities only move tile through the dirty list.
+    GolfEngine::Tilemap* map = new GolfEngine::Tilemap();
+    GolfEngine::Tile* left = new GolfEngine::FullTile(GolfEngine::Vector2(0, 0));
+    GolfEngine::Tile* right = new GolfEngine::FullTile(GolfEngine::Vector2(size, 0));
+    map->addTile(left);
+    map->addTile(right);
+    GolfEngine::Golfball* ball = new GolfEngine::Golfball(GolfEngine::Vector2(32, 32));
+    GolfEngine::Golfball* doomed = new GolfEngine::Golfball(GolfEngine::Vector2(16, 16));
+    GolfEngine::Golfball* follower = new GolfEngine::Golfball(GolfEngine::Vector2(48, 48));
+    left->addEntity(ball);
+    left->addEntity(doomed);
+    left->addEntity(follower);
+    ball->setRespawnPosition(GolfEngine::Vector2(10, 10));
+
+    ball->setPosition(GolfEngine::Vector2(size + 6, 32));
+    doomed->setPosition(GolfEngine::Vector2(size + 6, 16));
+    follower->setPosition(GolfEngine::Vector2(size + 6, 48));
+    delete doomed; // Deleting a dirty entity must take it off the dirty list, without losing the ones around it.
+    map->reorderEntities();
+    assert(ball->getEntityStore() == right->getEntityStore());
+    assert(follower->getEntityStore() == right->getEntityStore());
+    delete follower;
+
+    // Through a Renderable, an entity's origin is still its position in the store.
+    GolfEngine::Renderable* renderable = ball;
+    renderable->setOrigin(GolfEngine::Vector2(size + 8, 32));
+    assert(ball->getPosition() == GolfEngine::Vector2(size + 8, 32));
+    assert(renderable->getOrigin() == ball->getPosition());
+    assert(renderable->localToWorld(GolfEngine::Vector2(1, 1)) == GolfEngine::Vector2(size + 9, 33));
+    map->reorderEntities();
+    assert(ball->getEntityStore() == right->getEntityStore());
+
+    ball->setPosition(GolfEngine::Vector2(-5, 32));
+    map->reorderEntities();
+    assert(ball->getEntityStore() == left->getEntityStore());
+    assert(ball->getPosition() == GolfEngine::Vector2(10, 10));
+
+    ball->setRespawnPosition(GolfEngine::Vector2(size * 5, 0));
+    ball->setPosition(GolfEngine::Vector2(size * 3, 32));
+    map->reorderEntities();
+    assert(ball->getEntityStore() == nullptr);
+    assert(left->getEntities()->empty() && right->getEntities()->empty());
+
+    delete ball;
+    delete map;
+    delete left;
+    delete right;
+}
+
+void tagTests(){
+    static_assert(GolfEngine::Tags::GOLFBALL.getId() == GolfEngine::Tag::hash("Golfball"), "Tag literals should hash at compile time.");
+    assert(GolfEngine::Tag("Golfball") == GolfEngine::Tags::GOLFBALL);
+    assert(GolfEngine::Tag(std::string("Goal")) == GolfEngine::Tags::GOAL);
+    assert(GolfEngine::Tags::GOAL != GolfEngine::Tags::OBSTACLE);
+    assert(GolfEngine::Tags::OBSTACLE.getTag() == "Obstacle");
+    assert(GolfEngine::Tag() == GolfEngine::Tags::DEFAULT);
+    assert(GolfEngine::Tag("Windmill").getTag() == "Windmill");
+    assert(GolfEngine::Tag::literal("Windmill") == "Windmill");
+
+    GolfEngine::Tilemap* map = new GolfEngine::Tilemap();
+    GolfEngine::Tile* tile = new GolfEngine::FullTile(GolfEngine::Vector2(0, 0));
+    GolfEngine::Golfball* early = new GolfEngine::Golfball(GolfEngine::Vector2(8, 8));
+    tile->addEntity(early); // Added before the tile joins the map.
+    map->addTile(tile);
+    GolfEngine::Golfball* late = new GolfEngine::Golfball(GolfEngine::Vector2(16, 16));
+    tile->addEntity(late);
+    assert(map->findEntitiesWithTag(GolfEngine::Tags::GOLFBALL).size() == 2);
+    assert(map->findEntitiesWithTag(GolfEngine::Tags::OBSTACLE).empty());
+
+    early->setTag(GolfEngine::Tags::OBSTACLE);
+    assert(map->findEntitiesWithTag(GolfEngine::Tags::GOLFBALL).size() == 1);
+    assert(map->findEntitiesWithTag(GolfEngine::Tags::GOLFBALL)[0] == late);
+    assert(map->findEntitiesWithTag(GolfEngine::Tags::OBSTACLE)[0] == early);
+
+    delete late;
+    assert(map->findEntitiesWithTag(GolfEngine::Tags::GOLFBALL).empty());
+    delete map;
+    delete tile;
+    delete early;
+}
+
+void arenaTests(){
+    GolfEngine::FrameArena arena(64);
+    // Run a few frames that overflow the first block, then check it stops allocating.
+    std::size_t allocations = 0;
+    for(int frame = 0; frame < 4; frame++){
+        arena.reset();
+        assert(arena.getUsed() == 0);
+        arena.allocate<char>(3); // Knock the offset off alignment.
+        double* values = arena.allocate<double>(40);
+        assert((std::uintptr_t)values % alignof(double) == 0);
+        for(int i = 0; i < 40; i++){
+            values[i] = i;
+        }
+        GolfEngine::Collision* collisions = arena.allocate<GolfEngine::Collision>(10);
+        assert((std::uintptr_t)collisions % alignof(GolfEngine::Collision) == 0);
+        assert(values[39] == 39);
+        if(frame == 1){
+            allocations = arena.getHeapAllocations();
+        }
+        else if(frame > 1){
+            assert(arena.getHeapAllocations() == allocations);
+        }
+    }
+    assert(arena.getCapacity() >= arena.getUsed());
+}
+
+class WalledTile : public GolfEngine::Tile {
+    public:
+        WalledTile(const GolfEngine::Vector2& pos) : GolfEngine::Tile(pos) {}
+        inline void initialize() {
+            // A horizontal wall across the middle of the tile.
+            GolfEngine::Line wall(GolfEngine::Vector2(0, 32), GolfEngine::Vector2(63, 32));
+            this->getTileGeometry()->addLine(wall);
+        }
+        inline float getFriction() override { return 0; }
+};
+
+class CornerTile : public GolfEngine::Tile {
+    public:
+        CornerTile(const GolfEngine::Vector2& pos) : GolfEngine::Tile(pos) {}
+        inline void initialize() {
+            // A wall cutting off the tile's top-left corner.
+            GolfEngine::Line wall(GolfEngine::Vector2(0, 20), GolfEngine::Vector2(20, 0));
+            this->getTileGeometry()->addLine(wall);
+        }
+        inline float getFriction() override { return 0; }
+};
+
+void sweepTests(){
+    // Straight into a segment's face.
+    GolfEngine::Line wall(GolfEngine::Vector2(-10, 50), GolfEngine::Vector2(10, 50));
+    GolfEngine::SweepHit hit;
+    assert(GolfEngine::ContinuousCollision::sweepCircle(GolfEngine::Vector2(0, 0), GolfEngine::Vector2(0, 100), 4, wall, hit));
+    assert(IS_APPROXIMATELY(hit.time, 0.46));
+    assert(IS_APPROXIMATELY(hit.normal.x, 0) && IS_APPROXIMATELY(hit.normal.y, -1));
+
+    // Clipping a segment's end.
+    GolfEngine::Line side(GolfEngine::Vector2(10, 50), GolfEngine::Vector2(30, 50));
+    hit = GolfEngine::SweepHit();
+    assert(GolfEngine::ContinuousCollision::sweepCircle(GolfEngine::Vector2(7, 0), GolfEngine::Vector2(0, 100), 4, side, hit));
+    assert(hit.time < 0.5 && hit.normal.x < 0 && hit.normal.y < 0);
+
+    // Passing alongside, moving away, and stopping short all miss.
+    hit = GolfEngine::SweepHit();
+    assert(!GolfEngine::ContinuousCollision::sweepCircle(GolfEngine::Vector2(0, 0), GolfEngine::Vector2(0, 100), 4, GolfEngine::Line(GolfEngine::Vector2(20, 0), GolfEngine::Vector2(20, 100)), hit));
+    assert(!GolfEngine::ContinuousCollision::sweepCircle(GolfEngine::Vector2(0, 60), GolfEngine::Vector2(0, 100), 4, wall, hit));
+    assert(!GolfEngine::ContinuousCollision::sweepCircle(GolfEngine::Vector2(0, 0), GolfEngine::Vector2(0, 40), 4, wall, hit));
+
+    GolfEngine::Vector2 bounced = GolfEngine::ContinuousCollision::reflect(GolfEngine::Vector2(3, 10), GolfEngine::Vector2(0, -1), 0.5);
+    assert(IS_APPROXIMATELY(bounced.x, 3) && IS_APPROXIMATELY(bounced.y, -5));
+
+    // A ball fast enough to cross the whole tile in one step bounces off of the wall instead.
+    WalledTile tile(GolfEngine::Vector2(0, 0));
+    tile.initialize();
+    GolfEngine::Golfball ball(GolfEngine::Vector2(20, 10));
+    tile.addEntity(&ball);
+    ball.setVelocity(GolfEngine::Vector2(0, 6000));
+    tile.frameUpdate(1.0 / 60.0);
+    assert(ball.getPosition().y < 32 - GolfEngine::Golfball::RADIUS + 0.01);
+    assert(ball.getVelocity().y < 0);
+    assert(IS_APPROXIMATELY(ball.getPosition().x, 20));
+}
+
+void wallGridTests(){
+    // A maze of walls, including ones spanning many cells and ones sticking out of the grid.
+    GolfEngine::Line::LineList walls;
+    for(int i = 0; i < 12; i++){
+        walls.push_back(GolfEngine::Line(GolfEngine::Vector2(i * 5, 3 + (i * 4)), GolfEngine::Vector2(60 - (i * 3), 8 + (i * 4))));
+        walls.push_back(GolfEngine::Line(GolfEngine::Vector2(2 + (i * 5), 0), GolfEngine::Vector2(2 + (i * 5), 10 + (i * 4))));
+    }
+    walls.push_back(GolfEngine::Line(GolfEngine::Vector2(-20, -20), GolfEngine::Vector2(90, 90)));
+    GolfEngine::WallGrid grid(64, 8);
+    grid.build(walls);
+    assert(grid.size() == walls.size());
+
+    std::vector<GolfEngine::Scalar> a_x, a_y, b_x, b_y;
+    for(const GolfEngine::Line& wall : walls){
+        a_x.push_back(wall.a.x); a_y.push_back(wall.a.y);
+        b_x.push_back(wall.b.x); b_y.push_back(wall.b.y);
+    }
+    GolfEngine::SegmentBatch all;
+    all.a_x = a_x.data(); all.a_y = a_y.data();
+    all.b_x = b_x.data(); all.b_y = b_y.data();
+    all.count = walls.size();
+    std::vector<GolfEngine::Scalar> times(walls.size());
+
+    // Every sweep finds the same earliest hit as testing each wall in turn.
+    unsigned int seed = 12345;
+    unsigned int hits = 0;
+    for(int i = 0; i < 2000; i++){
+        double values[4];
+        for(double& value : values){
+            seed = (seed * 1103515245u) + 12345u;
+            value = (double)((seed >> 8) % 8000) / 100.0 - 8;
+        }
+        GolfEngine::Vector2 center(values[0], values[1]);
+        GolfEngine::Vector2 motion((values[2] - 32) / 2, (values[3] - 32) / 2);
+        GolfEngine::SweptCircle circle = {center.x, center.y, motion.x, motion.y, 4};
+        GolfEngine::SweepKernel::sweepSegmentsScalar(circle, all, times.data());
+        double earliest = 1;
+        for(GolfEngine::Scalar time : times){
+            earliest = std::min<double>(earliest, time);
+        }
+        GolfEngine::SweepHit binned;
+        bool expected = earliest < 1;
+        assert(grid.sweep(center, motion, 4, binned) == expected);
+        assert(binned.time == earliest);
+        // And agrees with the exact sweep up to rounding.
+        GolfEngine::SweepHit linear;
+        for(const GolfEngine::Line& wall : walls){
+            GolfEngine::ContinuousCollision::sweepCircle(center, motion, 4, wall, linear);
+        }
+        assert(std::abs(binned.time - linear.time) < 0.001);
+        if(expected && linear.time < 1){
+            assert(IS_APPROXIMATELY(binned.normal.magnitude(), 1));
+            assert(binned.normal * motion <= 0);
+        }
+        hits += expected;
+    }
+    assert(hits > 0);
+
+    // A ball hitting a wall face on bounces straight back.
+    GolfEngine::Line::LineList single;
+    single.push_back(GolfEngine::Line(GolfEngine::Vector2(10, 10), GolfEngine::Vector2(50, 10)));
+    GolfEngine::WallGrid flat(64, 8);
+    flat.build(single);
+    GolfEngine::SweepHit face;
+    assert(flat.sweep(GolfEngine::Vector2(30, 40), GolfEngine::Vector2(0, -40), 4, face));
+    assert(IS_APPROXIMATELY(face.time, 26.0 / 40.0));
+    assert(IS_APPROXIMATELY(face.normal.x, 0) && IS_APPROXIMATELY(face.normal.y, 1));
+
+    // Empty grids never hit.
+    GolfEngine::WallGrid empty(64, 8);
+    GolfEngine::SweepHit hit;
+    assert(!empty.sweep(GolfEngine::Vector2(0, 0), GolfEngine::Vector2(64, 64), 4, hit));
+
+    // Tiles initialize, and build their wall grid, when they are placed.
+    GolfEngine::Tilemap* map = new GolfEngine::Tilemap();
+    WalledTile* tile = new WalledTile(GolfEngine::Vector2(0, 0));
+    map->addTile(tile);
+    assert(tile->getTileGeometry()->getWallGrid().size() == 1);
+    delete map;
+    delete tile;
+}
+
+void sweepKernelTests(){
+    // Random circles against random segments, including points, with a count that isn't a multiple of any lane width.
+    const std::size_t count = 203;
+    std::vector<GolfEngine::Scalar> a_x(count), a_y(count), b_x(count), b_y(count);
+    unsigned int seed = 4242;
+    auto next = [&seed](){
+        seed = (seed * 1103515245u) + 12345u;
+        return (GolfEngine::Scalar)((seed >> 8) % 6400) / 100;
+    };
+    for(std::size_t i = 0; i < count; i++){
+        a_x[i] = next(); a_y[i] = next();
+        b_x[i] = (i % 17 == 0) ? a_x[i] : next();
+        b_y[i] = (i % 17 == 0) ? a_y[i] : next();
+    }
+    GolfEngine::SegmentBatch segments;
+    segments.a_x = a_x.data(); segments.a_y = a_y.data();
+    segments.b_x = b_x.data(); segments.b_y = b_y.data();
+    segments.count = count;
+
+    const GolfEngine::IntegrationKernel::Implementation implementations[] = {
+        GolfEngine::IntegrationKernel::SCALAR,
+        GolfEngine::IntegrationKernel::SSE2,
+        GolfEngine::IntegrationKernel::AVX2,
+    };
+    unsigned int hits = 0;
+    for(int trial = 0; trial < 50; trial++){
+        GolfEngine::SweptCircle circle = {next(), next(), next() - 32, next() - 32, 1 + (next() / 16)};
+        if(trial == 0){
+            // Standing still never hits anything.
+            circle.motion_x = circle.motion_y = 0;
+        }
+        std::vector<GolfEngine::Scalar> expected(count);
+        GolfEngine::SweepKernel::sweepSegmentsScalar(circle, segments, expected.data());
+        for(GolfEngine::IntegrationKernel::Implementation implementation : implementations){
+            if(!GolfEngine::IntegrationKernel::isSupported(implementation)) continue;
+            GolfEngine::SweepKernel::setImplementation(implementation);
+            assert(GolfEngine::SweepKernel::getImplementation() == implementation);
+            std::vector<GolfEngine::Scalar> times(count);
+            GolfEngine::SweepKernel::sweepSegments(circle, segments, times.data());
+            for(std::size_t i = 0; i < count; i++){
+                assert(times[i] == expected[i]);
+            }
+        }
+        for(std::size_t i = 0; i < count; i++){
+            // Matches the double precision sweep, up to rounding.
+            GolfEngine::SweepHit hit;
+            GolfEngine::Line wall(GolfEngine::Vector2(a_x[i], a_y[i]), GolfEngine::Vector2(b_x[i], b_y[i]));
+            GolfEngine::ContinuousCollision::sweepCircle(GolfEngine::Vector2(circle.center_x, circle.center_y), GolfEngine::Vector2(circle.motion_x, circle.motion_y), circle.radius, wall, hit);
+            assert(std::abs(std::min<double>(expected[i], 1) - hit.time) < 0.001);
+            assert(trial != 0 || expected[i] > 1);
+            hits += expected[i] <= 1;
+        }
+    }
+    assert(hits > 0);
+    GolfEngine::SweepKernel::setImplementation(GolfEngine::IntegrationKernel::detect());
+}
+
+void cornerWallTests(){
+    const double size = GolfEngine::TileGeometry::TILE_SIZE;
+    // A 3x3 map, with the only wall in the middle tile. None of the corner tiles border it directly.
+    GolfEngine::Tilemap* map = new GolfEngine::Tilemap(3);
+    std::vector<GolfEngine::Tile*> tiles;
+    for(unsigned int y = 0; y < 3; y++){
+        for(unsigned int x = 0; x < 3; x++){
+            GolfEngine::Vector2 origin(x * size, y * size);
+            GolfEngine::Tile* tile = (x == 1 && y == 1) ? (GolfEngine::Tile*)new CornerTile(origin) : (GolfEngine::Tile*)new GolfEngine::FullTile(origin);
+            map->addTile(tile);
+            tiles.push_back(tile);
+        }
+    }
+
+    // Fired diagonally out of the top-left tile, fast enough to cross the wall within one step.
+    GolfEngine::Golfball* ball = new GolfEngine::Golfball(GolfEngine::Vector2(size - 6, size - 6));
+    tiles[0]->addEntity(ball);
+    ball->setVelocity(GolfEngine::Vector2(2400, 2400));
+    map->frameUpdate(1.0 / 60.0);
+    map->reorderEntities();
+    GolfEngine::Vector2 position = ball->getPosition();
+    assert(position.x + position.y < (2 * size) + 20);
+    assert(ball->getVelocity().x < 0 && ball->getVelocity().y < 0);
+
+    // Tiles off of a map still catch their own walls.
+    GolfEngine::Tile* lone = new CornerTile(GolfEngine::Vector2(0, 0));
+    lone->initialize();
+    GolfEngine::Vector2 end(30, 30), velocity(1800, 1800), acceleration(0, 0);
+    assert(lone->bounceOffWalls(GolfEngine::Vector2(2, 2), 2, end, velocity, acceleration));
+    assert(end.x + end.y < 20);
+
+    delete ball;
+    delete map;
+    for(GolfEngine::Tile* tile : tiles){
+        delete tile;
+    }
+    delete lone;
+}
+
+class HoledTile : public GolfEngine::Tile {
+    public:
+        HoledTile(const GolfEngine::Vector2& pos) : GolfEngine::Tile(pos) {}
+        inline void initialize() {
+            // A round hole right of the tile's center.
+            GolfEngine::Circle hole(8, GolfEngine::Vector2(44, 32));
+            this->getTileGeometry()->addCircle(hole);
+        }
+        inline float getFriction() override { return 0; }
+};
+
+void holeMaskTests(){
+    GolfEngine::TileGeometry geometry(GolfEngine::Vector2(0, 0));
+    GolfEngine::Circle round(6.5, GolfEngine::Vector2(16.25, 15.5));
+    geometry.addCircle(round);
+    // A concave "L" shaped hole.
+    GolfEngine::Polygon bent(6);
+    bent.addPoint(GolfEngine::Vector2(30.5, 30));
+    bent.addPoint(GolfEngine::Vector2(60, 30));
+    bent.addPoint(GolfEngine::Vector2(60, 40.3));
+    bent.addPoint(GolfEngine::Vector2(42, 40.3));
+    bent.addPoint(GolfEngine::Vector2(42, 60));
+    bent.addPoint(GolfEngine::Vector2(30.5, 60));
+    geometry.addPolygon(bent);
+
+    // The mask gives the same answer as the exact tests everywhere, including just off of grid lines.
+    unsigned int inside = 0;
+    for(double y = -2; y < 66; y += 0.37){
+        for(double x = -2; x < 66; x += 0.41){
+            GolfEngine::Vector2 point(x, y);
+            bool expected = round.contains(point) || bent.contains(point);
+            assert(geometry.isInHole(point) == expected);
+            inside += expected;
+        }
+    }
+    assert(inside > 0);
+    assert(geometry.isInHole(GolfEngine::Vector2(16, 16)));
+    assert(geometry.isInHole(GolfEngine::Vector2(35, 55)));
+    assert(!geometry.isInHole(GolfEngine::Vector2(50, 50)));
+
+    GolfEngine::Circle ball(4, GolfEngine::Vector2(15, 14));
+    assert(geometry.checkHoleCollisions(ball));
+
+    // Every cell is answered by the mask alone, except those on a hole's edge.
+    GolfEngine::HoleMask mask(64, 64);
+    GolfEngine::Circle::CircleList circles(1, round);
+    mask.build(circles, GolfEngine::Polygon::PolygonList());
+    assert(mask.lookup(GolfEngine::Vector2(16.5, 15.5)) == GolfEngine::HoleCoverage::FULL);
+    assert(mask.lookup(GolfEngine::Vector2(16.5, 9.2)) == GolfEngine::HoleCoverage::PARTIAL);
+    assert(mask.lookup(GolfEngine::Vector2(40, 40)) == GolfEngine::HoleCoverage::EMPTY);
+    assert(mask.lookup(GolfEngine::Vector2(-1, 0)) == GolfEngine::HoleCoverage::PARTIAL);
+
+    // Moving balls that roll into a hole go back to where they were hit from, and stop there.
+    HoledTile tile(GolfEngine::Vector2(64, 0));
+    tile.initialize();
+    GolfEngine::Golfball rolling(GolfEngine::Vector2(64 + 10, 32));
+    tile.addEntity(&rolling);
+    rolling.setRespawnPosition(GolfEngine::Vector2(64 + 10, 32));
+    rolling.setVelocity(GolfEngine::Vector2(600, 0));
+    rolling.setAcceleration(GolfEngine::Vector2(-60, 0));
+    rolling.setState(GolfEngine::GolfballStates::MOVING);
+    // Balls that aren't moving are left alone, even in a hole.
+    GolfEngine::Golfball resting(GolfEngine::Vector2(64 + 44, 32));
+    tile.addEntity(&resting);
+    bool fell = false;
+    for(int frame = 0; frame < 10 && !fell; frame++){
+        tile.frameUpdate(1.0 / 60.0);
+        fell = rolling.getState() == GolfEngine::GolfballStates::STILL;
+    }
+    assert(fell);
+    assert(rolling.getPosition() == GolfEngine::Vector2(64 + 10, 32));
+    assert(rolling.getVelocity() == GolfEngine::Vector2::zero);
+    assert(rolling.getScore() == 1);
+    assert(tile.getStoppedGolfballs().size() == 1);
+    assert(resting.getPosition() == GolfEngine::Vector2(64 + 44, 32));
+}
+
+void polygonKernelTests(){
+    // A concave star, offset from the origin so world space matters.
+    GolfEngine::Polygon star(GolfEngine::Vector2(30, 30));
+    for(unsigned int i = 0; i < 10; i++){
+        double angle = (GolfEngine::tau * i) / 10;
+        double reach = (i % 2 == 0) ? 20 : 8;
+        star.addPoint(GolfEngine::Vector2(reach * std::cos(angle), reach * std::sin(angle)));
+    }
+
+    const std::size_t count = 203; // Not a multiple of any lane width, so the tails get covered too.
+    std::vector<GolfEngine::Scalar> x(count), y(count), end_x(count), end_y(count);
+    std::srand(5077);
+    for(std::size_t i = 0; i < count; i++){
+        x[i] = (std::rand() / (double)RAND_MAX) * 60;
+        y[i] = (std::rand() / (double)RAND_MAX) * 60;
+        end_x[i] = x[i] + ((std::rand() / (double)RAND_MAX) * 20) - 10;
+        end_y[i] = y[i] + ((std::rand() / (double)RAND_MAX) * 20) - 10;
+    }
+    // Points right on a vertex, and segments along an edge.
+    x[0] = 50; y[0] = 30;
+    end_x[0] = 30 + (8 * std::cos(GolfEngine::tau / 10)); end_y[0] = 30 + (8 * std::sin(GolfEngine::tau / 10));
+    GolfEngine::SegmentBatch segments;
+    segments.a_x = x.data();
+    segments.a_y = y.data();
+    segments.b_x = end_x.data();
+    segments.b_y = end_y.data();
+    segments.count = count;
+
+    const GolfEngine::IntegrationKernel::Implementation implementations[] = {
+        GolfEngine::IntegrationKernel::SCALAR,
+        GolfEngine::IntegrationKernel::SSE2,
+        GolfEngine::IntegrationKernel::AVX2,
+    };
+    unsigned int inside_count = 0, crossed_count = 0;
+    for(GolfEngine::IntegrationKernel::Implementation implementation : implementations){
+        if(!GolfEngine::IntegrationKernel::isSupported(implementation)) continue;
+        GolfEngine::PolygonKernel::setImplementation(implementation);
+        assert(GolfEngine::PolygonKernel::getImplementation() == implementation);
+        std::vector<unsigned char> inside(count), crossed(count);
+        star.contains(x.data(), y.data(), count, inside.data());
+        star.intersects(segments, crossed.data());
+        inside_count = crossed_count = 0;
+        for(std::size_t i = 0; i < count; i++){
+            GolfEngine::Vector2 point(x[i], y[i]);
+            assert((bool)inside[i] == star.contains(point));
+            assert((bool)crossed[i] == star.intersects(GolfEngine::Line(point, GolfEngine::Vector2(end_x[i], end_y[i]))));
+            inside_count += inside[i];
+            crossed_count += crossed[i];
+        }
+    }
+    assert(inside_count > 0 && inside_count < count);
+    assert(crossed_count > 0 && crossed_count < count);
+    GolfEngine::PolygonKernel::setImplementation(GolfEngine::IntegrationKernel::detect());
+
+    // Crossing segments, including the case the old line test missed.
+    GolfEngine::Line across(GolfEngine::Vector2(0, 0), GolfEngine::Vector2(10, 10));
+    assert(across.intersects(GolfEngine::Line(GolfEngine::Vector2(0, 10), GolfEngine::Vector2(10, 0))));
+    assert(!across.intersects(GolfEngine::Line(GolfEngine::Vector2(0, 10), GolfEngine::Vector2(4, 6.5))));
+
+    // Tiles answer batches of hole queries the same way as single ones.
+    GolfEngine::TileGeometry geometry(GolfEngine::Vector2(0, 0));
+    GolfEngine::Polygon hole(star);
+    geometry.addPolygon(hole);
+    GolfEngine::Circle round(5, GolfEngine::Vector2(10, 50));
+    geometry.addCircle(round);
+    std::vector<unsigned char> in_hole(count);
+    geometry.isInHole(x.data(), y.data(), count, in_hole.data());
+    for(std::size_t i = 0; i < count; i++){
+        assert((bool)in_hole[i] == geometry.isInHole(GolfEngine::Vector2(x[i], y[i])));
+    }
+    // Polygons test every wall against their edges through the kernel too.
+    GolfEngine::Line wall(GolfEngine::Vector2(55, 0), GolfEngine::Vector2(55, 63));
+    geometry.addLine(wall);
+    GolfEngine::Quadrilateral block(GolfEngine::Vector2(50, 10), GolfEngine::Vector2(60, 10), GolfEngine::Vector2(60, 20), GolfEngine::Vector2(50, 20));
+    assert(geometry.checkWallCollisions(block));
+    block.setOrigin(GolfEngine::Vector2(-20, 0));
+    assert(!geometry.checkWallCollisions(block));
+}
+
+void narrowphaseTests(){
+    GolfEngine::Contact contact;
+    assert(GolfEngine::Narrowphase::circleCircle(GolfEngine::Vector2(0, 0), 2, GolfEngine::Vector2(3, 0), 2, contact));
+    assert(IS_APPROXIMATELY(contact.normal.x, 1) && IS_APPROXIMATELY(contact.depth, 1));
+    assert(!GolfEngine::Narrowphase::circleCircle(GolfEngine::Vector2(0, 0), 2, GolfEngine::Vector2(5, 0), 2, contact));
+
+    // A 4x4 box centered on the origin, wound both ways.
+    GolfEngine::Vector2 box[4] = {GolfEngine::Vector2(-2, -2), GolfEngine::Vector2(2, -2), GolfEngine::Vector2(2, 2), GolfEngine::Vector2(-2, 2)};
+    GolfEngine::Vector2 reversed[4] = {box[3], box[2], box[1], box[0]};
+
+    // Circle against a face, against a corner, and with its center inside.
+    assert(GolfEngine::Narrowphase::polygonCircle(box, 4, GolfEngine::Vector2(0, 3), 1.5, contact));
+    assert(IS_APPROXIMATELY(contact.normal.y, 1) && IS_APPROXIMATELY(contact.depth, 0.5));
+    assert(GolfEngine::Narrowphase::polygonCircle(reversed, 4, GolfEngine::Vector2(0, 3), 1.5, contact));
+    assert(IS_APPROXIMATELY(contact.normal.y, 1));
+    assert(!GolfEngine::Narrowphase::polygonCircle(box, 4, GolfEngine::Vector2(3, 3), 1, contact));
+    assert(GolfEngine::Narrowphase::polygonCircle(box, 4, GolfEngine::Vector2(2.5, 2.5), 1, contact));
+    assert(IS_APPROXIMATELY(contact.normal.x, contact.normal.y) && contact.normal.x > 0);
+    assert(GolfEngine::Narrowphase::polygonCircle(box, 4, GolfEngine::Vector2(-1.5, 0), 1, contact));
+    assert(IS_APPROXIMATELY(contact.normal.x, -1) && IS_APPROXIMATELY(contact.depth, 1.5));
+
+    // Box against a box overlapping it on the right.
+    GolfEngine::Vector2 other[4];
+    for(int i = 0; i < 4; i++) other[i] = box[i] + GolfEngine::Vector2(3.5, 1);
+    GolfEngine::SeparatingAxis cache;
+    assert(GolfEngine::Narrowphase::polygonPolygon(box, 4, other, 4, contact, cache));
+    assert(IS_APPROXIMATELY(contact.normal.x, 1) && IS_APPROXIMATELY(contact.depth, 0.5));
+    assert(cache.owner != GolfEngine::SeparatingAxis::NONE);
+    assert(GolfEngine::Narrowphase::polygonPolygon(other, 4, reversed, 4, contact, cache));
+    assert(IS_APPROXIMATELY(contact.normal.x, -1));
+
+    // Once apart, the separating axis is remembered and rejects the pair on its own.
+    for(int i = 0; i < 4; i++) other[i] = other[i] + GolfEngine::Vector2(5, 0);
+    cache = GolfEngine::SeparatingAxis();
+    assert(!GolfEngine::Narrowphase::polygonPolygon(box, 4, other, 4, contact, cache));
+    GolfEngine::SeparatingAxis found = cache;
+    assert(!GolfEngine::Narrowphase::polygonPolygon(box, 4, other, 4, contact, cache));
+    assert(cache.owner == found.owner && cache.edge == found.edge);
+
+    // Polygon entities collide through the Tilemap, with contact data.
+    GolfEngine::Tilemap* map = new GolfEngine::Tilemap();
+    GolfEngine::FullTile* tile = new GolfEngine::FullTile(GolfEngine::Vector2(0, 0));
+    map->addTile(tile);
+    GolfEngine::Quadrilateral shape_a(box[0], box[1], box[2], box[3]);
+    GolfEngine::Quadrilateral shape_b(box[0], box[1], box[2], box[3]);
+    GolfEngine::PolygonEntity block_a(&shape_a, GolfEngine::Vector2(20, 20));
+    GolfEngine::PolygonEntity block_b(&shape_b, GolfEngine::Vector2(23, 20));
+    GolfEngine::Golfball ball(GolfEngine::Vector2(20, 25));
+    tile->addEntity(&block_a);
+    tile->addEntity(&block_b);
+    tile->addEntity(&ball);
+    GolfEngine::CollisionSpan collisions = map->frameUpdate(0);
+    unsigned int polygon_pairs = 0, ball_pairs = 0;
+    for(GolfEngine::Collision& collision : collisions){
+        if(collision.getAttached() == &block_a && collision.getCollider() == &block_b){
+            assert(IS_APPROXIMATELY(collision.getNormal().x, 1) && IS_APPROXIMATELY(collision.getDepth(), 1));
+            polygon_pairs++;
+        }
+        if(collision.getAttached() == &ball && collision.getCollider() == &block_a){
+            assert(IS_APPROXIMATELY(collision.getNormal().y, -1));
+            ball_pairs++;
+        }
+    }
+    assert(polygon_pairs == 1 && ball_pairs == 1);
+    delete map;
+    delete tile;
+}
+
+void dispatchTests(){
+    const GolfEngine::Vector2 box[] = {GolfEngine::Vector2(-2, -2), GolfEngine::Vector2(2, -2), GolfEngine::Vector2(2, 2), GolfEngine::Vector2(-2, 2)};
+    const GolfEngine::Vector2 other[] = {GolfEngine::Vector2(1, -2), GolfEngine::Vector2(5, -2), GolfEngine::Vector2(5, 2), GolfEngine::Vector2(1, 2)};
+    int owners[3];
+    GolfEngine::ContactBody square, overlapping, ball;
+    square.kind = GolfEngine::ShapeKind::POLYGON_SHAPE;
+    square.owner = &owners[1];
+    square.vertices = box;
+    square.vertex_count = 4;
+    overlapping.kind = GolfEngine::ShapeKind::POLYGON_SHAPE;
+    overlapping.owner = &owners[0];
+    overlapping.vertices = other;
+    overlapping.vertex_count = 4;
+    ball.owner = &owners[2];
+    ball.position = GolfEngine::Vector2(0, 3);
+    ball.radius = 1.5;
+
+    // Normals point from the first body to the second, whichever order the kinds come in.
+    GolfEngine::SeparatingAxisCache cache;
+    GolfEngine::Contact contact;
+    assert(GolfEngine::CollisionDispatch::findContact(square, ball, cache, contact));
+    assert(IS_APPROXIMATELY(contact.normal.y, 1) && IS_APPROXIMATELY(contact.depth, 0.5));
+    assert(GolfEngine::CollisionDispatch::findContact(ball, square, cache, contact));
+    assert(IS_APPROXIMATELY(contact.normal.y, -1) && IS_APPROXIMATELY(contact.depth, 0.5));
+    assert(GolfEngine::CollisionDispatch::findContact(square, overlapping, cache, contact));
+    assert(IS_APPROXIMATELY(contact.normal.x, 1) && IS_APPROXIMATELY(contact.depth, 1));
+    assert(GolfEngine::CollisionDispatch::findContact(overlapping, square, cache, contact));
+    assert(IS_APPROXIMATELY(contact.normal.x, -1) && IS_APPROXIMATELY(contact.depth, 1));
+    assert(GolfEngine::CollisionDispatch::getTest(GolfEngine::ShapeKind::CIRCLE_SHAPE, GolfEngine::ShapeKind::CIRCLE_SHAPE)(ball, ball, cache, contact));
+
+    // Both orders of a polygon pair share one cache entry, which is dropped once the pair stops being tested.
+    assert(cache.size() == 1);
+    cache.prune();
+    assert(cache.size() == 1);
+    cache.prune();
+    assert(cache.size() == 0);
+}
+
+/**
+ * @brief Roll a few balls across a 2x2 map in deterministic mode, recording the state hash after every frame.
+ */
+std::vector<std::uint64_t> recordHashes(GolfEngine::IntegrationKernel::Implementation implementation){
+    GolfEngine::IntegrationKernel::setImplementation(implementation);
+    const double size = GolfEngine::TileGeometry::TILE_SIZE;
+    GolfEngine::Tilemap* map = new GolfEngine::Tilemap(2);
+    std::vector<GolfEngine::Tile*> tiles;
+    for(unsigned int i = 0; i < 4; i++){
+        tiles.push_back(new GolfEngine::FullTile(GolfEngine::Vector2((i % 2) * size, (i / 2) * size)));
+        map->addTile(tiles.back());
+    }
+    map->setDeterministic(true);
+    std::vector<GolfEngine::Golfball*> balls;
+    for(unsigned int i = 0; i < 5; i++){
+        balls.push_back(new GolfEngine::Golfball(GolfEngine::Vector2(10 + (i * 9), 10 + (i * 5))));
+        balls.back()->setVelocity(GolfEngine::Vector2(90.3 - (i * 17.1), 70.7 + (i * 11.9)));
+        tiles[0]->addEntity(balls.back());
+    }
+    std::vector<std::uint64_t> hashes;
+    for(unsigned int frame = 0; frame < 120; frame++){
+        map->reorderEntities();
+        map->frameUpdate(1.0 / 60.0);
+        hashes.push_back(map->hashState());
+    }
+    // Deterministic mode leaves state on the fixed-point lattice.
+    const double scale = (double)(1ULL << GolfEngine::Tilemap::FIXED_POINT_BITS);
+    for(GolfEngine::Tile* tile : tiles){
+        GolfEngine::EntityStore* store = tile->getEntityStore();
+        for(std::size_t i = 0; i < store->size(); i++){
+            assert(store->pos_x[i] * scale == std::round(store->pos_x[i] * scale));
+            assert(store->vel_y[i] * scale == std::round(store->vel_y[i] * scale));
+        }
+    }
+    delete map;
+    for(GolfEngine::Golfball* ball : balls) delete ball;
+    for(GolfEngine::Tile* tile : tiles) delete tile;
+    return hashes;
+}
+
+void determinismTests(){
+    GolfEngine::IntegrationKernel::Implementation original = GolfEngine::IntegrationKernel::getImplementation();
+    std::vector<std::uint64_t> reference = recordHashes(GolfEngine::IntegrationKernel::SCALAR);
+    // The state changes from frame to frame, and so does the hash.
+    assert(reference.front() != reference.back());
+    // Replays hash the same, frame for frame, whichever kernel does the integration.
+    assert(recordHashes(GolfEngine::IntegrationKernel::SCALAR) == reference);
+    const GolfEngine::IntegrationKernel::Implementation implementations[] = {
+        GolfEngine::IntegrationKernel::SSE2,
+        GolfEngine::IntegrationKernel::AVX2
+    };
+    for(GolfEngine::IntegrationKernel::Implementation implementation : implementations){
+        if(!GolfEngine::IntegrationKernel::isSupported(implementation)) continue;
+        assert(recordHashes(implementation) == reference);
+    }
+    GolfEngine::IntegrationKernel::setImplementation(original);
+}
+
+void trajectoryTests(){
+    const double size = GolfEngine::TileGeometry::TILE_SIZE;
+    const double dt_s = 1.0 / 60.0;
+    GolfEngine::Tilemap* map = new GolfEngine::Tilemap(2);
+    std::vector<GolfEngine::Tile*> tiles;
+    tiles.push_back(new WalledTile(GolfEngine::Vector2(0, 0)));
+    tiles.push_back(new GolfEngine::FullTile(GolfEngine::Vector2(size, 0)));
+    tiles.push_back(new WalledTile(GolfEngine::Vector2(0, size)));
+    tiles.push_back(new GolfEngine::FullTile(GolfEngine::Vector2(size, size)));
+    for(GolfEngine::Tile* tile : tiles) map->addTile(tile);
+    GolfEngine::Golfball ball(GolfEngine::Vector2(20, 10));
+    tiles[0]->addEntity(&ball);
+
+    // Predicting leaves the map alone.
+    GolfEngine::TrajectoryPredictor predictor(map, dt_s);
+    const GolfEngine::Vector2 force(900, 3000);
+    std::uint64_t before = map->hashState();
+    const std::vector<GolfEngine::Vector2> path = predictor.predict(ball, force);
+    assert(map->hashState() == before);
+    assert(path.size() > 2 && path.size() <= GolfEngine::TrajectoryPredictor::DEFAULT_STEPS + 1);
+    assert(path.front() == ball.getPosition());
+
+    // Nudging the force within tolerance reuses the path, anything more predicts it again.
+    const std::vector<GolfEngine::Vector2>* cached = &predictor.predict(ball, force + GolfEngine::Vector2(0.5, 0.5));
+    assert(*cached == path);
+    assert(predictor.predict(ball, force + GolfEngine::Vector2(50, 0)) != path);
+
+    // The prediction matches what the map really does with the shot, including the bounce off of the wall.
+    ball.addAcceleration(force);
+    bool bounced = false;
+    for(std::size_t i = 1; i < path.size(); i++){
+        map->reorderEntities();
+        map->frameUpdate(dt_s);
+        assert(ball.getPosition() == path[i]);
+        bounced = bounced || ball.getVelocity().y < 0;
+    }
+    assert(bounced);
+
+    delete map;
+    for(GolfEngine::Tile* tile : tiles) delete tile;
+}
+
+void poolTests(){
+    GolfEngine::WorkStealingPool pool(4);
+    assert(pool.size() == 4);
+    // Uneven tasks, so idle workers have to steal to finish.
+    std::vector<unsigned long> sums(1000, 0);
+    for(std::size_t i = 0; i < sums.size(); i++){
+        pool.submit([i, &sums](unsigned int worker){
+            assert(worker < 4);
+            for(std::size_t j = 0; j <= (i % 7) * 1000; j++) sums[i] += j;
+        });
+    }
+    pool.wait();
+    for(std::size_t i = 0; i < sums.size(); i++){
+        std::size_t n = (i % 7) * 1000;
+        assert(sums[i] == (n * (n + 1)) / 2);
+    }
+
+    // A task's exception comes out of wait, once, and the pool keeps working after it.
+    pool.submit([](unsigned int){ throw std::runtime_error("Task failed."); });
+    bool thrown = false;
+    try{
+        pool.wait();
+    } catch(const std::runtime_error&){
+        thrown = true;
+    }
+    assert(thrown);
+    pool.wait();
+}
+
+GolfEngine::Level* makeLevelA(){
+    return new GolfEngine::LevelA();
+}
+
+/**
+ * LevelA, with a goal that creeps left a little every frame, so every frame a copy of it runs changes it.
+ */
+class DriftingLevel : public GolfEngine::LevelA {
+    public:
+        DriftingLevel() : GolfEngine::LevelA(), frames(0) {}
+
+        void frameUpdate(double dt_s) {
+            GolfEngine::LevelA::frameUpdate(dt_s);
+            this->frames++;
+            this->findEntitiesWithTag(GolfEngine::Tags::GOAL).front()->setPosition(GolfEngine::Vector2(96 - (this->frames * 0.05), 32));
+        }
+    private:
+        unsigned long frames;
+};
+
+GolfEngine::Level* makeDriftingLevel(){
+    return new DriftingLevel();
+}
+
+void solverTests(){
+    // Off to the side of the goal, so the straight shot along the first angle misses.
+    const GolfEngine::Vector2 start(20, 12);
+    GolfEngine::ShotSolver solver(&makeLevelA, 2);
+    solver.setCoarseGrid(16, 8);
+    GolfEngine::ShotSolution solution = solver.solve(start);
+    assert(solution.found);
+    assert(solution.force.magnitude() <= GolfEngine::Level::MAX_SWING_FORCE + 0.01);
+    assert(solution.simulations > 1);
+
+    // The shot really does reach the goal.
+    GolfEngine::LevelA level;
+    GolfEngine::Simulation simulation;
+    simulation.loadLevel(&level);
+    level.placeBall(start);
+    GolfEngine::ShotResult result = simulation.simulateShot(solution.force);
+    assert(result.reached_goal && result.frames == solution.frames);
+
+    // The answer doesn't depend on how many workers there are.
+    GolfEngine::ShotSolver serial(&makeLevelA, 1);
+    serial.setCoarseGrid(16, 8);
+    GolfEngine::ShotSolution serial_solution = serial.solve(start);
+    assert(serial_solution.found && serial_solution.force == solution.force);
+
+    // Nor on which shots a worker ran before, even when the level changes as it runs. Solve from several positions, in opposite orders, on different amounts of workers.
+    std::vector<GolfEngine::Vector2> starts;
+    starts.push_back(GolfEngine::Vector2(20, 12));
+    starts.push_back(GolfEngine::Vector2(110, 50));
+    starts.push_back(GolfEngine::Vector2(32, 32));
+    starts.push_back(GolfEngine::Vector2(60, 60));
+    GolfEngine::ShotSolver forwards(&makeDriftingLevel, 1);
+    GolfEngine::ShotSolver backwards(&makeDriftingLevel, 3);
+    forwards.setCoarseGrid(16, 8);
+    backwards.setCoarseGrid(16, 8);
+    std::vector<GolfEngine::ShotSolution> forward_solutions;
+    std::vector<GolfEngine::ShotSolution> backward_solutions(starts.size());
+    for(const GolfEngine::Vector2& position : starts){
+        forward_solutions.push_back(forwards.solve(position));
+    }
+    for(std::size_t i = starts.size(); i > 0; i--){
+        backward_solutions[i - 1] = backwards.solve(starts[i - 1]);
+    }
+    for(std::size_t i = 0; i < starts.size(); i++){
+        const GolfEngine::ShotSolution& lhs = forward_solutions[i];
+        const GolfEngine::ShotSolution& rhs = backward_solutions[i];
+        assert(lhs.found == rhs.found && lhs.force == rhs.force);
+        assert(lhs.frames == rhs.frames && lhs.closest == rhs.closest && lhs.passes == rhs.passes);
+    }
+}
+
+void difficultyTests(){
+    std::vector<GolfEngine::Vector2> tees;
+    tees.push_back(GolfEngine::Vector2(32, 32));
+    tees.push_back(GolfEngine::Vector2(20, 12));
+    tees.push_back(GolfEngine::Vector2(100, 10));
+
+    GolfEngine::DifficultyEstimator estimator(&makeLevelA, 3);
+    estimator.setShotsPerTee(100);
+    GolfEngine::DifficultyReport report = estimator.estimate(tees, 7);
+    assert(report.tees.size() == tees.size());
+    assert(report.simulations == 300);
+    // 128x128 map, 4x4 cells.
+    assert(report.rest_map.columns == 32 && report.rest_map.rows == 32);
+
+    unsigned long settled = 0;
+    unsigned long bucketed = 0;
+    for(const GolfEngine::TeeDifficulty& tee : report.tees){
+        assert(tee.shots == 100 && tee.holed + tee.settled <= tee.shots);
+        assert(tee.success_rate == tee.holed / 100.0);
+        settled += tee.settled;
+    }
+    for(unsigned long bucket : report.success_histogram){
+        bucketed += bucket;
+    }
+    assert(bucketed == tees.size());
+    unsigned long rested = 0;
+    for(unsigned long count : report.rest_map.counts){
+        rested += count;
+    }
+    assert(rested == settled);
+
+    // The report only depends on the seed.
+    GolfEngine::DifficultyEstimator serial(&makeLevelA, 1);
+    serial.setShotsPerTee(100);
+    GolfEngine::DifficultyReport serial_report = serial.estimate(tees, 7);
+    for(std::size_t i = 0; i < tees.size(); i++){
+        assert(serial_report.tees[i].holed == report.tees[i].holed);
+        assert(serial_report.tees[i].settled == report.tees[i].settled);
+    }
+    assert(serial_report.rest_map.counts == report.rest_map.counts);
+    // Nothing is left over from an earlier estimate.
+    GolfEngine::DifficultyReport repeated_report = estimator.estimate(tees, 7);
+    assert(repeated_report.rest_map.counts == report.rest_map.counts);
+
+    bool thrown = false;
+    try{
+        estimator.setCellSize(0);
+    } catch(const std::domain_error&){
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+/**
+ * A tile that counts how many of it are alive, to check that levels free what they make.
+ */
+class CountedTile : public GolfEngine::FullTile {
+    public:
+        static int alive;
+        CountedTile(const GolfEngine::Vector2& pos) : GolfEngine::FullTile(pos) { alive++; }
+        ~CountedTile() { alive--; }
+};
+int CountedTile::alive = 0;
+
+/**
+ * An entity that counts how many of it are alive.
+ */
+class CountedGoal : public GolfEngine::Goal {
+    public:
+        static int alive;
+        CountedGoal(const GolfEngine::Vector2& pos) : GolfEngine::Goal(pos) { alive++; }
+        ~CountedGoal() { alive--; }
+};
+int CountedGoal::alive = 0;
+
+/**
+ * LevelA, with a counted tile and a counted entity on the row below it.
+ */
+class CountedLevel : public GolfEngine::LevelA {
+    public:
+        void initialize() {
+            GolfEngine::LevelA::initialize();
+            this->addTile(new CountedTile(GolfEngine::Vector2(0, 64)));
+            this->addEntity(new CountedGoal(GolfEngine::Vector2(20, 100)));
+        }
+};
+
+GolfEngine::Level* makeCountedLevel(){
+    return new CountedLevel();
+}
+
+void worldOwnershipTests(){
+    {
+        GolfEngine::WorldBatch batch(&makeCountedLevel, 4, 2);
+        // One of each per world, and one for the prototype.
+        assert(CountedTile::alive == 5 && CountedGoal::alive == 5);
+        for(std::size_t i = 0; i < batch.size(); i++){
+            batch.shoot(i, GolfEngine::Vector2(0, 2000));
+        }
+        batch.settle();
+    }
+    // The batch deletes every level, and every level deletes its tiles and entities.
+    assert(CountedTile::alive == 0 && CountedGoal::alive == 0);
+
+    // Including entities the Tilemap has dropped for leaving the map.
+    {
+        CountedLevel level;
+        level.initialize();
+        GolfEngine::Entity* goal = level.findEntitiesWithTag(GolfEngine::Tags::GOAL).back();
+        goal->setRespawnPosition(GolfEngine::Vector2(-100, -100));
+        goal->setPosition(GolfEngine::Vector2(-100, -100));
+        level.getTilemap()->reorderEntities();
+        assert(goal->getEntityStore() == nullptr);
+    }
+    assert(CountedTile::alive == 0 && CountedGoal::alive == 0);
+}
+
+void worldBatchTests(){
+    const std::size_t count = 8;
+    GolfEngine::WorldBatch batch(&makeLevelA, count, 3);
+    assert(batch.size() == count);
+
+    // Every world reads the same walls and holes.
+    GolfEngine::Tile* first = batch.getLevel(0)->getTilemap()->getTiles().front();
+    for(std::size_t i = 0; i < count; i++){
+        for(GolfEngine::Tile* tile : batch.getLevel(i)->getTilemap()->getTiles()){
+            assert(tile->isSharingGeometry());
+        }
+        assert(batch.getLevel(i)->getTilemap()->getTiles().front()->getTileGeometry() == first->getTileGeometry());
+        assert(batch.getBallX()[i] == 32 && batch.getBallY()[i] == 32 && !batch.getMoving()[i]);
+    }
+
+    batch.step(10);
+    assert(batch.getFrameCount() == count * 10);
+
+    std::vector<GolfEngine::Vector2> forces;
+    for(std::size_t i = 0; i < count; i++){
+        double angle = 6.283185307179586 * i / count;
+        forces.push_back(GolfEngine::Vector2(std::cos(angle) * 300, std::sin(angle) * 300));
+        batch.shoot(i, forces[i]);
+        assert(batch.getMoving()[i]);
+    }
+    batch.settle();
+
+    // Each world ends up exactly where the same shot on its own would.
+    for(std::size_t i = 0; i < count; i++){
+        GolfEngine::LevelA level;
+        GolfEngine::Simulation simulation;
+        simulation.loadLevel(&level);
+        GolfEngine::ShotResult result = simulation.simulateShot(forces[i]);
+        GolfEngine::Entity* ball = level.findEntitiesWithTag(GolfEngine::Tags::GOLFBALL).front();
+        assert(batch.getHoled()[i] || !batch.getMoving()[i]);
+        assert((bool)batch.getHoled()[i] == result.reached_goal);
+        assert(batch.getBallX()[i] == ball->getPosition().x && batch.getBallY()[i] == ball->getPosition().y);
+    }
+}
+
+void vectorEnvironmentTests(){
+    const std::size_t count = 4;
+    const unsigned int obs_size = GolfEngine::VectorEnvironment::OBSERVATION_SIZE;
+    GolfEngine::VectorEnvironment environment(&makeLevelA, 2);
+    assert(environment.size() == 0);
+
+    std::vector<float> actions(count * GolfEngine::VectorEnvironment::ACTION_SIZE, 0);
+    std::vector<float> observations(count * obs_size, -1);
+    std::vector<float> rewards(count, 0);
+    std::vector<unsigned char> dones(count, 0);
+    bool thrown = false;
+    try{
+        environment.step(actions.data(), observations.data(), rewards.data(), dones.data());
+    } catch(const std::logic_error&){
+        thrown = true;
+    }
+    assert(thrown);
+
+    // LevelA is 128 units across, with the ball at (32, 32) and the goal at (96, 32).
+    environment.setMaxStrokes(2);
+    environment.reset(count, observations.data());
+    assert(environment.size() == count);
+    for(std::size_t i = 0; i < count; i++){
+        assert(observations[i * obs_size] == 0.25f && observations[(i * obs_size) + 1] == 0.25f);
+        assert(observations[(i * obs_size) + 2] == 0.75f && observations[(i * obs_size) + 3] == 0.25f);
+        assert(observations[(i * obs_size) + 4] == 0);
+    }
+
+    // World 0 drives straight at the goal. The rest barely tap the ball, or swing with nonsense.
+    actions[0] = 0.0625f;
+    actions[2] = 0.0001f;
+    actions[4] = std::nanf("");
+    actions[6] = 0;
+    actions[7] = -0.0001f;
+    // Winning and scoring are reported in the results, not printed.
+    std::ostringstream printed;
+    std::streambuf* standard_output = std::cout.rdbuf(printed.rdbuf());
+    environment.step(actions.data(), observations.data(), rewards.data(), dones.data());
+    std::cout.rdbuf(standard_output);
+    assert(printed.str().empty());
+    assert(rewards[0] == 1 && dones[0]);
+    assert(observations[0] == 0.25f && observations[4] == 0);
+    for(std::size_t i = 1; i < count; i++){
+        assert(rewards[i] < 0 && !dones[i]);
+        assert(observations[(i * obs_size) + 4] == 0.5f);
+    }
+
+    // Out of strokes.
+    environment.step(actions.data(), observations.data(), rewards.data(), dones.data());
+    for(std::size_t i = 1; i < count; i++){
+        assert(dones[i] && observations[(i * obs_size) + 4] == 0);
+    }
+}
+
+void vectorEnvironmentResetTests(){
+    const unsigned int obs_size = GolfEngine::VectorEnvironment::OBSERVATION_SIZE;
+    std::vector<float> observations(8 * obs_size, -1);
+    {
+        GolfEngine::VectorEnvironment environment(&makeCountedLevel, 2);
+        const std::size_t counts[] = {4, 8, 8, 4, 1, 8};
+        for(std::size_t count : counts){
+            environment.reset(count, observations.data());
+            assert(environment.size() == count);
+            // Each live world, plus the batch's prototype. Nothing from an earlier batch survives.
+            assert(CountedTile::alive == (int)count + 1 && CountedGoal::alive == (int)count + 1);
+        }
+    }
+    assert(CountedTile::alive == 0 && CountedGoal::alive == 0);
+}
+
+/**
+ * Run a crowded 8x8 map, recording the state hash, every collision and every stopped golfball (as ball indices) each frame.
+ */
+void recordTileUpdates(unsigned int worker_count, std::vector<std::uint64_t>& hashes, std::vector<std::size_t>& collisions, std::vector<std::size_t>& stopped){
+    const double size = GolfEngine::TileGeometry::TILE_SIZE;
+    GolfEngine::Tilemap* map = new GolfEngine::Tilemap(8);
+    map->setWorkerCount(worker_count);
+    std::vector<GolfEngine::Tile*> tiles;
+    for(unsigned int i = 0; i < 64; i++){
+        tiles.push_back(new GolfEngine::FullTile(GolfEngine::Vector2((i % 8) * size, (i / 8) * size)));
+        map->addTile(tiles.back());
+    }
+    std::vector<GolfEngine::Golfball*> balls;
+    std::unordered_map<GolfEngine::Entity*, std::size_t> index;
+    for(unsigned int i = 0; i < 600; i++){
+        GolfEngine::Vector2 position(std::fmod(i * 37.3, 8 * size), std::fmod(i * 91.7, 8 * size));
+        int tile_index = map->getTileIndex(position);
+        assert(tile_index >= 0);
+        balls.push_back(new GolfEngine::Golfball(position));
+        balls.back()->setVelocity(GolfEngine::Vector2(std::fmod(i * 13.1, 200) - 100, std::fmod(i * 29.9, 200) - 100));
+        tiles[tile_index]->addEntity(balls.back());
+        index[balls.back()] = i;
+    }
+    for(unsigned int frame = 0; frame < 90; frame++){
+        // Every so often, swing some of the balls. They stop again on the next update.
+        if(frame % 30 == 0){
+            for(std::size_t i = frame / 30; i < balls.size(); i += 3){
+                balls[i]->setState(GolfEngine::GolfballStates::MOVING);
+            }
+        }
+        map->reorderEntities();
+        GolfEngine::CollisionSpan span = map->frameUpdate(1.0 / 60.0);
+        hashes.push_back(map->hashState());
+        for(GolfEngine::Collision& collision : span){
+            collisions.push_back(index[collision.getAttached()]);
+            collisions.push_back(index[collision.getCollider()]);
+        }
+        for(GolfEngine::Entity* ball : map->getStoppedGolfballs()){
+            stopped.push_back(index[ball]);
+        }
+    }
+    delete map;
+    for(GolfEngine::Golfball* ball : balls) delete ball;
+    for(GolfEngine::Tile* tile : tiles) delete tile;
+}
+
+void cInterfaceTests(){
+    // NULL environments and buffers fail with a message, rather than crashing.
+    const std::size_t count = 3;
+    std::vector<float> actions(count * GOLFENGINE_ACTION_SIZE, 0);
+    std::vector<float> observations(count * GOLFENGINE_OBSERVATION_SIZE, -1);
+    std::vector<float> rewards(count, 0);
+    std::vector<unsigned char> dones(count, 0);
+    assert(golfengine_env_reset(NULL, count, observations.data()) == -1);
+    assert(std::string(golfengine_last_error()) == "Environment is NULL.");
+    assert(golfengine_env_step(NULL, actions.data(), observations.data(), rewards.data(), dones.data()) == -1);
+    assert(golfengine_env_size(NULL) == (size_t)-1);
+    assert(golfengine_env_set_max_strokes(NULL, 2) == -1);
+    golfengine_env_destroy(NULL);
+
+    golfengine_env* env = golfengine_env_create(2);
+    assert(env != NULL);
+    assert(golfengine_env_size(env) == 0);
+    assert(golfengine_env_reset(env, count, NULL) == -1);
+    assert(std::string(golfengine_last_error()) == "Observation buffer is NULL.");
+    assert(golfengine_env_set_max_strokes(env, 2) == 0);
+    assert(golfengine_env_reset(env, count, observations.data()) == 0);
+    assert(golfengine_env_size(env) == count);
+    assert(observations[0] == 0.25f && observations[2] == 0.75f);
+
+    assert(golfengine_env_step(env, actions.data(), observations.data(), NULL, dones.data()) == -1);
+    assert(std::string(golfengine_last_error()) == "Reward buffer is NULL.");
+    // World 0 drives straight at the goal, the rest don't swing at all.
+    actions[0] = 0.0625f;
+    assert(golfengine_env_step(env, actions.data(), observations.data(), rewards.data(), dones.data()) == 0);
+    assert(rewards[0] == 1 && dones[0]);
+    for(std::size_t i = 1; i < count; i++){
+        assert(rewards[i] < 0 && !dones[i]);
+    }
+    golfengine_env_destroy(env);
+}
+
+void parallelTileTests(){
+    std::vector<std::uint64_t> serial_hashes;
+    std::vector<std::size_t> serial_collisions;
+    std::vector<std::size_t> serial_stopped;
+    recordTileUpdates(1, serial_hashes, serial_collisions, serial_stopped);
+    assert(!serial_collisions.empty());
+    assert(serial_stopped.size() == 600);
+
+    // Same state, same slot order, and the same collisions and stopped balls in the same order, whatever the amount of workers.
+    const unsigned int worker_counts[] = {2, 3, 8};
+    for(unsigned int worker_count : worker_counts){
+        std::vector<std::uint64_t> hashes;
+        std::vector<std::size_t> collisions;
+        std::vector<std::size_t> stopped;
+        recordTileUpdates(worker_count, hashes, collisions, stopped);
+        assert(hashes == serial_hashes);
+        assert(collisions == serial_collisions);
+        assert(stopped == serial_stopped);
+    }
+
+    GolfEngine::Tilemap map(2);
+    assert(map.getWorkerCount() == 1);
+    map.setWorkerCount(4);
+    assert(map.getWorkerCount() == 4);
+    map.setWorkerCount(0);
+    assert(map.getWorkerCount() == 1);
+}
+
 void runTest(const char* test_name, Test test){
     std::cout << "▶️  Running " << test_name << "..." << std::endl;
     test();
@@ -61,6 +1504,31 @@ void runTest(const char* test_name, Test test){
 void runTests(){
     runTest("Vector2 Tests", vectorTests);
     runTest("Quad Tests", quadTests);
+    runTest("Polygon Tests", polygonTests);
+    runTest("Integration Kernel Tests", integrationTests);
+    runTest("Broadphase Tests", broadphaseTests);
+    runTest("Tilemap Tests", tilemapTests);
+    runTest("Tag Tests", tagTests);
+    runTest("Frame Arena Tests", arenaTests);
+    runTest("Continuous Collision Tests", sweepTests);
+    runTest("Wall Grid Tests", wallGridTests);
+    runTest("Sweep Kernel Tests", sweepKernelTests);
+    runTest("Corner Wall Tests", cornerWallTests);
+    runTest("Hole Mask Tests", holeMaskTests);
+    runTest("Polygon Kernel Tests", polygonKernelTests);
+    runTest("Narrowphase Tests", narrowphaseTests);
+    runTest("Collision Dispatch Tests", dispatchTests);
+    runTest("Determinism Tests", determinismTests);
+    runTest("Trajectory Tests", trajectoryTests);
+    runTest("Work Stealing Pool Tests", poolTests);
+    runTest("Shot Solver Tests", solverTests);
+    runTest("Difficulty Estimator Tests", difficultyTests);
+    runTest("World Batch Tests", worldBatchTests);
+    runTest("World Ownership Tests", worldOwnershipTests);
+    runTest("Vector Environment Tests", vectorEnvironmentTests);
+    runTest("Vector Environment Reset Tests", vectorEnvironmentResetTests);
+    runTest("C Interface Tests", cInterfaceTests);
+    runTest("Parallel Tile Tests", parallelTileTests);
 }
 
 #undef IS_APPROXIMATELY
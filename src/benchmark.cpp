@@ -0,0 +1,420 @@
+/**
+ * @file benchmark.cpp
+ * @brief This file is responsible for benchmarking the broadphase strategies and the narrowphase dispatch.
+ *
+ * Every strategy is run over the same, slowly drifting, field of circles at a constant density,
+ * and the average time per frame is written to standard output as a table.
+ *
+ * The narrowphase is then run over a mixed field of circles and boxes, once picking the test for
+ * each pair by branching on entity flags and casting (as the Tilemap used to), and once through
+ * \ref GolfEngine::CollisionDispatch.
+ *
+ * Finally, shots on LevelA are predicted with a \ref GolfEngine::TrajectoryPredictor, with a
+ * new force every time so nothing is reused, to check that an aim preview fits in a frame.
+ *
+ * Last, batches of LevelA worlds are shot and stepped together by a \ref GolfEngine::WorldBatch,
+ * to measure how many physics steps per second a single machine can simulate.
+ *
+ * And a crowded course is stepped with its tiles updated on more and more worker threads.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-26
+ */
+
+#include "GolfEngine/Physics/Broadphase.hpp"
+#include "GolfEngine/Physics/Narrowphase.hpp"
+#include "GolfEngine/GameManagement/CollisionDispatch.hpp"
+#include "GolfEngine/GameManagement/Entities/Golfball.hpp"
+#include "GolfEngine/GameManagement/Entities/PolygonEntity.hpp"
+#include "GolfEngine/Geometry/Shapes/Quadrilateral.hpp"
+#include "GolfEngine/GameManagement/TrajectoryPredictor.hpp"
+#include "GolfEngine/GameManagement/Levels/LevelA.hpp"
+#include "GolfEngine/Simulation/FixedTimestep.hpp"
+#include "GolfEngine/Simulation/WorldBatch.hpp"
+#include "GolfEngine/GameManagement/Tilemap.hpp"
+#include "GolfEngine/GameManagement/Tiles/FullTile.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+static const double RADIUS = 4;
+static const unsigned int FRAMES = 30;
+
+/**
+ * @brief Time a broadphase over a drifting field of circles.
+ *
+ * @param strategy Strategy to time.
+ * @param count Amount of circles.
+ * @param pair_count Set to the amount of pairs found on the last frame.
+ * @returns Average microseconds per frame.
+ */
+static double timeStrategy(GolfEngine::BroadphaseStrategy strategy, unsigned int count, std::size_t &pair_count)
+{
+    // Keep about one circle per 24x24 pixels, no matter the count.
+    double side = std::sqrt((double)count) * 24;
+    std::srand(count);
+    std::vector<double> x(count), y(count), vx(count), vy(count);
+    for (unsigned int i = 0; i < count; i++)
+    {
+        x[i] = side * std::rand() / RAND_MAX;
+        y[i] = side * std::rand() / RAND_MAX;
+        vx[i] = (2.0 * std::rand() / RAND_MAX) - 1;
+        vy[i] = (2.0 * std::rand() / RAND_MAX) - 1;
+    }
+
+    GolfEngine::Broadphase *broadphase = GolfEngine::Broadphase::create(strategy);
+    GolfEngine::AABB::AABBList bounds(count);
+    GolfEngine::CandidatePair::CandidatePairList pairs;
+    std::chrono::steady_clock::duration total = std::chrono::steady_clock::duration::zero();
+    for (unsigned int frame = 0; frame < FRAMES; frame++)
+    {
+        for (unsigned int i = 0; i < count; i++)
+        {
+            x[i] += vx[i];
+            y[i] += vy[i];
+            bounds[i] = GolfEngine::AABB(x[i] - RADIUS, y[i] - RADIUS, x[i] + RADIUS, y[i] + RADIUS);
+        }
+        pairs.clear();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        broadphase->findPairs(bounds, pairs);
+        total += std::chrono::steady_clock::now() - start;
+    }
+    delete broadphase;
+    pair_count = pairs.size();
+    return std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(total).count() / FRAMES;
+}
+
+/**
+ * @brief Find the contact between two entities by branching on their flags, the way the Tilemap did before dispatching on shape kind.
+ */
+static bool legacyContact(GolfEngine::Entity *a, GolfEngine::Entity *b, GolfEngine::SeparatingAxisCache &cache, GolfEngine::Contact &contact)
+{
+    const unsigned int polygon = GolfEngine::EntityStore::FLAG_POLYGON;
+    if (!a->hasFlag(polygon) && !b->hasFlag(polygon))
+    {
+        return GolfEngine::Narrowphase::circleCircle(a->getPosition(), a->getRadius(), b->getPosition(), b->getRadius(), contact);
+    }
+    if (a->hasFlag(polygon) && b->hasFlag(polygon))
+    {
+        bool swapped = b < a;
+        GolfEngine::Entity *first = swapped ? b : a;
+        GolfEngine::Entity *second = swapped ? a : b;
+        GolfEngine::Polygon *shape_first = ((GolfEngine::PolygonEntity *)first)->getShape();
+        GolfEngine::Polygon *shape_second = ((GolfEngine::PolygonEntity *)second)->getShape();
+        shape_first->setOrigin(first->getPosition());
+        const std::vector<GolfEngine::Vector2> &vertices_first = shape_first->getWorldVertices();
+        shape_second->setOrigin(second->getPosition());
+        const std::vector<GolfEngine::Vector2> &vertices_second = shape_second->getWorldVertices();
+        if (!GolfEngine::Narrowphase::polygonPolygon(vertices_first.data(), vertices_first.size(), vertices_second.data(), vertices_second.size(), contact, cache.get(first, second)))
+        {
+            return false;
+        }
+        if (swapped)
+        {
+            contact.normal = contact.normal * -1;
+        }
+        return true;
+    }
+    bool swapped = b->hasFlag(polygon);
+    GolfEngine::Entity *shape_entity = swapped ? b : a;
+    GolfEngine::Entity *circle_entity = swapped ? a : b;
+    GolfEngine::Polygon *shape = ((GolfEngine::PolygonEntity *)shape_entity)->getShape();
+    shape->setOrigin(shape_entity->getPosition());
+    const std::vector<GolfEngine::Vector2> &vertices = shape->getWorldVertices();
+    if (!GolfEngine::Narrowphase::polygonCircle(vertices.data(), vertices.size(), circle_entity->getPosition(), circle_entity->getRadius(), contact))
+    {
+        return false;
+    }
+    if (swapped)
+    {
+        contact.normal = contact.normal * -1;
+    }
+    return true;
+}
+
+/**
+ * @brief Time both ways of picking narrowphase tests over a field of circles and boxes.
+ *
+ * @param count Amount of bodies. Every other one is a box.
+ * @param pair_count Set to the amount of candidate pairs.
+ * @param hit_count Set to the amount of pairs that touch.
+ * @param legacy_time Set to the average microseconds per frame when branching on flags.
+ * @param dispatch_time Set to the average microseconds per frame through the dispatch table.
+ * @returns False if the two found a different amount of contacts, true otherwise.
+ */
+static bool timeNarrowphase(unsigned int count, std::size_t &pair_count, std::size_t &hit_count, double &legacy_time, double &dispatch_time)
+{
+    double side = std::sqrt((double)count) * 16;
+    std::srand(count);
+    const GolfEngine::Vector2 corners[] = {GolfEngine::Vector2(-4, -4), GolfEngine::Vector2(4, -4), GolfEngine::Vector2(4, 4), GolfEngine::Vector2(-4, 4)};
+    std::vector<GolfEngine::Quadrilateral *> shapes;
+    std::vector<GolfEngine::Entity *> entities;
+    GolfEngine::AABB::AABBList bounds;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        GolfEngine::Vector2 pos(side * std::rand() / RAND_MAX, side * std::rand() / RAND_MAX);
+        if (i % 2)
+        {
+            GolfEngine::Quadrilateral *shape = new GolfEngine::Quadrilateral(corners[0], corners[1], corners[2], corners[3]);
+            shapes.push_back(shape);
+            entities.push_back(new GolfEngine::PolygonEntity(shape, pos));
+        }
+        else
+        {
+            entities.push_back(new GolfEngine::Golfball(pos));
+        }
+        double r = entities.back()->getRadius();
+        bounds.push_back(GolfEngine::AABB(pos.x - r, pos.y - r, pos.x + r, pos.y + r));
+    }
+    GolfEngine::Broadphase *broadphase = GolfEngine::Broadphase::create(GolfEngine::BroadphaseStrategy::UNIFORM_GRID);
+    GolfEngine::CandidatePair::CandidatePairList pairs;
+    broadphase->findPairs(bounds, pairs);
+    delete broadphase;
+    pair_count = pairs.size();
+
+    GolfEngine::SeparatingAxisCache legacy_cache, dispatch_cache;
+    std::vector<GolfEngine::ContactBody> bodies(count);
+    GolfEngine::Contact contact;
+    std::size_t legacy_hits = 0, dispatch_hits = 0;
+    std::chrono::steady_clock::duration legacy_total = std::chrono::steady_clock::duration::zero();
+    std::chrono::steady_clock::duration dispatch_total = std::chrono::steady_clock::duration::zero();
+    for (unsigned int frame = 0; frame < FRAMES; frame++)
+    {
+        legacy_hits = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (const GolfEngine::CandidatePair &pair : pairs)
+        {
+            legacy_hits += legacyContact(entities[pair.a], entities[pair.b], legacy_cache, contact);
+        }
+        legacy_cache.prune();
+        legacy_total += std::chrono::steady_clock::now() - start;
+
+        // Gathering the bodies is part of the cost of dispatching, so it is timed too.
+        dispatch_hits = 0;
+        start = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i < count; i++)
+        {
+            GolfEngine::ContactBody &body = bodies[i];
+            body.owner = entities[i];
+            body.position = entities[i]->getPosition();
+            body.radius = entities[i]->getRadius();
+            if (i % 2)
+            {
+                GolfEngine::Polygon *shape = ((GolfEngine::PolygonEntity *)entities[i])->getShape();
+                shape->setOrigin(body.position);
+                const std::vector<GolfEngine::Vector2> &vertices = shape->getWorldVertices();
+                body.kind = GolfEngine::ShapeKind::POLYGON_SHAPE;
+                body.vertices = vertices.data();
+                body.vertex_count = vertices.size();
+            }
+        }
+        for (const GolfEngine::CandidatePair &pair : pairs)
+        {
+            dispatch_hits += GolfEngine::CollisionDispatch::findContact(bodies[pair.a], bodies[pair.b], dispatch_cache, contact);
+        }
+        dispatch_cache.prune();
+        dispatch_total += std::chrono::steady_clock::now() - start;
+    }
+
+    for (GolfEngine::Entity *entity : entities)
+    {
+        delete entity;
+    }
+    for (GolfEngine::Quadrilateral *shape : shapes)
+    {
+        delete shape;
+    }
+    hit_count = dispatch_hits;
+    legacy_time = std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(legacy_total).count() / FRAMES;
+    dispatch_time = std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(dispatch_total).count() / FRAMES;
+    return legacy_hits == dispatch_hits;
+}
+
+/**
+ * @brief Time trajectory predictions for the ball on LevelA.
+ *
+ * @param predictions Amount of predictions to make.
+ * @param step_count Set to the average amount of steps predicted.
+ * @returns Average microseconds per prediction.
+ */
+static double timePrediction(unsigned int predictions, double &step_count)
+{
+    GolfEngine::LevelA level;
+    level.initialize();
+    GolfEngine::Entity *ball = level.findEntitiesWithTag(GolfEngine::Tags::GOLFBALL).front();
+    GolfEngine::TrajectoryPredictor predictor(level.getTilemap(), GolfEngine::FixedTimestep().getStepSeconds());
+    predictor.setTolerance(0);
+    std::size_t steps = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < predictions; i++)
+    {
+        // Sweep the aim around in a circle, at a power that keeps the ball on the map for the whole prediction.
+        double angle = 6.283185307179586 * i / predictions;
+        GolfEngine::Vector2 force(std::cos(angle) * 200, std::sin(angle) * 200);
+        steps += predictor.predict(*ball, force).size() - 1;
+    }
+    std::chrono::steady_clock::duration total = std::chrono::steady_clock::now() - start;
+    step_count = (double)steps / predictions;
+    return std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(total).count() / predictions;
+}
+
+static GolfEngine::Level *makeLevelA()
+{
+    return new GolfEngine::LevelA();
+}
+
+/**
+ * @brief Time stepping a batch of LevelA worlds, each with its ball shot in a different direction.
+ *
+ * @param world_count Amount of worlds.
+ * @param ticks Amount of steps to advance every world by.
+ * @returns Physics steps per second, summed over every world.
+ */
+static double timeBatch(std::size_t world_count, unsigned long ticks)
+{
+    GolfEngine::WorldBatch batch(&makeLevelA, world_count);
+    for (std::size_t i = 0; i < world_count; i++)
+    {
+        double angle = 6.283185307179586 * i / world_count;
+        batch.shoot(i, GolfEngine::Vector2(std::cos(angle) * 200, std::sin(angle) * 200));
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    batch.step(ticks);
+    std::chrono::steady_clock::duration total = std::chrono::steady_clock::now() - start;
+    return batch.getFrameCount() / std::chrono::duration_cast<std::chrono::duration<double>>(total).count();
+}
+
+/**
+ * @brief Time whole Tilemap updates on a 32x32 tile course, crowded with moving balls.
+ *
+ * @param worker_count Amount of threads tiles are updated on.
+ * @param count Amount of balls.
+ * @returns Average microseconds per frame.
+ */
+static double timeTileUpdate(unsigned int worker_count, unsigned int count)
+{
+    const double size = GolfEngine::TileGeometry::TILE_SIZE;
+    GolfEngine::Tilemap *map = new GolfEngine::Tilemap(32);
+    map->setWorkerCount(worker_count);
+    std::vector<GolfEngine::Tile *> tiles;
+    for (unsigned int i = 0; i < 32 * 32; i++)
+    {
+        tiles.push_back(new GolfEngine::FullTile(GolfEngine::Vector2((i % 32) * size, (i / 32) * size)));
+        map->addTile(tiles.back());
+    }
+    std::srand(count);
+    std::vector<GolfEngine::Golfball *> balls;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        GolfEngine::Vector2 position(32 * size * std::rand() / ((double)RAND_MAX + 1), 32 * size * std::rand() / ((double)RAND_MAX + 1));
+        balls.push_back(new GolfEngine::Golfball(position));
+        balls.back()->setVelocity(GolfEngine::Vector2((200.0 * std::rand() / RAND_MAX) - 100, (200.0 * std::rand() / RAND_MAX) - 100));
+        int tile_index = map->getTileIndex(position);
+        if (tile_index >= 0)
+        {
+            tiles[tile_index]->addEntity(balls.back());
+        }
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned int frame = 0; frame < FRAMES; frame++)
+    {
+        map->reorderEntities();
+        map->frameUpdate(1.0 / 60.0);
+    }
+    std::chrono::steady_clock::duration total = std::chrono::steady_clock::now() - start;
+    delete map;
+    for (GolfEngine::Golfball *ball : balls)
+    {
+        delete ball;
+    }
+    for (GolfEngine::Tile *tile : tiles)
+    {
+        delete tile;
+    }
+    return std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(total).count() / FRAMES;
+}
+
+int main()
+{
+    const GolfEngine::BroadphaseStrategy strategies[] = {
+        GolfEngine::BroadphaseStrategy::BRUTE_FORCE,
+        GolfEngine::BroadphaseStrategy::UNIFORM_GRID,
+        GolfEngine::BroadphaseStrategy::SWEEP_AND_PRUNE};
+
+    std::cout << "Average microseconds per frame, over " << FRAMES << " frames." << std::endl;
+    std::cout << std::setw(8) << "bodies" << std::setw(8) << "pairs" << std::setw(14) << "brute force" << std::setw(14) << "grid" << std::setw(14) << "sweep" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    for (unsigned int count = 64; count <= 16384; count *= 2)
+    {
+        std::size_t expected_pairs = 0;
+        std::cout << std::setw(8) << count;
+        std::vector<double> times;
+        for (GolfEngine::BroadphaseStrategy strategy : strategies)
+        {
+            std::size_t pair_count;
+            times.push_back(timeStrategy(strategy, count, pair_count));
+            if (strategy == GolfEngine::BroadphaseStrategy::BRUTE_FORCE)
+            {
+                expected_pairs = pair_count;
+            }
+            else if (pair_count != expected_pairs)
+            {
+                std::cerr << "Strategy " << strategy << " found " << pair_count << " pairs, expected " << expected_pairs << "." << std::endl;
+                return 1;
+            }
+        }
+        std::cout << std::setw(8) << expected_pairs;
+        for (double time : times)
+        {
+            std::cout << std::setw(14) << time;
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << std::endl;
+    std::cout << "Narrowphase, average microseconds per frame, over " << FRAMES << " frames." << std::endl;
+    std::cout << std::setw(8) << "bodies" << std::setw(8) << "pairs" << std::setw(8) << "hits" << std::setw(14) << "flags" << std::setw(14) << "dispatch" << std::endl;
+    for (unsigned int count = 64; count <= 16384; count *= 2)
+    {
+        std::size_t pair_count, hit_count;
+        double legacy_time, dispatch_time;
+        if (!timeNarrowphase(count, pair_count, hit_count, legacy_time, dispatch_time))
+        {
+            std::cerr << "Dispatch and flag branching found a different amount of contacts for " << count << " bodies." << std::endl;
+            return 1;
+        }
+        std::cout << std::setw(8) << count << std::setw(8) << pair_count << std::setw(8) << hit_count << std::setw(14) << legacy_time << std::setw(14) << dispatch_time << std::endl;
+    }
+
+    std::cout << std::endl;
+    double step_count;
+    double prediction_time = timePrediction(256, step_count);
+    std::cout << "Trajectory prediction, average over 256 shots: " << step_count << " steps in " << prediction_time << " microseconds." << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "Batched worlds, physics steps per second over 200 steps." << std::endl;
+    std::cout << std::setw(8) << "worlds" << std::setw(14) << "steps/s" << std::endl;
+    for (std::size_t count = 64; count <= 4096; count *= 4)
+    {
+        // Timed before printing, as sinking a ball writes to standard output too.
+        double rate = timeBatch(count, 200);
+        std::cout << std::setw(8) << count << std::setw(14) << rate << std::endl;
+    }
+
+    std::cout << std::endl;
+    std::cout << "Tilemap updates on a 32x32 tile course, average microseconds per frame, over " << FRAMES << " frames." << std::endl;
+    std::cout << std::setw(8) << "balls" << std::setw(14) << "1 thread" << std::setw(14) << "2 threads" << std::setw(14) << "4 threads" << std::setw(14) << "8 threads" << std::endl;
+    for (unsigned int count = 4096; count <= 65536; count *= 4)
+    {
+        std::cout << std::setw(8) << count;
+        for (unsigned int worker_count = 1; worker_count <= 8; worker_count *= 2)
+        {
+            std::cout << std::setw(14) << timeTileUpdate(worker_count, count);
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
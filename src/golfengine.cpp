@@ -0,0 +1,146 @@
+/**
+ * @file golfengine.cpp
+ * @brief This file contains definitions for the C interface to libgolfengine.
+ *
+ * Exceptions can't cross into C, so every call catches them and records their message instead.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#include "golfengine.h"
+#include "GolfEngine/Simulation/VectorEnvironment.hpp"
+#include "GolfEngine/GameManagement/Levels/LevelA.hpp"
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+static_assert(GOLFENGINE_OBSERVATION_SIZE == GolfEngine::VectorEnvironment::OBSERVATION_SIZE, "Observation size differs between C and C++.");
+static_assert(GOLFENGINE_ACTION_SIZE == GolfEngine::VectorEnvironment::ACTION_SIZE, "Action size differs between C and C++.");
+
+struct golfengine_env
+{
+    GolfEngine::VectorEnvironment *environment;
+};
+
+static thread_local std::string last_error;
+
+static GolfEngine::Level *makeLevel()
+{
+    return new GolfEngine::LevelA();
+}
+
+/**
+ * @brief Run a call, turning any exception into a -1 and a recorded message.
+ */
+template <typename Function>
+static int guard(Function fn)
+{
+    try
+    {
+        fn();
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        last_error = e.what();
+    }
+    catch (...)
+    {
+        last_error = "Unknown error.";
+    }
+    return -1;
+}
+
+golfengine_env *golfengine_env_create(unsigned int worker_count)
+{
+    golfengine_env *env = nullptr;
+    guard([&env, worker_count]()
+          {
+        env = new golfengine_env();
+        env->environment = nullptr;
+        env->environment = new GolfEngine::VectorEnvironment(&makeLevel, worker_count); });
+    if (env != nullptr && env->environment == nullptr)
+    {
+        delete env;
+        env = nullptr;
+    }
+    return env;
+}
+
+void golfengine_env_destroy(golfengine_env *env)
+{
+    if (env == nullptr)
+    {
+        return;
+    }
+    delete env->environment;
+    delete env;
+}
+
+/**
+ * @brief Throw if an environment handle is NULL.
+ */
+static void requireEnvironment(const golfengine_env *env)
+{
+    if (env == nullptr || env->environment == nullptr)
+    {
+        throw std::invalid_argument("Environment is NULL.");
+    }
+}
+
+/**
+ * @brief Throw if a buffer is NULL while it has elements to hold.
+ */
+static void requireBuffer(const void *buffer, size_t count, const char *message)
+{
+    if (buffer == nullptr && count > 0)
+    {
+        throw std::invalid_argument(message);
+    }
+}
+
+int golfengine_env_reset(golfengine_env *env, size_t count, float *observations)
+{
+    return guard([env, count, observations]()
+                 {
+        requireEnvironment(env);
+        requireBuffer(observations, count, "Observation buffer is NULL.");
+        env->environment->reset(count, observations); });
+}
+
+int golfengine_env_step(golfengine_env *env, const float *actions, float *observations, float *rewards, unsigned char *dones)
+{
+    return guard([env, actions, observations, rewards, dones]()
+                 {
+        requireEnvironment(env);
+        size_t count = env->environment->size();
+        requireBuffer(actions, count, "Action buffer is NULL.");
+        requireBuffer(observations, count, "Observation buffer is NULL.");
+        requireBuffer(rewards, count, "Reward buffer is NULL.");
+        requireBuffer(dones, count, "Done buffer is NULL.");
+        env->environment->step(actions, observations, rewards, dones); });
+}
+
+size_t golfengine_env_size(const golfengine_env *env)
+{
+    size_t size = (size_t)-1;
+    guard([env, &size]()
+          {
+        requireEnvironment(env);
+        size = env->environment->size(); });
+    return size;
+}
+
+int golfengine_env_set_max_strokes(golfengine_env *env, unsigned long strokes)
+{
+    return guard([env, strokes]()
+                 {
+        requireEnvironment(env);
+        env->environment->setMaxStrokes(strokes); });
+}
+
+const char *golfengine_last_error(void)
+{
+    return last_error.c_str();
+}
@@ -0,0 +1,96 @@
+/**
+ * @file golfengine.h
+ * @brief This file contains the C interface to libgolfengine.
+ *
+ * libgolfengine exposes the engine as a vectorized environment, for training shot selection agents
+ * from any language that can call C (e.g. through Python's ctypes). It is built with `make lib`.
+ *
+ * Every buffer is owned by the caller, and is read from or written into directly. Functions that can
+ * fail return 0 on success and -1 on failure, after which \ref golfengine_last_error describes what
+ * went wrong. Passing a NULL environment, or a NULL buffer that has elements to hold, is a failure.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-29
+ */
+
+#ifndef GOLFENGINE_C_H
+#define GOLFENGINE_C_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Floats per observation: ball x, ball y, goal x, goal y, each over the map's side length, then the fraction of strokes used.
+ */
+#define GOLFENGINE_OBSERVATION_SIZE 5
+
+/**
+ * @brief Floats per action: swing force x and y, as fractions of the maximum swing force.
+ */
+#define GOLFENGINE_ACTION_SIZE 2
+
+    /**
+     * @brief A vectorized environment over many copies of a level.
+     */
+    typedef struct golfengine_env golfengine_env;
+
+    /**
+     * @brief Make an environment. It has no worlds until it is reset.
+     *
+     * @param worker_count Amount of worker threads. 0 uses one per hardware thread.
+     * @returns The environment, or NULL on failure.
+     */
+    golfengine_env *golfengine_env_create(unsigned int worker_count);
+
+    /**
+     * @brief Destroy an environment. Does nothing if env is NULL.
+     */
+    void golfengine_env_destroy(golfengine_env *env);
+
+    /**
+     * @brief Start a new episode in count worlds. The worlds are only rebuilt if count changes.
+     *
+     * @param observations Must hold count * GOLFENGINE_OBSERVATION_SIZE floats.
+     */
+    int golfengine_env_reset(golfengine_env *env, size_t count, float *observations);
+
+    /**
+     * @brief Take a stroke in every world, simulating each until its ball is at rest or in the goal.
+     *
+     * Worlds whose episode ends are reset, and their next episode's first observation is written.
+     *
+     * @param actions Must hold size * GOLFENGINE_ACTION_SIZE floats.
+     * @param observations Must hold size * GOLFENGINE_OBSERVATION_SIZE floats.
+     * @param rewards Must hold size floats. 1 for reaching the goal, otherwise minus the distance to the goal over the map's side length.
+     * @param dones Must hold size bytes. 1 for every world whose episode ended, 0 otherwise.
+     */
+    int golfengine_env_step(golfengine_env *env, const float *actions, float *observations, float *rewards, unsigned char *dones);
+
+    /**
+     * @brief Get the amount of worlds, as of the last reset.
+     *
+     * @returns The amount of worlds, or (size_t)-1 if env is NULL.
+     */
+    size_t golfengine_env_size(const golfengine_env *env);
+
+    /**
+     * @brief Set the amount of strokes before an episode is cut off. Defaults to 10.
+     */
+    int golfengine_env_set_max_strokes(golfengine_env *env, unsigned long strokes);
+
+    /**
+     * @brief Describe the last failure on the calling thread.
+     *
+     * @returns The description, or an empty string if nothing has failed.
+     */
+    const char *golfengine_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,90 @@
+/**
+ * @file headless.cpp
+ * @brief This file is responsible for running shots without a display.
+ *
+ * Shots are read from standard input as whitespace separated "force_x force_y" pairs, and
+ * the outcome of each shot is written to standard output as "frames reached_goal x y".
+ *
+ * Run with "solve" as the only argument to search for shots instead. Ball positions are read
+ * from standard input as "x y" pairs, and the best shot from each is written to standard output
+ * as "found force_x force_y frames simulations".
+ *
+ * Run with "difficulty" as the first argument, optionally followed by a shot count, to estimate
+ * how hard the level is instead. Tee positions are read from standard input as "x y" pairs. Each
+ * tee is written to standard output as "x y holed settled success_rate", followed by the mean
+ * success rate and the success rate histogram on one line, then "columns rows" and the rows of
+ * the heat map of where missed shots came to rest.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-22
+ */
+
+#include "GolfEngine/Simulation/Simulation.hpp"
+#include "GolfEngine/Simulation/ShotSolver.hpp"
+#include "GolfEngine/Simulation/DifficultyEstimator.hpp"
+#include "GolfEngine/GameManagement/Levels/LevelA.hpp"
+#include "GolfEngine/GameManagement/Entities/Entity.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+static GolfEngine::Level *makeLevel(){
+    return new GolfEngine::LevelA();
+}
+
+int main(int argc, char** argv){
+    if(argc == 2 && std::string(argv[1]) == "solve"){
+        GolfEngine::ShotSolver solver(&makeLevel);
+        double x, y;
+        while(std::cin >> x >> y){
+            GolfEngine::ShotSolution solution = solver.solve(GolfEngine::Vector2(x, y));
+            std::cout << solution.found << " " << solution.force.x << " " << solution.force.y << " " << solution.frames << " " << solution.simulations << std::endl;
+        }
+        return 0;
+    }
+    if((argc == 2 || argc == 3) && std::string(argv[1]) == "difficulty"){
+        GolfEngine::DifficultyEstimator estimator(&makeLevel);
+        if(argc == 3){
+            estimator.setShotsPerTee(std::stoul(argv[2]));
+        }
+        std::vector<GolfEngine::Vector2> tees;
+        double x, y;
+        while(std::cin >> x >> y){
+            tees.push_back(GolfEngine::Vector2(x, y));
+        }
+        GolfEngine::DifficultyReport report = estimator.estimate(tees);
+        for(const GolfEngine::TeeDifficulty& tee : report.tees){
+            std::cout << tee.position.x << " " << tee.position.y << " " << tee.holed << " " << tee.settled << " " << tee.success_rate << std::endl;
+        }
+        std::cout << report.mean_success_rate;
+        for(unsigned long bucket : report.success_histogram){
+            std::cout << " " << bucket;
+        }
+        std::cout << std::endl;
+        const GolfEngine::HeatMap& map = report.rest_map;
+        std::cout << map.columns << " " << map.rows << std::endl;
+        for(unsigned int row = 0; row < map.rows; row++){
+            for(unsigned int column = 0; column < map.columns; column++){
+                std::cout << (column == 0 ? "" : " ") << map.at(column, row);
+            }
+            std::cout << std::endl;
+        }
+        return 0;
+    }
+
+    GolfEngine::Simulation simulation;
+    GolfEngine::LevelA level;
+    simulation.loadLevel(&level);
+
+    double force_x, force_y;
+    while(std::cin >> force_x >> force_y){
+        GolfEngine::ShotResult result = simulation.simulateShot(GolfEngine::Vector2(force_x, force_y));
+        std::cout << result.frames << " " << result.reached_goal;
+        for(GolfEngine::Entity* golfball : level.findEntitiesWithTag(GolfEngine::Tags::GOLFBALL)){
+            std::cout << " " << golfball->getPosition().x << " " << golfball->getPosition().y;
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,15 @@
+/**
+ * @file test.cpp
+ * @brief This file is responsible for running the tests.
+ *
+ * @author Willow Ciesialka
+ * @date 2023-06-25
+*/
+
+#include "Tests.hpp"
+
+int main(){
+    runTests();
+
+    return 0;
+}